@@ -125,6 +125,14 @@ SOURCE=..\LASzip\src\lasindex.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\src\laspipeline.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\src\laspointbatch.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\LASzip\src\lasinterval.cpp
 # End Source File
 # Begin Source File
@@ -361,6 +369,14 @@ SOURCE=..\LASzip\src\lasindex.hpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\inc\laspipeline.hpp
+# End Source File
+# Begin Source File
+
+SOURCE=.\inc\laspointbatch.hpp
+# End Source File
+# Begin Source File
+
 SOURCE=..\LASzip\src\lasinterval.hpp
 # End Source File
 # Begin Source File
@@ -0,0 +1,271 @@
+/*
+===============================================================================
+
+  FILE:  lasexample_geoprojection.cpp
+
+  CONTENTS:
+
+    This source code serves as an example how the GeoProjectionConverter
+    reprojects points one at a time or in batches and checks that both ways
+    give the same results. Points are converted between long/lat, UTM, TM,
+    LCC and ECEF with the per-point to_target() and with the batch version
+    that runs blocks of points through the array conversions. This includes
+    ECEF targets whose elevation is both input and output and polar points
+    that the LCC projection can not project and that keep their coordinates.
+    Besides the largest difference it counts the points whose coordinates
+    differ once quantized to the precision of a typical LAS file, so even one
+    coordinate that would be stored differently is reported as a failure.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created to compare per-point and batch reprojection
+    16 October 2026 -- also fail on any difference after quantization
+
+===============================================================================
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "geoprojectionconverter.hpp"
+
+#define PROJECTION_LONG_LAT 0
+#define PROJECTION_UTM      1
+#define PROJECTION_TM       2
+#define PROJECTION_LCC      3
+#define PROJECTION_ECEF     4
+#define PROJECTION_COUNT    5
+
+static const char* projection_names[PROJECTION_COUNT] = { "long/lat", "UTM", "TM", "LCC", "ECEF" };
+
+void usage(bool wait=false)
+{
+  fprintf(stderr,"usage:\n");
+  fprintf(stderr,"lasexample_geoprojection\n");
+  fprintf(stderr,"lasexample_geoprojection -n 100000 -verbose\n");
+  fprintf(stderr,"lasexample_geoprojection -h\n");
+  if (wait)
+  {
+    fprintf(stderr,"<press ENTER>\n");
+    getc(stdin);
+  }
+  exit(1);
+}
+
+static void byebye(bool error=false, bool wait=false)
+{
+  if (wait)
+  {
+    fprintf(stderr,"<press ENTER>\n");
+    getc(stdin);
+  }
+  exit(error);
+}
+
+static void set_projection(GeoProjectionConverter& converter, int projection, bool source)
+{
+  switch (projection)
+  {
+  case PROJECTION_LONG_LAT:
+    converter.set_longlat_projection(0, source);
+    break;
+  case PROJECTION_UTM:
+    converter.set_utm_projection(32, true, 0, source);
+    break;
+  case PROJECTION_TM:
+    converter.set_transverse_mercator_projection(500000.0, 0.0, 0.0, 9.0, 0.9996, 0, source);
+    break;
+  case PROJECTION_LCC:
+    converter.set_lambert_conformal_conic_projection(700000.0, 6600000.0, 46.5, 3.0, 49.0, 44.0, 0, source);
+    break;
+  case PROJECTION_ECEF:
+    converter.set_ecef_projection(0, source);
+    break;
+  }
+}
+
+static void setup(GeoProjectionConverter& converter, int source, int target)
+{
+  converter.set_reference_ellipsoid(GEO_ELLIPSOID_WGS84);
+  set_projection(converter, source, true);
+  set_projection(converter, target, false);
+}
+
+// the precision at which coordinates are quantized like they are stored in a LAS file
+
+static double get_precision(int projection, int axis)
+{
+  if (axis == 2) return 0.001;
+  return (projection == PROJECTION_LONG_LAT ? 1e-9 : 0.0001);
+}
+
+static long long quantize(double value, double precision)
+{
+  return (long long)floor(value / precision + 0.5);
+}
+
+// compares the batch to_target() with the per-point to_target() for 'n' points in the source projection
+
+static bool compare(int source, int target, const double* points, int n, bool verbose)
+{
+  GeoProjectionConverter converter;
+  setup(converter, source, target);
+
+  double* single = new double[3 * n];
+  double* batch = new double[3 * n];
+  memcpy(single, points, 3 * n * sizeof(double));
+  memcpy(batch, points, 3 * n * sizeof(double));
+
+  int i;
+  for (i = 0; i < n; i++)
+  {
+    converter.to_target(single + 3 * i);
+  }
+  converter.to_target(batch, (size_t)n);
+
+  double max_diff[3] = { 0.0, 0.0, 0.0 };
+  int quantized_diff = 0;
+  int unprojected = 0;
+  for (i = 0; i < 3 * n; i++)
+  {
+    double diff = fabs(single[i] - batch[i]);
+    if (!(diff <= max_diff[i % 3])) max_diff[i % 3] = diff; // also catches NaN
+    double precision = get_precision(target, i % 3);
+    if ((diff != 0.0) && (quantize(single[i], precision) != quantize(batch[i], precision))) quantized_diff++;
+  }
+  if (target == PROJECTION_LCC)
+  {
+    for (i = 0; i < n; i++)
+    {
+      if ((batch[3 * i] == points[3 * i]) && (batch[3 * i + 1] == points[3 * i + 1])) unprojected++;
+    }
+  }
+
+  // long/lat coordinates are in degrees and all others in meters
+  double tolerance = (target == PROJECTION_LONG_LAT ? 1e-10 : 1e-6);
+  bool ok = (max_diff[0] <= tolerance) && (max_diff[1] <= tolerance) && (max_diff[2] <= 1e-6) && (quantized_diff == 0);
+
+  if (verbose || !ok)
+  {
+    fprintf(stderr, "%-8s -> %-8s max difference x %g y %g z %g", projection_names[source], projection_names[target], max_diff[0], max_diff[1], max_diff[2]);
+    if (quantized_diff) fprintf(stderr, " (%d coordinates quantized differently)", quantized_diff);
+    if (target == PROJECTION_LCC) fprintf(stderr, " (%d points not projected)", unprojected);
+    fprintf(stderr, "%s\n", (ok ? "" : " FAILED"));
+  }
+
+  delete [] single;
+  delete [] batch;
+  return ok;
+}
+
+int main(int argc, char *argv[])
+{
+  int i;
+  bool verbose = false;
+  int n = 1000;
+
+  for (i = 1; i < argc; i++)
+  {
+    if (argv[i][0] == '\0')
+    {
+      continue;
+    }
+    else if (strcmp(argv[i],"-h") == 0 || strcmp(argv[i],"-help") == 0)
+    {
+      usage();
+    }
+    else if (strcmp(argv[i],"-v") == 0 || strcmp(argv[i],"-verbose") == 0)
+    {
+      verbose = true;
+    }
+    else if (strcmp(argv[i],"-n") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        fprintf(stderr,"ERROR: '%s' needs 1 argument: number\n", argv[i]);
+        usage();
+      }
+      if ((sscanf(argv[i+1], "%d", &n) != 1) || (n < 2))
+      {
+        fprintf(stderr,"ERROR: '%s' needs a number of at least 2 but '%s' is not\n", argv[i], argv[i+1]);
+        usage();
+      }
+      i++;
+    }
+    else
+    {
+      fprintf(stderr, "ERROR: cannot understand argument '%s'\n", argv[i]);
+      usage();
+    }
+  }
+
+  // a grid of long/lat points around the meridian 9 with elevations. the last
+  // points are on the south pole where the LCC projection can not project them.
+  // their number is not a multiple of the block size of the batch to_target().
+
+  double* longlat = new double[3 * n];
+  int poles = (n < 10 ? 1 : n / 10);
+  for (i = 0; i < n; i++)
+  {
+    longlat[3 * i] = 6.0 + 6.0 * (i % 97) / 96.0;
+    longlat[3 * i + 1] = (i < n - poles ? 45.0 + 10.0 * i / n : -90.0);
+    longlat[3 * i + 2] = -50.0 + 0.731 * (i % 4099);
+  }
+
+  double* points = new double[3 * n];
+  bool ok = true;
+  int source, target;
+  for (source = 0; source < PROJECTION_COUNT; source++)
+  {
+    // the points in the source projection come from the per-point conversion.
+    // only long/lat sources keep the polar points.
+
+    memcpy(points, longlat, 3 * n * sizeof(double));
+    int m = (source == PROJECTION_LONG_LAT ? n : n - poles);
+    if (source != PROJECTION_LONG_LAT)
+    {
+      GeoProjectionConverter converter;
+      setup(converter, PROJECTION_LONG_LAT, source);
+      for (i = 0; i < m; i++)
+      {
+        converter.to_target(points + 3 * i);
+      }
+    }
+    for (target = 0; target < PROJECTION_COUNT; target++)
+    {
+      if (!compare(source, target, points, m, verbose)) ok = false;
+    }
+  }
+
+  delete [] points;
+  delete [] longlat;
+
+  if (ok)
+  {
+    fprintf(stderr, "per-point and batch reprojection agree for %d points\n", n);
+  }
+  else
+  {
+    fprintf(stderr, "ERROR: per-point and batch reprojection differ\n");
+  }
+  byebye(!ok);
+
+  return 0;
+}
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- filtering entire batches of points with one kernel per criterion
      9 June 2021 -- disallow use of '-keep_class' together with '-keep_extended_class'
      3 April 2021 -- new filter '-keep_profile p1_x p1_y p2_x p2_y width' 
      6 March 2018 -- changed '%g' to '%lf' for all sprintf() of F64 values
@@ -37,6 +38,7 @@
 #define LAS_FILTER_HPP
 
 #include "lasdefinitions.hpp"
+#include "laspointbatch.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
 class LAScriterion
@@ -46,6 +48,10 @@ public:
   virtual I32 get_command(CHAR* string) const = 0;
   virtual U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY; };
   virtual BOOL filter(const LASpoint* point) = 0;
+  // optional: clears 'keep' for the points [start, start+number) of the batch that are filtered and returns how many.
+  // the kernels are plain loops over the batch columns that are left to the auto-vectorizer of the compiler
+  virtual BOOL has_batch() const { return FALSE; };
+  virtual U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep) { return 0; };
   virtual void reset(){};
   virtual ~LAScriterion(){};
 };
@@ -69,6 +75,11 @@ public:
   BOOL filter(const LASpoint* point);
   void reset();
 
+  // removes the filtered points from index 'start' onwards from the batch and returns the new count. criteria
+  // without batch kernel are evaluated per point after restoring it into 'point' (needs the point records)
+  BOOL can_filter(const LASpointBatch* batch) const;
+  U32 filter(LASpointBatch* batch, const U32 start, LASpoint* point);
+
   LASfilter();
   ~LASfilter();
 
@@ -79,6 +90,8 @@ private:
   U32 alloc_criteria;
   LAScriterion** criteria;
   I32* counters;
+  U8* keep;
+  U32 alloc_keep;
 };
 
 #endif
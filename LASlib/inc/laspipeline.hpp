@@ -0,0 +1,64 @@
+/*
+===============================================================================
+
+  FILE:  laspipeline.hpp
+
+  CONTENTS:
+
+    Copies the points from a LASreader to a LASwriter in three stages that run
+    at the same time: one thread reads (and decompresses) the points into
+    batches, the calling thread filters and transforms them, and one more
+    thread writes (and compresses) them. The stages hand a fixed ring of point
+    batches to each other through bounded lock-free single-producer single-
+    consumer queues. The points are written in the same order as by a plain
+    read_point() / write_point() loop.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- halt on read or write errors only after all stages have stopped
+    16 October 2026 -- created for pipelining reading, processing and writing with '-pipeline'
+
+===============================================================================
+*/
+#ifndef LAS_PIPELINE_HPP
+#define LAS_PIPELINE_HPP
+
+#include "lasreader.hpp"
+#include "laswriter.hpp"
+
+#define LAS_PIPELINE_DEFAULT_BATCHES 8
+#define LAS_PIPELINE_DEFAULT_BATCH_SIZE 16384
+
+class LASLIB_DLL LASpipeline
+{
+public:
+  // copies the surviving points among the first 'stop' points read from the reader to the writer. when
+  // a 'target' point is given each point is first copied into it (e.g. to change the point type). with
+  // 'update_inventory' the writer keeps the inventory of the written points. returns the number of
+  // written points. an error while reading or writing ends the process (unless errors are ignored)
+  // only after the points read before it have been written
+  I64 run(LASreader* lasreader, LASwriter* laswriter, const BOOL update_inventory=TRUE, const I64 stop=I64_MAX, LASpoint* target=0);
+
+  LASpipeline(const U32 num_batches=LAS_PIPELINE_DEFAULT_BATCHES, const U32 batch_size=LAS_PIPELINE_DEFAULT_BATCH_SIZE);
+
+private:
+  U32 num_batches;
+  U32 batch_size;
+};
+
+#endif
@@ -0,0 +1,145 @@
+/*
+===============================================================================
+
+  FILE:  laspointbatch.hpp
+
+  CONTENTS:
+
+    A batch of LiDAR points stored as a structure of arrays. Instead of one
+    call per point, a LASreader can fill up to 65536 points into such a batch
+    with one call to read_points(). The most commonly used attributes are kept
+    in separate arrays so that consumers can run tight loops over them. If
+    requested, the complete point records are kept as well so that each point
+    can be restored into a LASpoint (e.g. for writing it).
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- update_records() writes transformed attributes back into the records
+    16 October 2026 -- set_point() replaces a point of the batch for pipelined processing
+    16 October 2026 -- compact() removes the points that were filtered from a batch
+    16 October 2026 -- records keep the legacy fields of LAS 1.4 points (LASpoint::copy_to() drops them)
+    16 October 2026 -- created for reading points in batches of 64K points
+
+===============================================================================
+*/
+#ifndef LAS_POINT_BATCH_HPP
+#define LAS_POINT_BATCH_HPP
+
+#include "lasdefinitions.hpp"
+
+#define LAS_POINT_BATCH_DEFAULT_SIZE 65536
+
+class LASLIB_DLL LASpointBatch
+{
+public:
+  U32 count;
+
+  // the quantizer of the points, whether they have GPS time stamps and are of the new LAS 1.4 types
+  const LASquantizer* quantizer;
+  BOOL have_gps_time;
+  BOOL extended_point_type;
+
+  // the attributes of the points in the batch
+  I32* X;
+  I32* Y;
+  I32* Z;
+  U16* intensity;
+  U8* return_number;       // extended return number for point types 6 and higher
+  U8* number_of_returns;   // extended number of returns for point types 6 and higher
+  U8* classification;      // extended classification for point types 6 and higher
+  U8* flags;               // bit 0 synthetic, bit 1 keypoint, bit 2 withheld, bit 3 overlap
+  F32* scan_angle;         // in degrees
+  U8* user_data;
+  U16* point_source_ID;
+  F64* gps_time;
+
+  // optional complete point records of 'record_size' bytes. unlike LASpoint::copy_to() they also keep
+  // the legacy copies of the fields of the new LAS 1.4 point types so that get_point() is lossless
+  U8* records;
+
+  // allocates the arrays for 'capacity' points (and the records when requested)
+  BOOL init(const LASpoint* point, const U32 capacity=LAS_POINT_BATCH_DEFAULT_SIZE, const BOOL with_records=FALSE);
+  BOOL reserve(const U32 capacity);
+
+  inline U32 get_capacity() const { return capacity; };
+  inline U32 get_record_size() const { return record_size; };
+  inline BOOL has_records() const { return (records != 0); };
+  inline BOOL is_full() const { return (count == capacity); };
+
+  inline void clear() { count = 0; };
+
+  inline void add(const LASpoint* point)
+  {
+    store(count, point);
+    count++;
+  };
+
+  // replaces the i-th point (e.g. after it was modified)
+  inline void set_point(const U32 i, const LASpoint* point)
+  {
+    if (i < count) store(i, point);
+  };
+
+  // writes the coordinates, classification, user data and point source ID of the points from index 'start'
+  // onwards back into their records after batch kernels changed them (does nothing without records)
+  void update_records(const U32 start);
+
+  // removes the points from index 'start' onwards whose 'keep' flag is zero
+  void compact(const U32 start, const U8* keep);
+
+  // restores the complete i-th point (only possible when the records are kept)
+  BOOL get_point(const U32 i, LASpoint* point) const;
+
+  LASpointBatch();
+  ~LASpointBatch();
+
+private:
+  U32 capacity;
+  U32 record_size;
+  U32 core_size;
+  BOOL with_records;
+  void clean();
+  inline void store(const U32 i, const LASpoint* point)
+  {
+    X[i] = point->get_X();
+    Y[i] = point->get_Y();
+    Z[i] = point->get_Z();
+    intensity[i] = point->get_intensity();
+    return_number[i] = point->get_return_number_uni();
+    number_of_returns[i] = point->get_number_of_returns_uni();
+    classification[i] = point->get_classification_uni();
+    flags[i] = point->get_synthetic_flag() | (point->get_keypoint_flag() << 1) | (point->get_withheld_flag() << 2) | (point->get_extended_overlap_flag() << 3);
+    scan_angle[i] = point->get_scan_angle();
+    user_data[i] = point->get_user_data();
+    point_source_ID[i] = point->get_point_source_ID();
+    gps_time[i] = point->get_gps_time();
+    if (records) store_record(point, records + (size_t)i * record_size);
+  };
+  inline void store_record(const LASpoint* point, U8* record) const
+  {
+    memcpy(record, &point->X, core_size);
+    U32 i, b = core_size;
+    for (i = 1; i < point->num_items; i++)
+    {
+      memcpy(record + b, point->point[i], point->items[i].size);
+      b += point->items[i].size;
+    }
+  };
+};
+
+#endif
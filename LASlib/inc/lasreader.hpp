@@ -25,6 +25,14 @@
 
 	CHANGE HISTORY:
 
+		16 October 2026 -- set_metadata_only() opens LAS/LAZ files only for their header, VLRs, EVLRs and chunk table
+		16 October 2026 -- read_point_unprocessed() leaves filter and transform to a pipeline stage
+		16 October 2026 -- new option '-parse_threads 4' to parse ASCII points in parallel
+		16 October 2026 -- read_points() also transforms entire batches with compiled operations
+		16 October 2026 -- read_points() filters entire batches when no transform is active
+		16 October 2026 -- read_points() fills a LASpointBatch with up to 64K points per call
+		16 October 2026 -- new option '-io_mmap' to read local LAS/LAZ files via memory mapping
+		16 October 2026 -- new option '-decompress_threads 4' to decompress LAZ chunks in parallel
 		18 April 2023 -- adding support of COPC spatial index standard
 		10 March 2022 -- added '-iptx_transform' option
 		31 October 2019 -- adding kdtree of bounding boxes for large number of LAS/LAZ files
@@ -56,6 +64,7 @@
 #include "lasdefinitions.hpp"
 #include "lasignore.hpp"
 #include "lastransform.hpp"
+#include "laspointbatch.hpp"
 #include "laswaveform13reader.hpp"
 
 class LASindex;
@@ -66,6 +75,31 @@ class ByteStreamIn;
 class LASkdtreeRectangles;
 class LASreadOpener;
 
+// what the chunk table of a chunked LAZ file tells about its chunks
+class LASLIB_DLL LASchunkStatistics
+{
+public:
+	U32 number_chunks;
+	BOOL variable_size;
+	I64 start_of_chunks;
+	I64 start_of_chunk_table;
+	I64 min_points;
+	I64 max_points;
+	I64 min_bytes;
+	I64 max_bytes;
+
+	void clean()
+	{
+		number_chunks = 0;
+		variable_size = FALSE;
+		start_of_chunks = 0;
+		start_of_chunk_table = 0;
+		min_points = max_points = 0;
+		min_bytes = max_bytes = 0;
+	};
+	LASchunkStatistics() { clean(); };
+};
+
 class LASLIB_DLL LASreader
 {
 public:
@@ -78,6 +112,8 @@ public:
 
 	virtual I32 get_format() const = 0;
 	virtual BOOL has_layers() const { return FALSE; };
+	// only known for chunked LAZ files that were opened to only look at their metadata
+	virtual const LASchunkStatistics* get_chunk_statistics() const { return 0; };
 
 	void set_index(LASindex* index);
 	inline LASindex* get_index() const { return index; };
@@ -111,6 +147,12 @@ public:
 
 	virtual BOOL seek(const I64 p_index) = 0;
 	BOOL read_point() { return (this->*read_simple)(); };
+	// reads up to 'max' points (after filtering and transformation) into the batch and returns their number
+	U32 read_points(LASpointBatch& batch, const U32 max=LAS_POINT_BATCH_DEFAULT_SIZE);
+	// when the filter and the transform are separable they are not applied by read_point_unprocessed() and
+	// the caller has to apply them (e.g. on another thread). otherwise it is the same as read_point()
+	inline BOOL has_separable_processing() const { return (read_complex != 0); };
+	BOOL read_point_unprocessed() { return (this->*(read_complex ? read_complex : read_simple))(); };
 
 	inline BOOL ignore_point() { return (ignore ? ignore->ignore(&point) : FALSE); };
 
@@ -196,6 +238,14 @@ public:
 	void z_from_attribute_bydefault();
 	void set_io_ibuffer_size(const U32 buffer_size);
 	inline U32 get_io_ibuffer_size() const { return io_ibuffer_size; };
+	void set_io_mmap(const BOOL io_mmap);
+	inline BOOL get_io_mmap() const { return io_mmap; };
+	void set_decompress_threads(const U32 decompress_threads);
+	inline U32 get_decompress_threads() const { return decompress_threads; };
+	void set_parse_threads(const U32 parse_threads);
+	inline U32 get_parse_threads() const { return parse_threads; };
+	void set_metadata_only(const BOOL metadata_only);
+	inline BOOL get_metadata_only() const { return metadata_only; };
 	U32 get_file_name_number() const;
 	U32 get_file_name_current() const;
 	const CHAR* get_file_name() const;
@@ -295,6 +345,7 @@ private:
 	BOOL add_file_name(const CHAR* file_name, U32 ID, BOOL unique);
 	BOOL add_file_name(const CHAR* file_name, U32 ID, I64 npoints, F64 min_x, F64 min_y, F64 max_x, F64 max_y, BOOL unique = FALSE);
 	U32 io_ibuffer_size;
+	BOOL io_mmap;
 	const CHAR* file_name;
 	BOOL merged;
 	BOOL stored;
@@ -364,6 +415,15 @@ private:
 	// optional selective decompression (compressed new LAS 1.4 point types only)
 	U32 decompress_selective;
 
+	// optional multi-threaded decompression (chunked LAZ only)
+	U32 decompress_threads;
+
+	// optional multi-threaded parsing (ASCII points only)
+	U32 parse_threads;
+
+	// optional opening of LAS/LAZ files without preparing to read their points
+	BOOL metadata_only;
+
 	// optional area-of-interest query (spatially indexed)
 	F32* inside_tile;
 	F64* inside_circle;
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- parsing each cell only once and keeping the parsed rasters in memory for reading
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
     06 December 2013 -- option to deal with European '-comma_not_dot' numbers
@@ -67,6 +68,8 @@ private:
   F64* offset;
   FILE* file;
   CHAR* line;
+  F64* elevations;
+  I64 number_elevations;
   I32 header_lines;
   I32 line_size;
   I32 line_curr;
@@ -80,6 +83,7 @@ private:
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
 
+  BOOL read_elevation(F64& elevation);
   void clean();
   void populate_scale_and_offset();
   void populate_bounding_box();
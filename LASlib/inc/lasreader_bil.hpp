@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- reading whole rows of cells with one fread() and summarizing them in one pass
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -77,6 +78,17 @@ private:
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
 
+  // the current row of cells as stored in the file and as elevations
+  U8* raw_row;
+  F32* row_elevations;
+  I32 row_cells;
+  I32 row_loaded;
+
+  // 8 bit cells keep all bands but larger cells only the first
+  inline I32 get_cell_size() const { return (nbits == 32 ? 4 : (nbits == 16 ? 2 : nbands)); };
+  BOOL alloc_rows();
+  I32 read_row();
+
   void clean();
   BOOL read_hdr_file(const CHAR* file_name);
   BOOL read_blw_file(const CHAR* file_name);
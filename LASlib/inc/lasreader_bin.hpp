@@ -26,6 +26,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- read *.bin.gz, *.bin.zip, and *.bin.zst via fopen_compressed()
     4 September 2011 -- created on Labor Day Sunday far from beloved mountains
   
 ===============================================================================
@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- reading whole columns of cells with one fread() and summarizing them in one pass
     31 August 2019 -- add RasterLAZ during code sprint after FOSS4G 2019 in Bucharest 
     10 May 2019 -- checking for overflows in X, Y, Z 32 bit integers of fixed-point LAS
     10 October 2013 -- created after returning from INTERGEO 2013 in Essen
@@ -74,6 +75,16 @@ private:
   F64 orig_x_offset, orig_y_offset, orig_z_offset;
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
 
+  // the current column of cells as stored in the file and as elevations
+  U8* raw_column;
+  F32* column_elevations;
+  I32 column_cells;
+  I32 column_loaded;
+
+  inline I32 get_cell_size() const { return (data_type == 3 ? 8 : (data_type == 0 ? 2 : 4)); };
+  BOOL alloc_columns();
+  I32 read_column();
+
   void clean();
   void populate_scale_and_offset();
   void populate_bounding_box();
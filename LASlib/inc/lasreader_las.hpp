@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- peek at all metadata (VLRs, EVLRs, chunk table) without preparing to read points
+    16 October 2026 -- optionally read local files via memory mapping ('-io_mmap')
     9 November 2022 -- support of COPC VLR and EVLR
     13 June 2022 -- support unicode filenames
     10 July 2018 -- user must set seek-ability of istream (hard to determine) 
@@ -63,6 +65,11 @@ public:
   void set_delete_stream(BOOL delete_stream=TRUE) { this->delete_stream = delete_stream; };
   void set_keep_copc(BOOL keep_copc) { this->keep_copc = keep_copc; };
 
+  // when opened with 'peek_only' this also reads the VLRs, the EVLRs and the chunk table but still
+  // does not prepare the reading (or decompressing) of points. no points can be read afterwards
+  void set_peek_metadata(BOOL peek_metadata) { this->peek_metadata = peek_metadata; };
+  const LASchunkStatistics* get_chunk_statistics() const { return (chunk_statistics.number_chunks ? &chunk_statistics : 0); };
+
   BOOL open(const char* file_name, I32 io_buffer_size=LAS_TOOLS_IO_IBUFFER_SIZE, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL open(FILE* file, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL);
   BOOL open(std::istream& stream, BOOL peek_only=FALSE, U32 decompress_selective=LASZIP_DECOMPRESS_SELECTIVE_ALL, BOOL seekable=TRUE);
@@ -89,6 +96,9 @@ private:
   LASreadPoint* reader;
   BOOL checked_end;
   BOOL keep_copc;
+  BOOL peek_metadata;
+  LASchunkStatistics chunk_statistics;
+  BOOL read_chunk_statistics();
 };
 
 class LASreaderLASrescale : public virtual LASreaderLAS
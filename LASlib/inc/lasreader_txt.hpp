@@ -24,6 +24,9 @@
 
   CHANGE HISTORY:
 
+   16 October 2026 -- header is populated in a single pass that spills the parsed points to memory or a temporary file
+   16 October 2026 -- lines are parsed in newline-aligned ranges by several threads with '-parse_threads'
+   16 October 2026 -- lines are split in place from large blocks and numbers parsed without sscanf()
    10 March 2022 -- added '-iptx_transform' option
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
    22 July 2018 -- bug fix for parsing classfication to point type 6 (or higher)
@@ -42,6 +45,10 @@
 
 #include <stdio.h>
 
+class LASreaderTXTrange;
+class LASreaderTXTranges;
+class LASreaderTXTspill;
+
 class LASreaderTXT : public LASreader
 {
 public:
@@ -89,8 +96,16 @@ private:
   BOOL iptx;
   FILE* file;
   bool piped;
-  const char* lptr;
-  CHAR line[512];
+  CHAR* line;
+  CHAR* line_end;
+  CHAR* block;
+  size_t block_size;
+  size_t block_fill;
+  size_t block_next;
+  I64 block_start;
+  BOOL block_eof;
+  LASreaderTXTranges* ranges;
+  LASreaderTXTspill* spill;
   I32 number_attributes;
   I32 attributes_data_types[32];
   const CHAR* attribute_names[32];
@@ -105,17 +120,32 @@ private:
   F64 orig_x_scale_factor, orig_y_scale_factor, orig_z_scale_factor;
   BOOL parse_extended_flags(CHAR* parse_string);
   BOOL parse_column_description(CHAR** parse_string);
-  BOOL parse_attribute(const CHAR* l, I32 index);
+  BOOL parse_attribute(const CHAR* l, I32 index, LASpoint* point) const;
   template<typename T>
-  BOOL parse_item_i(I32* out, const I32 imin, const I32 imax, const CHAR* context, T addon);
-  BOOL parse_item_i(I32* out, const I32 imin, const I32 imax, const CHAR* context);
+  BOOL parse_item_i(const CHAR*& lptr, I32* out, const I32 imin, const I32 imax, const CHAR* context, T addon) const;
+  BOOL parse_item_i(const CHAR*& lptr, I32* out, const I32 imin, const I32 imax, const CHAR* context) const;
   template<typename T>
-  BOOL parse_item_f(F32* out, const F32 imin, const F32 imax, const CHAR* context, T addon);
-  BOOL parse_item_f(F32* out, const F32 imin, const F32 imax, const CHAR* context);
-  BOOL parse(const CHAR* parse_string);
+  BOOL parse_item_f(const CHAR*& lptr, F32* out, const F32 imin, const F32 imax, const CHAR* context, T addon) const;
+  BOOL parse_item_f(const CHAR*& lptr, F32* out, const F32 imin, const F32 imax, const CHAR* context) const;
+  BOOL parse(const CHAR* parse_string) { return parse(parse_string, line, &point); };
+  BOOL parse(const CHAR* parse_string, const CHAR* line, LASpoint* point) const;
+  BOOL read_line();
+  void unread_line();
+  BOOL fill_block();
+  BOOL read_range(LASreaderTXTrange* range);
+  void parse_range(LASreaderTXTrange* range, const LASpoint* start) const;
+  BOOL read_range_point();
+  void start_ranges();
+  void stop_ranges();
+  BOOL read_parsed_point();
+  BOOL spill_points();
+  BOOL read_spilled_point();
+  void stop_spill();
+  void rewind_lines();
+  void reset_lines();
   BOOL check_parse_string(const CHAR* parse_string);
-  BOOL skip_pre();
-  void skip_post();
+  BOOL skip_pre(const CHAR*& lptr) const;
+  void skip_post(const CHAR*& lptr) const;
   void populate_scale_and_offset();
   void populate_bounding_box();
   void clean();
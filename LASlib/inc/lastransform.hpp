@@ -24,6 +24,7 @@
 
 	CHANGE HISTORY:
 
+		16 October 2026 -- compiled operations: '-fuse_xyz_operations', lookup tables and point batches
 		10 March 2022 -- added TransformMatrix operation
 		18 November 2021 -- new '-forceRGB' to use RGB values also in non-RGB point versions
 		15 June 2021 -- new '-clamp_RGB_to_8bit' transform useful to avoid 8 bit overflow
@@ -45,8 +46,14 @@
 
 #include "lasdefinitions.hpp"
 #include "laszip_decompress_selective_v3.hpp"
+#include "laspointbatch.hpp"
 #include <cmath>
 
+#define LASOPERATION_LUT_NONE           0
+#define LASOPERATION_LUT_USER_DATA      1 //   256 entries
+#define LASOPERATION_LUT_CLASSIFICATION 2 //  8192 entries of (classification << 8) | extended_classification
+#define LASOPERATION_LUT_POINT_SOURCE   3 // 65536 entries
+
 class LASfilter;
 class LASreader;
 
@@ -78,6 +85,19 @@ public:
 	virtual void transform(LASpoint* point) = 0;
 	virtual void reset() { overflow = 0; };
 	inline void set_offset_adjust(BOOL offset_adjust) { this->offset_adjust = offset_adjust; };
+	inline BOOL get_offset_adjust() const { return offset_adjust; };
+	inline void add_overflow(const I64 count) { overflow += count; };
+	// optional for LAStransform::compile(): the operation as an affine map of the coordinates with
+	// x' = m[0]*x + m[1]*y + m[2]*z + m[3], y' = m[4]*x + ... + m[7] and z' = m[8]*x + ... + m[11]
+	virtual BOOL get_affine(F64* m) const { return FALSE; };
+	// optional for LAStransform::compile(): the operation as a lookup table for one attribute where
+	// map_lut() replaces each entry of the table with the value the operation makes of it
+	virtual U32 get_lut() const { return LASOPERATION_LUT_NONE; };
+	virtual void map_lut(U16* lut, const U32 size) const {};
+	// optional: the operation for the points from index 'start' onwards of a batch. it only changes the
+	// attribute arrays, LAStransform writes them back into the records of the batch
+	virtual BOOL has_batch() const { return FALSE; };
+	virtual void transform_batch(LASpointBatch* batch, const U32 start) {};
   void set_origins(F64 orig_x_offset, F64 orig_y_offset, F64 orig_z_offset, F64 orig_x_scale_factor, F64 orig_y_scale_factor, F64 orig_z_scale_factor);
   void set_scale_factor(F64 scale_factor_x, F64 scale_factor_y, F64 scale_factor_z);
   void set_adjusted_offset(F64 adjusted_offset_x, F64 adjusted_offset_y, F64 adjusted_offset_z);
@@ -168,6 +188,12 @@ public:
       }
     }
 	};
+	inline BOOL get_affine(F64* m) const {
+		m[0] = r11; m[1] = r12; m[2] = r13; m[3] = tr1;
+		m[4] = r21; m[5] = r22; m[6] = r23; m[7] = tr2;
+		m[8] = r31; m[9] = r32; m[10] = r33; m[11] = tr3;
+		return TRUE;
+	};
 	LASoperationTransformMatrix(F64 r11, F64 r12, F64 r13, F64 r21, F64 r22, F64 r23, F64 r31, F64 r32, F64 r33, F64 tr1, F64 tr2, F64 tr3)
 	{
 		this->r11 = r11; this->r12 = r12; this->r13 = r13;
@@ -260,6 +286,11 @@ public:
 
 	void transform(LASpoint* point);
 
+	// the compiled operations for entire batches of points (only without filter). the records of a batch
+	// that keeps them are updated afterwards
+	BOOL can_transform(const LASpointBatch* batch);
+	void transform(LASpointBatch* batch, const U32 start);
+
 	void check_for_overflow() const;
 
 	void reset();
@@ -289,6 +320,18 @@ private:
 	U32 num_operations;
 	U32 alloc_operations;
 	LASoperation** operations;
+
+	// the operations compiled into stages: consecutive coordinate operations fused into one affine map
+	// (only with '-fuse_xyz_operations' as it skips the rounding between them) and consecutive attribute
+	// mappings folded into one lookup table. the stages that are not original operations are owned here
+	void compile();
+	void clean_stages();
+	BOOL fuse_operations;
+	BOOL compiled;
+	U32 num_stages;
+	LASoperation** stages;
+	U32 num_owned_stages;
+	LASoperation** owned_stages;
 	BOOL is_filtered;
 	LASfilter* filter;
 };
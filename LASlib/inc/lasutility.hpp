@@ -24,6 +24,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- merge() combines accumulators that were filled in parallel
     27 August 2017 -- added '-histo scanner_channel 1'
      1 June 2017 -- improved "fluff" detection
      3 May 2015 -- updated LASinventory to handle LAS 1.4 content 
@@ -51,6 +52,8 @@ public:
   BOOL init(const LASheader* header);
   BOOL add(const LASpoint* point);
   BOOL update_header(LASheader* header) const;
+  // adds the points of another inventory (e.g. one filled by another thread)
+  BOOL merge(const LASinventory* inventory);
   LASinventory();
 private:
   BOOL first;
@@ -84,6 +87,12 @@ public:
   I64 xyz_fluff_1000[3];
   I64 xyz_fluff_10000[3];
   BOOL add(const LASpoint* point);
+  // adds the points of another summary that followed those of this one (e.g. the next range of points
+  // of the same file summarized by another thread). the 'attributer' is needed for the extra bytes
+  BOOL merge(const LASsummary* summary, const LASattributer* attributer=0);
+  // counts the fluff against the low digits of 'point' instead of those of the first point added. summaries
+  // of consecutive ranges that all use the first point of the first range merge into the counts of one pass
+  void set_fluff_reference(const LASpoint* point);
   BOOL has_fluff() const { return has_fluff(0) || has_fluff(1) || has_fluff(2); };
   BOOL has_fluff(U32 i) const { return (number_of_point_records && ((min.get_XYZ())[i] != (max.get_XYZ())[i]) && (number_of_point_records == xyz_fluff_10[i])); };
   BOOL has_serious_fluff() const { return has_serious_fluff(0) || has_serious_fluff(1) || has_serious_fluff(2); };
@@ -95,6 +104,8 @@ public:
   LASsummary();
 private:
   BOOL first;
+  BOOL fluff_reference;
+  void set_low_digits(const LASpoint* point);
 };
 
 class LASLIB_DLL LASbin
@@ -107,12 +118,18 @@ public:
   void add(F64 item, F64 value);
   void report(FILE* file, const CHAR* name=0, const CHAR* name_avg=0) const;
   void reset();
+  void merge(const LASbin* bin);
   F64 get_step() const;
+  F64 get_clamp_min() const { return clamp_min; };
+  F64 get_clamp_max() const { return clamp_max; };
   LASbin(F64 step, F64 clamp_min=F64_MIN, F64 clamp_max=F64_MAX);
   ~LASbin();
 private:
   void add_to_bin(I32 bin);
+  void add_to_bin(I32 bin, U32 number, const F64* value);
+  void add_to_total(F64 item);
   F64 total;
+  F64 total_error;
   I64 count;
   F64 step;
   F64 clamp_min;
@@ -136,7 +153,11 @@ public:
   I32 unparse(CHAR* string) const;
   BOOL histo(const CHAR* name, F64 step);
   BOOL histo_avg(const CHAR* name, F64 step, const CHAR* name_avg);
+  // sets up the same (empty) bins as another histogram
+  BOOL setup(const LAShistogram* histogram);
   void add(const LASpoint* point);
+  // adds the bins of a histogram that was set up the same way
+  void merge(const LAShistogram* histogram);
   void report(FILE* file) const;
   void reset();
   LAShistogram();
@@ -198,6 +219,8 @@ public:
   BOOL active() const;
   U32 get_num_occupied() const { return num_occupied; };
   BOOL write_asc_grid(const CHAR* file_name) const;
+  // marks the cells occupied in another grid with the same spacing
+  BOOL merge(const LASoccupancyGrid* grid);
 
   // read from file or write to file
 //  BOOL read(ByteStreamIn* stream);
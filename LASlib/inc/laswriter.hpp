@@ -25,6 +25,9 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- get_chunk_size() lets tools temporarily switch to variable chunks
+    16 October 2026 -- sync() and get_chunk_bytes() locate chunks that were compressed by other threads
+    16 October 2026 -- compress LAZ chunks with several threads via '-compress_threads 4'
     14 June 2023 -- add tell() to the writers to be able to write copc files
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     17 August 2017 -- switch on "native LAS 1.4 extension". turns off with '-no_native'.
@@ -65,6 +68,10 @@ public:
   virtual I64 close(BOOL update_npoints=TRUE) = 0;
   virtual I64 tell() { return 0; };
 
+  // waits until all chunks ended with chunk() are in the file and reports their sizes in bytes
+  virtual BOOL sync() { return TRUE; };
+  virtual BOOL get_chunk_bytes(const U32 index, U32& bytes) const { return FALSE; };
+
   void dealloc();
 
   LASwriter() { npoints = 0; p_count = 0; };
@@ -87,6 +94,9 @@ public:
   BOOL set_format(const CHAR* format);
   void set_force(BOOL force);
   void set_chunk_size(U32 chunk_size);
+  inline U32 get_chunk_size() const { return chunk_size; };
+  void set_compress_threads(U32 compress_threads);
+  inline U32 get_compress_threads() const { return compress_threads; };
   void make_numbered_file_name(const CHAR* file_name, I32 digits);
   void make_file_name(const CHAR* file_name, I32 file_number=-1);
   const CHAR* get_directory() const;
@@ -131,6 +141,7 @@ private:
   BOOL force;
   BOOL native;
   U32 chunk_size;
+  U32 compress_threads;
   BOOL use_stdout;
   BOOL use_nil;
 };
@@ -23,6 +23,8 @@
     implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
 
   CHANGE HISTORY:
+    16 October 2026 -- sync() and get_chunk_bytes() for variable chunks compressed by several threads
+    16 October 2026 -- optional multi-threaded compression of LAZ chunks
     04 August 2023 -- set default of VLR header "reserved" to 0 instead of 0xAABB
     29 March 2017 -- read and write support "native LAS 1.4 extension" for LASzip
     23 October 2016 -- support writing Extended Variable Length Records (ELVRs)
@@ -68,6 +70,9 @@ public:
   BOOL open(std::ostream& ostream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
   BOOL open(ByteStreamOut* stream, const LASheader* header, U32 compressor=LASZIP_COMPRESSOR_NONE, I32 requested_version=0, I32 chunk_size=50000);
 
+  // call after open() to compress the chunks of LAZ output with several threads
+  BOOL set_compress_threads(const U32 num_threads);
+
   BOOL write_point(const LASpoint* point);
   BOOL chunk();
 
@@ -75,6 +80,9 @@ public:
   I64 close(BOOL update_npoints=TRUE);
   I64 tell();
 
+  BOOL sync();
+  BOOL get_chunk_bytes(const U32 index, U32& bytes) const;
+
   LASwriterLAS();
   ~LASwriterLAS();
 
@@ -24,6 +24,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- lines are formatted without printf() into a buffer that is written with one fwrite()
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     10 April 2011 -- created after a sunny weekend of biking to/from Buergel
 
@@ -67,10 +68,13 @@ private:
   BOOL optx;
   F32 scale_rgb;
   CHAR separator_sign;
-  CHAR printstring[512] = {0};
+  CHAR* buffer;
+  size_t buffer_size;
+  size_t line_size;
   I32 attribute_starts[10] = {0};
   BOOL check_parse_string(const CHAR* parse_string);
-  BOOL unparse_attribute(const LASpoint* point, I32 index);
+  CHAR* unparse_attribute(CHAR* out, const LASpoint* point, I32 index);
+  BOOL flush();
 };
 
 #endif
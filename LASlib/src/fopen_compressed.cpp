@@ -22,6 +22,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- in-process *.gz, *.zip (zlib) and *.zst (libzstd) on other systems
     27 December 2018 -- only act if the extension really is a file extension
     20 March 2011 -- added capability for *.zip, *.rar, and *.7z on Windows
     12 December 2003 -- adapted from Stefan Gumhold's SIGGRAPH submission hack
@@ -38,6 +39,13 @@
 #include <fcntl.h>
 #include <process.h>
 #include <windows.h>
+#else
+#ifdef LASLIB_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef LASLIB_HAVE_ZSTD
+#include <zstd.h>
+#endif
 #endif
 
 enum PIPES { READ_HANDLE, WRITE_HANDLE }; /* Constants 0 and 1 for READ and WRITE */
@@ -328,6 +336,383 @@ static FILE* fopenRARed(const char* filename, const char* mode)
 }
 #endif
 
+// open a gzipped/ZIPped/zstd-compressed file as a regular FILE* that is
+// decompressed in-process (via fopencookie() or funopen()) on other systems
+
+#if !defined(_WIN32) && (defined(LASLIB_HAVE_ZLIB) || defined(LASLIB_HAVE_ZSTD))
+
+#define LAS_DECOMPRESS_BUFFER_SIZE 262144
+
+class LASdecompressedFile
+{
+public:
+	LASdecompressedFile() { position = 0; };
+	virtual ~LASdecompressedFile() {};
+	// decompress up to 'size' bytes. returns 0 at the end and -1 on errors
+	virtual long read_some(char* buffer, size_t size) = 0;
+	// start decompressing again from the beginning
+	virtual bool restart() = 0;
+	long read(char* buffer, size_t size)
+	{
+		long bytes = read_some(buffer, size);
+		if (bytes > 0) position += bytes;
+		return bytes;
+	};
+	// seeking is emulated by decompressing (from the beginning when seeking backwards)
+	bool seek(long long offset, int whence)
+	{
+		long long target;
+		if (whence == SEEK_SET) target = offset;
+		else if (whence == SEEK_CUR) target = position + offset;
+		else target = -1;
+		if ((whence != SEEK_END) && (target < 0)) return false;
+		if ((target >= 0) && (target < position))
+		{
+			if (!restart()) return false;
+			position = 0;
+		}
+		char skip[4096];
+		while ((target < 0) || (position < target))
+		{
+			size_t size = sizeof(skip);
+			if ((target >= 0) && ((long long)size > (target - position))) size = (size_t)(target - position);
+			long bytes = read(skip, size);
+			if (bytes < 0) return false;
+			if (bytes == 0) break;
+		}
+		if (whence == SEEK_END)
+		{
+			if (offset > 0) return false;
+			return seek(position + offset, SEEK_SET);
+		}
+		return (position == target);
+	};
+	long long position;
+};
+
+#ifdef LASLIB_HAVE_ZLIB
+
+// gzip (also multiple members) via the gzFile interface of zlib
+
+class LASdecompressedGzip : public LASdecompressedFile
+{
+public:
+	LASdecompressedGzip(gzFile gz) { this->gz = gz; gzbuffer(gz, LAS_DECOMPRESS_BUFFER_SIZE); };
+	~LASdecompressedGzip() { gzclose(gz); };
+	long read_some(char* buffer, size_t size)
+	{
+		if (size > (size_t)I32_MAX) size = (size_t)I32_MAX;
+		int bytes = gzread(gz, buffer, (unsigned)size);
+		if (bytes < 0)
+		{
+			int error;
+			laserror("gzip decompression failed: %s", gzerror(gz, &error));
+		}
+		return bytes;
+	};
+	bool restart() { return (gzrewind(gz) == 0); };
+private:
+	gzFile gz;
+};
+
+// the first entry of a ZIP archive ('stored' or 'deflated')
+
+class LASdecompressedZip : public LASdecompressedFile
+{
+public:
+	LASdecompressedZip(FILE* file, long data_start, unsigned method, unsigned long long compressed_size)
+	{
+		this->file = file;
+		this->data_start = data_start;
+		this->method = method;
+		this->compressed_size = compressed_size;
+		buffer = new unsigned char[LAS_DECOMPRESS_BUFFER_SIZE];
+		memset(&stream, 0, sizeof(stream));
+		inflateInit2(&stream, -MAX_WBITS);
+		finished = false;
+		remaining = compressed_size;
+	};
+	~LASdecompressedZip()
+	{
+		inflateEnd(&stream);
+		delete [] buffer;
+		fclose(file);
+	};
+	long read_some(char* output, size_t size)
+	{
+		if (finished || (size == 0)) return 0;
+		if (size > (size_t)I32_MAX) size = (size_t)I32_MAX;
+		if (method == 0)
+		{
+			// stored without compression
+			if ((unsigned long long)size > remaining) size = (size_t)remaining;
+			size_t bytes = fread(output, 1, size, file);
+			remaining -= bytes;
+			if (remaining == 0) finished = true;
+			if ((bytes == 0) && (size != 0))
+			{
+				laserror("ZIP entry is truncated");
+				return -1;
+			}
+			return (long)bytes;
+		}
+		stream.next_out = (Bytef*)output;
+		stream.avail_out = (uInt)size;
+		while (stream.avail_out == size)
+		{
+			if (stream.avail_in == 0)
+			{
+				stream.next_in = buffer;
+				stream.avail_in = (uInt)fread(buffer, 1, LAS_DECOMPRESS_BUFFER_SIZE, file);
+				if (stream.avail_in == 0)
+				{
+					laserror("ZIP entry is truncated");
+					return -1;
+				}
+			}
+			int result = inflate(&stream, Z_NO_FLUSH);
+			if (result == Z_STREAM_END)
+			{
+				finished = true;
+				break;
+			}
+			if (result != Z_OK)
+			{
+				laserror("inflating ZIP entry failed: %s", (stream.msg ? stream.msg : "corrupt data"));
+				return -1;
+			}
+		}
+		return (long)(size - stream.avail_out);
+	};
+	bool restart()
+	{
+		if (fseek(file, data_start, SEEK_SET) != 0) return false;
+		stream.avail_in = 0;
+		finished = false;
+		remaining = compressed_size;
+		return (inflateReset(&stream) == Z_OK);
+	};
+private:
+	FILE* file;
+	long data_start;
+	unsigned method;
+	unsigned long long compressed_size;
+	unsigned long long remaining;
+	unsigned char* buffer;
+	z_stream stream;
+	bool finished;
+};
+
+#endif // LASLIB_HAVE_ZLIB
+
+#ifdef LASLIB_HAVE_ZSTD
+
+// zstd (also multiple frames) via the streaming interface of libzstd
+
+class LASdecompressedZstd : public LASdecompressedFile
+{
+public:
+	LASdecompressedZstd(FILE* file)
+	{
+		this->file = file;
+		stream = ZSTD_createDStream();
+		buffer = new unsigned char[LAS_DECOMPRESS_BUFFER_SIZE];
+		input.src = buffer;
+		input.size = 0;
+		input.pos = 0;
+		last_result = 0;
+	};
+	~LASdecompressedZstd()
+	{
+		ZSTD_freeDStream(stream);
+		delete [] buffer;
+		fclose(file);
+	};
+	long read_some(char* output_buffer, size_t size)
+	{
+		if (size > (size_t)I32_MAX) size = (size_t)I32_MAX;
+		ZSTD_outBuffer output = { output_buffer, size, 0 };
+		while (output.pos == 0)
+		{
+			if (input.pos == input.size)
+			{
+				input.size = fread(buffer, 1, LAS_DECOMPRESS_BUFFER_SIZE, file);
+				input.pos = 0;
+				if (input.size == 0)
+				{
+					// a complete frame ends with a zero hint
+					if (last_result != 0)
+					{
+						laserror("zstd compressed input is truncated");
+						return -1;
+					}
+					return 0;
+				}
+			}
+			last_result = ZSTD_decompressStream(stream, &output, &input);
+			if (ZSTD_isError(last_result))
+			{
+				laserror("zstd decompression failed: %s", ZSTD_getErrorName(last_result));
+				return -1;
+			}
+		}
+		return (long)output.pos;
+	};
+	bool restart()
+	{
+		if (fseek(file, 0, SEEK_SET) != 0) return false;
+		input.size = 0;
+		input.pos = 0;
+		last_result = 0;
+		return !ZSTD_isError(ZSTD_DCtx_reset(stream, ZSTD_reset_session_only));
+	};
+private:
+	FILE* file;
+	ZSTD_DStream* stream;
+	unsigned char* buffer;
+	ZSTD_inBuffer input;
+	size_t last_result;
+};
+
+#endif // LASLIB_HAVE_ZSTD
+
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__NetBSD__) || defined(__OpenBSD__)
+
+static int decompressed_read(void* cookie, char* buffer, int size)
+{
+	return (int)((LASdecompressedFile*)cookie)->read(buffer, (size_t)size);
+}
+
+static fpos_t decompressed_seek(void* cookie, fpos_t offset, int whence)
+{
+	LASdecompressedFile* decompressed = (LASdecompressedFile*)cookie;
+	if (!decompressed->seek((long long)offset, whence)) return -1;
+	return (fpos_t)decompressed->position;
+}
+
+static int decompressed_close(void* cookie)
+{
+	delete (LASdecompressedFile*)cookie;
+	return 0;
+}
+
+static FILE* fopenDecompressed(LASdecompressedFile* decompressed)
+{
+	FILE* file = funopen(decompressed, decompressed_read, NULL, decompressed_seek, decompressed_close);
+	if (file == NULL) delete decompressed;
+	return file;
+}
+
+#else
+
+static ssize_t decompressed_read(void* cookie, char* buffer, size_t size)
+{
+	return (ssize_t)((LASdecompressedFile*)cookie)->read(buffer, size);
+}
+
+static int decompressed_seek(void* cookie, off64_t* offset, int whence)
+{
+	LASdecompressedFile* decompressed = (LASdecompressedFile*)cookie;
+	if (!decompressed->seek((long long)*offset, whence)) return -1;
+	*offset = (off64_t)decompressed->position;
+	return 0;
+}
+
+static int decompressed_close(void* cookie)
+{
+	delete (LASdecompressedFile*)cookie;
+	return 0;
+}
+
+static FILE* fopenDecompressed(LASdecompressedFile* decompressed)
+{
+	cookie_io_functions_t functions;
+	functions.read = decompressed_read;
+	functions.write = NULL;
+	functions.seek = decompressed_seek;
+	functions.close = decompressed_close;
+	FILE* file = fopencookie(decompressed, "r", functions);
+	if (file == NULL) delete decompressed;
+	return file;
+}
+
+#endif
+
+#ifdef LASLIB_HAVE_ZLIB
+
+static FILE* fopenGzipped(const char* filename, const char* mode)
+{
+	if (mode[0] != 'r') return NULL;
+	gzFile gz = gzopen(filename, "rb");
+	if (gz == NULL) return NULL;
+	return fopenDecompressed(new LASdecompressedGzip(gz));
+}
+
+static unsigned read_zip_u16(const unsigned char* bytes)
+{
+	return (unsigned)bytes[0] | ((unsigned)bytes[1] << 8);
+}
+
+static unsigned long read_zip_u32(const unsigned char* bytes)
+{
+	return (unsigned long)read_zip_u16(bytes) | ((unsigned long)read_zip_u16(bytes + 2) << 16);
+}
+
+static FILE* fopenZIPped(const char* filename, const char* mode)
+{
+	if (mode[0] != 'r') return NULL;
+	FILE* file = LASfopen(filename, "rb");
+	if (file == NULL) return NULL;
+
+	// the local file header of the first entry
+
+	unsigned char header[30];
+	if ((fread(header, 1, 30, file) != 30) || (read_zip_u32(header) != 0x04034b50))
+	{
+		laserror("'%s' is not a ZIP archive", filename);
+		fclose(file);
+		return NULL;
+	}
+	unsigned flags = read_zip_u16(header + 6);
+	unsigned method = read_zip_u16(header + 8);
+	unsigned long long compressed_size = read_zip_u32(header + 18);
+	long data_start = 30 + (long)read_zip_u16(header + 26) + (long)read_zip_u16(header + 28);
+	if ((method != 0) && (method != 8))
+	{
+		laserror("compression method %u of ZIP archive '%s' not supported", method, filename);
+		fclose(file);
+		return NULL;
+	}
+	if ((method == 0) && ((flags & 8) || (compressed_size == 0xFFFFFFFF)))
+	{
+		laserror("size of stored entry in ZIP archive '%s' unknown", filename);
+		fclose(file);
+		return NULL;
+	}
+	if (fseek(file, data_start, SEEK_SET) != 0)
+	{
+		fclose(file);
+		return NULL;
+	}
+	return fopenDecompressed(new LASdecompressedZip(file, data_start, method, compressed_size));
+}
+
+#endif // LASLIB_HAVE_ZLIB
+
+#ifdef LASLIB_HAVE_ZSTD
+
+static FILE* fopenZstded(const char* filename, const char* mode)
+{
+	if (mode[0] != 'r') return NULL;
+	FILE* file = LASfopen(filename, "rb");
+	if (file == NULL) return NULL;
+	return fopenDecompressed(new LASdecompressedZstd(file));
+}
+
+#endif // LASLIB_HAVE_ZSTD
+
+#endif
+
 extern "C"
 {
 FILE* fopen_compressed(const char* filename, const char* mode, bool* piped)
@@ -341,6 +726,9 @@ FILE* fopen_compressed(const char* filename, const char* mode, bool* piped)
 #ifdef _WIN32
     file = fopenGzipped(filename, mode);
     if (piped) *piped = true;
+#elif defined(LASLIB_HAVE_ZLIB)
+    file = fopenGzipped(filename, mode);
+    if (piped) *piped = false;
 #else
     laserror("no support for gzipped input");
     return 0;
@@ -351,9 +739,22 @@ FILE* fopen_compressed(const char* filename, const char* mode, bool* piped)
 #ifdef _WIN32
     file = fopenZIPped(filename, mode);
     if (piped) *piped = true;
+#elif defined(LASLIB_HAVE_ZLIB)
+    file = fopenZIPped(filename, mode);
+    if (piped) *piped = false;
 #else
     laserror("no support for ZIPped input");
     return 0;
+#endif
+  }
+  else if (strcmp(filename+len-4, ".zst") == 0)
+  {
+#if !defined(_WIN32) && defined(LASLIB_HAVE_ZSTD)
+    file = fopenZstded(filename, mode);
+    if (piped) *piped = false;
+#else
+    laserror("no support for zstd compressed input");
+    return 0;
 #endif
   }
   else if (strcmp(filename+len-3, ".7z") == 0)
@@ -84,6 +84,29 @@ BOOL rangeValidate(const CHAR* argv, T* is1, T* is2, T min, T max)
   return TRUE;
 }
 
+// marks the points of a batch that a criterion filters and returns their number. the loop
+// has no branches and no dependencies across points. there are no SIMD intrinsics: it is
+// written so that the compiler can auto-vectorize it (e.g. with -O3)
+template <typename F>
+static inline U32 drop_batch(const U32 number, U8* keep, F drop)
+{
+  U32 i, dropped = 0;
+  for (i = 0; i < number; i++)
+  {
+    U8 d = keep[i] & (drop(i) ? 1 : 0);
+    keep[i] ^= d;
+    dropped += d;
+  }
+  return dropped;
+}
+
+// the same for criteria that only look at one attribute of the points
+template <typename T, typename F>
+static inline U32 drop_batch(const T* values, const U32 number, U8* keep, F drop)
+{
+  return drop_batch(number, keep, [&](const U32 i) { return drop(values[i]); });
+}
+
 class LAScriterionAnd : public LAScriterion
 {
 public:
@@ -116,6 +139,19 @@ public:
   inline const CHAR* name() const { return "keep_tile"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %g %g %g ", name(), ll_x, ll_y, tile_size); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_tile(ll_x, ll_y, ur_x, ur_y)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 x = q->get_x(X[i]);
+      F64 y = q->get_y(Y[i]);
+      return (x < ll_x) || (x >= ur_x) || (y < ll_y) || (y >= ur_y);
+    });
+  };
   LAScriterionKeepTile(F32 ll_x, F32 ll_y, F32 tile_size) { this->ll_x = ll_x; this->ll_y = ll_y; this->ur_x = ll_x + tile_size; this->ur_y = ll_y + tile_size; this->tile_size = tile_size; };
 private:
   F32 ll_x, ll_y, ur_x, ur_y, tile_size;
@@ -127,6 +163,19 @@ public:
   inline const CHAR* name() const { return "keep_circle"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf ", name(), center_x, center_y, radius); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_circle(center_x, center_y, radius_squared)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 dx = center_x - q->get_x(X[i]);
+      F64 dy = center_y - q->get_y(Y[i]);
+      return !((dx * dx + dy * dy) < radius_squared);
+    });
+  };
   LAScriterionKeepCircle(F64 x, F64 y, F64 radius) { this->center_x = x; this->center_y = y; this->radius = radius; this->radius_squared = radius * radius; };
 private:
   F64 center_x, center_y, radius, radius_squared;
@@ -139,6 +188,21 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf %lf %lf ", name(), min_x, min_y, min_z, max_x, max_y, max_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_box(min_x, min_y, min_z, max_x, max_y, max_z)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    const I32* Z = batch->Z + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 x = q->get_x(X[i]);
+      F64 y = q->get_y(Y[i]);
+      F64 z = q->get_z(Z[i]);
+      return (x < min_x) || (x >= max_x) || (y < min_y) || (y >= max_y) || (z < min_z) || (z >= max_z);
+    });
+  };
   LAScriterionKeepxyz(F64 min_x, F64 min_y, F64 min_z, F64 max_x, F64 max_y, F64 max_z) { this->min_x = min_x; this->min_y = min_y; this->min_z = min_z; this->max_x = max_x; this->max_y = max_y; this->max_z = max_z; };
 private:
   F64 min_x, min_y, min_z, max_x, max_y, max_z;
@@ -216,6 +280,21 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf %lf %lf ", name(), min_x, min_y, min_z, max_x, max_y, max_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_CHANNEL_RETURNS_XY | LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->inside_box(min_x, min_y, min_z, max_x, max_y, max_z)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    const I32* Z = batch->Z + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 x = q->get_x(X[i]);
+      F64 y = q->get_y(Y[i]);
+      F64 z = q->get_z(Z[i]);
+      return !((x < min_x) || (x >= max_x) || (y < min_y) || (y >= max_y) || (z < min_z) || (z >= max_z));
+    });
+  };
   LAScriterionDropxyz(F64 min_x, F64 min_y, F64 min_z, F64 max_x, F64 max_y, F64 max_z) { this->min_x = min_x; this->min_y = min_y; this->min_z = min_z; this->max_x = max_x; this->max_y = max_y; this->max_z = max_z; };
 private:
   F64 min_x, min_y, min_z, max_x, max_y, max_z;
@@ -227,6 +306,19 @@ public:
   inline const CHAR* name() const { return "keep_xy"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf ", name(), below_x, below_y, above_x, above_y); };
   inline BOOL filter(const LASpoint* point) { return (!point->inside_rectangle(below_x, below_y, above_x, above_y)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 x = q->get_x(X[i]);
+      F64 y = q->get_y(Y[i]);
+      return (x < below_x) || (x >= above_x) || (y < below_y) || (y >= above_y);
+    });
+  };
   LAScriterionKeepxy(F64 below_x, F64 below_y, F64 above_x, F64 above_y) { this->below_x = below_x; this->below_y = below_y; this->above_x = above_x; this->above_y = above_y; };
 private:
   F64 below_x, below_y, above_x, above_y;
@@ -238,6 +330,19 @@ public:
   inline const CHAR* name() const { return "drop_xy"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf %lf %lf ", name(), below_x, below_y, above_x, above_y); };
   inline BOOL filter(const LASpoint* point) { return (point->inside_rectangle(below_x, below_y, above_x, above_y)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      F64 x = q->get_x(X[i]);
+      F64 y = q->get_y(Y[i]);
+      return !((x < below_x) || (x >= above_x) || (y < below_y) || (y >= above_y));
+    });
+  };
   LAScriterionDropxy(F64 below_x, F64 below_y, F64 above_x, F64 above_y) { this->below_x = below_x; this->below_y = below_y; this->above_x = above_x; this->above_y = above_y; };
 private:
   F64 below_x, below_y, above_x, above_y;
@@ -249,6 +354,16 @@ public:
   inline const CHAR* name() const { return "keep_x"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_x, above_x); };
   inline BOOL filter(const LASpoint* point) { F64 x = point->get_x(); return (x < below_x) || (x >= above_x); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X)
+    {
+      F64 x = q->get_x(X);
+      return (x < below_x) || (x >= above_x);
+    });
+  };
   LAScriterionKeepx(F64 below_x, F64 above_x) { this->below_x = below_x; this->above_x = above_x; };
 private:
   F64 below_x, above_x;
@@ -260,6 +375,16 @@ public:
   inline const CHAR* name() const { return "drop_x"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_x, above_x); };
   inline BOOL filter(const LASpoint* point) { F64 x = point->get_x(); return ((below_x <= x) && (x < above_x)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X)
+    {
+      F64 x = q->get_x(X);
+      return ((below_x <= x) && (x < above_x));
+    });
+  };
   LAScriterionDropx(F64 below_x, F64 above_x) { this->below_x = below_x; this->above_x = above_x; };
 private:
   F64 below_x, above_x;
@@ -271,6 +396,16 @@ public:
   inline const CHAR* name() const { return "keep_y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_y, above_y); };
   inline BOOL filter(const LASpoint* point) { F64 y = point->get_y(); return (y < below_y) || (y >= above_y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y)
+    {
+      F64 y = q->get_y(Y);
+      return (y < below_y) || (y >= above_y);
+    });
+  };
   LAScriterionKeepy(F64 below_y, F64 above_y) { this->below_y = below_y; this->above_y = above_y; };
 private:
   F64 below_y, above_y;
@@ -282,6 +417,16 @@ public:
   inline const CHAR* name() const { return "drop_y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_y, above_y); };
   inline BOOL filter(const LASpoint* point) { F64 y = point->get_y(); return ((below_y <= y) && (y < above_y)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y)
+    {
+      F64 y = q->get_y(Y);
+      return ((below_y <= y) && (y < above_y));
+    });
+  };
   LAScriterionDropy(F64 below_y, F64 above_y) { this->below_y = below_y; this->above_y = above_y; };
 private:
   F64 below_y, above_y;
@@ -294,6 +439,16 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_z, above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { F64 z = point->get_z(); return (z < below_z) || (z >= above_z); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z)
+    {
+      F64 z = q->get_z(Z);
+      return (z < below_z) || (z >= above_z);
+    });
+  };
   LAScriterionKeepz(F64 below_z, F64 above_z) { this->below_z = below_z; this->above_z = above_z; };
 private:
   F64 below_z, above_z;
@@ -306,6 +461,16 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_z, above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { F64 z = point->get_z(); return ((below_z <= z) && (z < above_z)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z)
+    {
+      F64 z = q->get_z(Z);
+      return ((below_z <= z) && (z < above_z));
+    });
+  };
   LAScriterionDropz(F64 below_z, F64 above_z) { this->below_z = below_z; this->above_z = above_z; };
 private:
   F64 below_z, above_z;
@@ -317,6 +482,12 @@ public:
   inline const CHAR* name() const { return "drop_x_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() < below_x); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return (q->get_x(X) < below_x); });
+  };
   LAScriterionDropxBelow(F64 below_x) { this->below_x = below_x; };
 private:
   F64 below_x;
@@ -328,6 +499,12 @@ public:
   inline const CHAR* name() const { return "drop_x_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_x); };
   inline BOOL filter(const LASpoint* point) { return (point->get_x() >= above_x); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return (q->get_x(X) >= above_x); });
+  };
   LAScriterionDropxAbove(F64 above_x) { this->above_x = above_x; };
 private:
   F64 above_x;
@@ -339,6 +516,12 @@ public:
   inline const CHAR* name() const { return "drop_y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() < below_y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return (q->get_y(Y) < below_y); });
+  };
   LAScriterionDropyBelow(F64 below_y) { this->below_y = below_y; };
 private:
   F64 below_y;
@@ -350,6 +533,12 @@ public:
   inline const CHAR* name() const { return "drop_y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_y() >= above_y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return (q->get_y(Y) >= above_y); });
+  };
   LAScriterionDropyAbove(F64 above_y) { this->above_y = above_y; };
 private:
   F64 above_y;
@@ -362,6 +551,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() < below_z); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return (q->get_z(Z) < below_z); });
+  };
   LAScriterionDropzBelow(F64 below_z) { this->below_z = below_z; };
 private:
   F64 below_z;
@@ -374,6 +569,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_z() >= above_z); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const LASquantizer* q = batch->quantizer;
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return (q->get_z(Z) >= above_z); });
+  };
   LAScriterionDropzAbove(F64 above_z) { this->above_z = above_z; };
 private:
   F64 above_z;
@@ -385,6 +586,16 @@ public:
   inline const CHAR* name() const { return "keep_XY"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d %d %d ", name(), below_X, below_Y, above_X, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (point->get_Y() < below_Y) || (point->get_X() >= above_X) || (point->get_Y() >= above_Y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    const I32* X = batch->X + start;
+    const I32* Y = batch->Y + start;
+    return drop_batch(number, keep, [&](const U32 i)
+    {
+      return (X[i] < below_X) || (Y[i] < below_Y) || (X[i] >= above_X) || (Y[i] >= above_Y);
+    });
+  };
   LAScriterionKeepXY(I32 below_X, I32 below_Y, I32 above_X, I32 above_Y) { this->below_X = below_X; this->below_Y = below_Y; this->above_X = above_X; this->above_Y = above_Y; };
 private:
   I32 below_X, below_Y, above_X, above_Y;
@@ -396,6 +607,11 @@ public:
   inline const CHAR* name() const { return "keep_X"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_X, above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X) || (above_X <= point->get_X()); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return (X < below_X) || (above_X <= X); });
+  };
   LAScriterionKeepX(I32 below_X, I32 above_X) { this->below_X = below_X; this->above_X = above_X; };
 private:
   I32 below_X, above_X;
@@ -407,6 +623,11 @@ public:
   inline const CHAR* name() const { return "drop_X"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_X, above_X); };
   inline BOOL filter(const LASpoint* point) { return ((below_X <= point->get_X()) && (point->get_X() < above_X)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return ((below_X <= X) && (X < above_X)); });
+  };
   LAScriterionDropX(I32 below_X, I32 above_X) { this->below_X = below_X; this->above_X = above_X; };
 private:
   I32 below_X;
@@ -419,6 +640,11 @@ public:
   inline const CHAR* name() const { return "keep_Y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Y, above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y) || (above_Y <= point->get_Y()); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return (Y < below_Y) || (above_Y <= Y); });
+  };
   LAScriterionKeepY(I32 below_Y, I32 above_Y) { this->below_Y = below_Y; this->above_Y = above_Y; };
 private:
   I32 below_Y, above_Y;
@@ -430,6 +656,11 @@ public:
   inline const CHAR* name() const { return "drop_Y"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Y, above_Y); };
   inline BOOL filter(const LASpoint* point) { return ((below_Y <= point->get_Y()) && (point->get_Y() < above_Y)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return ((below_Y <= Y) && (Y < above_Y)); });
+  };
   LAScriterionDropY(I32 below_Y, I32 above_Y) { this->below_Y = below_Y; this->above_Y = above_Y; };
 private:
   I32 below_Y;
@@ -443,6 +674,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Z, above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z) || (above_Z <= point->get_Z()); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return (Z < below_Z) || (above_Z <= Z); });
+  };
   LAScriterionKeepZ(I32 below_Z, I32 above_Z) { this->below_Z = below_Z; this->above_Z = above_Z; };
 private:
   I32 below_Z, above_Z;
@@ -455,6 +691,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_Z, above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return ((below_Z <= point->get_Z()) && (point->get_Z() < above_Z)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return ((below_Z <= Z) && (Z < above_Z)); });
+  };
   LAScriterionDropZ(I32 below_Z, I32 above_Z) { this->below_Z = below_Z; this->above_Z = above_Z; };
 private:
   I32 below_Z;
@@ -467,6 +708,11 @@ public:
   inline const CHAR* name() const { return "drop_X_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() < below_X); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return (X < below_X); });
+  };
   LAScriterionDropXBelow(I32 below_X) { this->below_X = below_X; };
 private:
   I32 below_X;
@@ -478,6 +724,11 @@ public:
   inline const CHAR* name() const { return "drop_X_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_X); };
   inline BOOL filter(const LASpoint* point) { return (point->get_X() >= above_X); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->X + start, number, keep, [&](const I32 X) { return (X >= above_X); });
+  };
   LAScriterionDropXAbove(I32 above_X) { this->above_X = above_X; };
 private:
   I32 above_X;
@@ -489,6 +740,11 @@ public:
   inline const CHAR* name() const { return "drop_Y_below"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() < below_Y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return (Y < below_Y); });
+  };
   LAScriterionDropYBelow(I32 below_Y) { this->below_Y = below_Y; };
 private:
   I32 below_Y;
@@ -500,6 +756,11 @@ public:
   inline const CHAR* name() const { return "drop_Y_above"; };
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Y); };
   inline BOOL filter(const LASpoint* point) { return (point->get_Y() >= above_Y); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Y + start, number, keep, [&](const I32 Y) { return (Y >= above_Y); });
+  };
   LAScriterionDropYAbove(I32 above_Y) { this->above_Y = above_Y; };
 private:
   I32 above_Y;
@@ -512,6 +773,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() < below_Z); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return (Z < below_Z); });
+  };
   LAScriterionDropZBelow(I32 below_Z) { this->below_Z = below_Z; };
 private:
   I32 below_Z;
@@ -524,6 +790,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_Z); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_Z; };
   inline BOOL filter(const LASpoint* point) { return (point->get_Z() >= above_Z); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->Z + start, number, keep, [&](const I32 Z) { return (Z >= above_Z); });
+  };
   LAScriterionDropZAbove(I32 above_Z) { this->above_Z = above_Z; };
 private:
   I32 above_Z;
@@ -1147,6 +1418,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity) || (point->get_intensity() > above_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (intensity < below_intensity) || (intensity > above_intensity); });
+  };
   LAScriterionKeepIntensity(U16 below_intensity, U16 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   U16 below_intensity, above_intensity;
@@ -1159,6 +1435,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() >= below_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (intensity >= below_intensity); });
+  };
   LAScriterionKeepIntensityBelow(U16 below_intensity) { this->below_intensity = below_intensity; };
 private:
   U16 below_intensity;
@@ -1171,6 +1452,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() <= above_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (intensity <= above_intensity); });
+  };
   LAScriterionKeepIntensityAbove(U16 above_intensity) { this->above_intensity = above_intensity; };
 private:
   U16 above_intensity;
@@ -1183,6 +1469,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() < below_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (intensity < below_intensity); });
+  };
   LAScriterionDropIntensityBelow(I32 below_intensity) { this->below_intensity = below_intensity; };
 private:
   I32 below_intensity;
@@ -1195,6 +1486,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (point->get_intensity() > above_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (intensity > above_intensity); });
+  };
   LAScriterionDropIntensityAbove(I32 above_intensity) { this->above_intensity = above_intensity; };
 private:
   I32 above_intensity;
@@ -1207,6 +1503,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_intensity, above_intensity); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_INTENSITY; };
   inline BOOL filter(const LASpoint* point) { return (below_intensity <= point->get_intensity()) && (point->get_intensity() <= above_intensity); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->intensity + start, number, keep, [&](const U16 intensity) { return (below_intensity <= intensity) && (intensity <= above_intensity); });
+  };
   LAScriterionDropIntensityBetween(I32 below_intensity, I32 above_intensity) { this->below_intensity = below_intensity; this->above_intensity = above_intensity; };
 private:
   I32 below_intensity, above_intensity;
@@ -1242,6 +1543,11 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->classification + start, number, keep, [&](const U8 classification) { return (classification < 32 ? (((1u << classification) & drop_classification_mask) != 0) : TRUE); });
+  };
   LAScriterionKeepClassifications(U32 keep_classification_mask) { drop_classification_mask = ~keep_classification_mask; };
   inline U32 get_keep_classification_mask() const { return ~drop_classification_mask; };
 private:
@@ -1277,6 +1583,11 @@ public:
       return ((1u << point->classification) & drop_classification_mask);
     }
   };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->classification + start, number, keep, [&](const U8 classification) { return (classification < 32 ? (((1u << classification) & drop_classification_mask) != 0) : FALSE); });
+  };
   LAScriterionDropClassifications(U32 drop_classification_mask) { this->drop_classification_mask = drop_classification_mask; };
   inline U32 get_drop_classification_mask() const { return drop_classification_mask; };
 private:
@@ -1302,6 +1613,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_synthetic_flag() == 1); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 1) != 0); });
+  };
 };
 
 class LAScriterionKeepSynthetic : public LAScriterion
@@ -1311,6 +1627,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_synthetic_flag() == 0); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 1) == 0); });
+  };
 };
 
 class LAScriterionDropKeypoint : public LAScriterion
@@ -1320,6 +1641,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_keypoint_flag() == 1); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 2) != 0); });
+  };
 };
 
 class LAScriterionKeepKeypoint : public LAScriterion
@@ -1329,6 +1655,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_keypoint_flag() == 0); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 2) == 0); });
+  };
 };
 
 class LAScriterionDropWithheld : public LAScriterion
@@ -1338,6 +1669,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_withheld_flag() == 1); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 4) != 0); });
+  };
 };
 
 class LAScriterionKeepWithheld : public LAScriterion
@@ -1347,6 +1683,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_withheld_flag() == 0); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 4) == 0); });
+  };
 };
 
 class LAScriterionDropOverlap : public LAScriterion
@@ -1356,6 +1697,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_extended_overlap_flag() == 1); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 8) != 0); });
+  };
 };
 
 class LAScriterionKeepOverlap : public LAScriterion
@@ -1365,6 +1711,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s ", name()); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_FLAGS; };
   inline BOOL filter(const LASpoint* point) { return (point->get_extended_overlap_flag() == 0); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->flags + start, number, keep, [&](const U8 flags) { return ((flags & 8) == 0); });
+  };
 };
 
 class LAScriterionKeepUserData : public LAScriterion
@@ -1374,6 +1725,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data != user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value != user_data); });
+  };
   LAScriterionKeepUserData(U8 user_data) { this->user_data = user_data; };
 private:
   U8 user_data;
@@ -1386,6 +1742,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data >= below_user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value >= below_user_data); });
+  };
   LAScriterionKeepUserDataBelow(U8 below_user_data) { this->below_user_data = below_user_data; };
 private:
   U8 below_user_data;
@@ -1398,6 +1759,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data <= above_user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value <= above_user_data); });
+  };
   LAScriterionKeepUserDataAbove(U8 above_user_data) { this->above_user_data = above_user_data; };
 private:
   U8 above_user_data;
@@ -1410,6 +1776,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_user_data, above_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data < below_user_data) || (above_user_data < point->user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value < below_user_data) || (above_user_data < value); });
+  };
   LAScriterionKeepUserDataBetween(U8 below_user_data, U8 above_user_data) { this->below_user_data = below_user_data; this->above_user_data = above_user_data; };
 private:
   U8 below_user_data, above_user_data;
@@ -1422,6 +1793,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data == user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value == user_data); });
+  };
   LAScriterionDropUserData(U8 user_data) { this->user_data = user_data; };
 private:
   U8 user_data;
@@ -1434,6 +1810,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data < below_user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value < below_user_data); });
+  };
   LAScriterionDropUserDataBelow(U8 below_user_data) { this->below_user_data = below_user_data; };
 private:
   U8 below_user_data;
@@ -1446,6 +1827,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (point->user_data > above_user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (value > above_user_data); });
+  };
   LAScriterionDropUserDataAbove(U8 above_user_data) { this->above_user_data = above_user_data; };
 private:
   U8 above_user_data;
@@ -1458,6 +1844,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_user_data, above_user_data); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_USER_DATA; };
   inline BOOL filter(const LASpoint* point) { return (below_user_data <= point->user_data) && (point->user_data <= above_user_data); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->user_data + start, number, keep, [&](const U8 value) { return (below_user_data <= value) && (value <= above_user_data); });
+  };
   LAScriterionDropUserDataBetween(U8 below_user_data, U8 above_user_data) { this->below_user_data = below_user_data; this->above_user_data = above_user_data; };
 private:
   U8 below_user_data, above_user_data;
@@ -1470,6 +1861,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (point->get_point_source_ID() != point_source_id); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (point_source_ID != point_source_id); });
+  };
   LAScriterionKeepPointSource(U16 point_source_id) { this->point_source_id = point_source_id; };
 private:
   U16 point_source_id;
@@ -1482,6 +1878,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_point_source_id, above_point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (point->get_point_source_ID() < below_point_source_id) || (above_point_source_id < point->get_point_source_ID()); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (point_source_ID < below_point_source_id) || (above_point_source_id < point_source_ID); });
+  };
   LAScriterionKeepPointSourceBetween(U16 below_point_source_id, U16 above_point_source_id) { this->below_point_source_id = below_point_source_id; this->above_point_source_id = above_point_source_id; };
 private:
   U16 below_point_source_id, above_point_source_id;
@@ -1494,6 +1895,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (point->get_point_source_ID() == point_source_id); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (point_source_ID == point_source_id); });
+  };
   LAScriterionDropPointSource(U16 point_source_id) { this->point_source_id = point_source_id; };
 private:
   U16 point_source_id;
@@ -1506,6 +1912,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), below_point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (point->get_point_source_ID() < below_point_source_id); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (point_source_ID < below_point_source_id); });
+  };
   LAScriterionDropPointSourceBelow(U16 below_point_source_id) { this->below_point_source_id = below_point_source_id; };
 private:
   U16 below_point_source_id;
@@ -1518,6 +1929,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d ", name(), above_point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (point->get_point_source_ID() > above_point_source_id); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (point_source_ID > above_point_source_id); });
+  };
   LAScriterionDropPointSourceAbove(U16 above_point_source_id) { this->above_point_source_id = above_point_source_id; };
 private:
   U16 above_point_source_id;
@@ -1530,6 +1946,11 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %d %d ", name(), below_point_source_id, above_point_source_id); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_POINT_SOURCE; };
   inline BOOL filter(const LASpoint* point) { return (below_point_source_id <= point->get_point_source_ID()) && (point->get_point_source_ID() <= above_point_source_id); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    return drop_batch(batch->point_source_ID + start, number, keep, [&](const U16 point_source_ID) { return (below_point_source_id <= point_source_ID) && (point_source_ID <= above_point_source_id); });
+  };
   LAScriterionDropPointSourceBetween(U16 below_point_source_id, U16 above_point_source_id) { this->below_point_source_id = below_point_source_id; this->above_point_source_id = above_point_source_id; };
 private:
   U16 below_point_source_id, above_point_source_id;
@@ -1542,6 +1963,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_gpstime, above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && ((point->gps_time < below_gpstime) || (point->gps_time > above_gpstime))); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    if (!batch->have_gps_time) return 0;
+    return drop_batch(batch->gps_time + start, number, keep, [&](const F64 gps_time) { return ((gps_time < below_gpstime) || (gps_time > above_gpstime)); });
+  };
   LAScriterionKeepGpsTime(F64 below_gpstime, F64 above_gpstime) { this->below_gpstime = below_gpstime; this->above_gpstime = above_gpstime; };
 private:
   F64 below_gpstime, above_gpstime;
@@ -1554,6 +1981,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), below_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && (point->gps_time < below_gpstime)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    if (!batch->have_gps_time) return 0;
+    return drop_batch(batch->gps_time + start, number, keep, [&](const F64 gps_time) { return (gps_time < below_gpstime); });
+  };
   LAScriterionDropGpsTimeBelow(F64 below_gpstime) { this->below_gpstime = below_gpstime; };
 private:
   F64 below_gpstime;
@@ -1566,6 +1999,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf ", name(), above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && (point->gps_time > above_gpstime)); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    if (!batch->have_gps_time) return 0;
+    return drop_batch(batch->gps_time + start, number, keep, [&](const F64 gps_time) { return (gps_time > above_gpstime); });
+  };
   LAScriterionDropGpsTimeAbove(F64 above_gpstime) { this->above_gpstime = above_gpstime; };
 private:
   F64 above_gpstime;
@@ -1578,6 +2017,12 @@ public:
   inline I32 get_command(CHAR* string) const { return sprintf(string, "-%s %lf %lf ", name(), below_gpstime, above_gpstime); };
   inline U32 get_decompress_selective() const { return LASZIP_DECOMPRESS_SELECTIVE_GPS_TIME; };
   inline BOOL filter(const LASpoint* point) { return (point->have_gps_time && ((below_gpstime <= point->gps_time) && (point->gps_time <= above_gpstime))); };
+  inline BOOL has_batch() const { return TRUE; };
+  inline U32 filter_batch(const LASpointBatch* batch, const U32 start, const U32 number, U8* keep)
+  {
+    if (!batch->have_gps_time) return 0;
+    return drop_batch(batch->gps_time + start, number, keep, [&](const F64 gps_time) { return ((below_gpstime <= gps_time) && (gps_time <= above_gpstime)); });
+  };
   LAScriterionDropGpsTimeBetween(F64 below_gpstime, F64 above_gpstime) { this->below_gpstime = below_gpstime; this->above_gpstime = above_gpstime; };
 private:
   F64 below_gpstime, above_gpstime;
@@ -5428,6 +5873,57 @@ BOOL LASfilter::filter(const LASpoint* point)
   return FALSE; // point survived
 }
 
+BOOL LASfilter::can_filter(const LASpointBatch* batch) const
+{
+  if (batch->has_records()) return TRUE;
+  U32 i;
+  for (i = 0; i < num_criteria; i++)
+  {
+    if (!criteria[i]->has_batch()) return FALSE;
+  }
+  return TRUE;
+}
+
+U32 LASfilter::filter(LASpointBatch* batch, const U32 start, LASpoint* point)
+{
+  if (start >= batch->count) return batch->count;
+  U32 number = batch->count - start;
+  if (number > alloc_keep)
+  {
+    if (keep) delete[] keep;
+    keep = new U8[number];
+    alloc_keep = number;
+  }
+  memset(keep, 1, number);
+
+  // each criterion only counts the points that survived all criteria before it
+  // which gives the same counters[] as filtering the points one by one
+  U32 i, j, dropped, remaining = number;
+  for (i = 0; (i < num_criteria) && remaining; i++)
+  {
+    if (criteria[i]->has_batch())
+    {
+      dropped = criteria[i]->filter_batch(batch, start, number, keep);
+    }
+    else
+    {
+      dropped = 0;
+      for (j = 0; j < number; j++)
+      {
+        if (keep[j] && batch->get_point(start + j, point) && criteria[i]->filter(point))
+        {
+          keep[j] = 0;
+          dropped++;
+        }
+      }
+    }
+    counters[i] += dropped;
+    remaining -= dropped;
+  }
+  if (remaining < number) batch->compact(start, keep);
+  return batch->count;
+}
+
 void LASfilter::reset()
 {
   U32 i;
@@ -5443,11 +5939,14 @@ LASfilter::LASfilter()
   num_criteria = 0;
   criteria = 0;
   counters = 0;
+  keep = 0;
+  alloc_keep = 0;
 }
 
 LASfilter::~LASfilter()
 {
   if (criteria) clean();
+  if (keep) delete[] keep;
 }
 
 void LASfilter::add_criterion(LAScriterion* filter_criterion)
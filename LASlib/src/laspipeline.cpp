@@ -0,0 +1,253 @@
+/*
+===============================================================================
+
+  FILE:  laspipeline.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "laspipeline.hpp"
+
+#include "lasfilter.hpp"
+#include "lastransform.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+// a bounded queue of batches between exactly one producer thread and one consumer thread. the batch
+// pointer 0 marks the end of the stream
+class LASbatchQueue
+{
+public:
+  void push(LASpointBatch* batch)
+  {
+    U32 t = tail.load(std::memory_order_relaxed);
+    U32 next = (t + 1) % size;
+    U32 spins = 0;
+    while (next == head.load(std::memory_order_acquire)) wait(spins);
+    slots[t] = batch;
+    tail.store(next, std::memory_order_release);
+  };
+  LASpointBatch* pop()
+  {
+    U32 h = head.load(std::memory_order_relaxed);
+    U32 spins = 0;
+    while (h == tail.load(std::memory_order_acquire)) wait(spins);
+    LASpointBatch* batch = slots[h];
+    head.store((h + 1) % size, std::memory_order_release);
+    return batch;
+  };
+  LASbatchQueue(const U32 capacity)
+  {
+    size = capacity + 1;
+    slots = new LASpointBatch*[size];
+    head.store(0);
+    tail.store(0);
+  };
+  ~LASbatchQueue()
+  {
+    delete[] slots;
+  };
+private:
+  // yield for a while and then sleep so that a stage waiting for a slow one does not burn a core
+  static void wait(U32& spins)
+  {
+    if (spins < 64)
+    {
+      spins++;
+      std::this_thread::yield();
+    }
+    else
+    {
+      std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+  };
+  U32 size;
+  LASpointBatch** slots;
+  std::atomic<U32> head;
+  std::atomic<U32> tail;
+};
+
+I64 LASpipeline::run(LASreader* lasreader, LASwriter* laswriter, const BOOL update_inventory, const I64 stop, LASpoint* target)
+{
+  U32 i;
+
+  // when the reader cannot leave them to us it filters and transforms on the reading thread
+
+  LASfilter* filter = (lasreader->has_separable_processing() ? lasreader->get_filter() : 0);
+  LAStransform* transform = (lasreader->has_separable_processing() ? lasreader->get_transform() : 0);
+
+  // the ring of batches keeps the complete point records
+
+  LASpointBatch* batches = new LASpointBatch[num_batches];
+  for (i = 0; i < num_batches; i++)
+  {
+    if (!batches[i].init(&lasreader->point, batch_size, TRUE))
+    {
+      delete[] batches;
+      return 0;
+    }
+  }
+
+  // each of the two stages that are not on this thread get their own point
+
+  LASpoint process_point;
+  LASpoint write_point;
+  process_point.init(lasreader->point.quantizer, lasreader->point.num_items, lasreader->point.items, lasreader->point.attributer);
+  write_point.init(lasreader->point.quantizer, lasreader->point.num_items, lasreader->point.items, lasreader->point.attributer);
+
+  LASbatchQueue free_batches(num_batches);
+  LASbatchQueue read_batches(num_batches);
+  LASbatchQueue processed_batches(num_batches);
+  for (i = 0; i < num_batches; i++)
+  {
+    free_batches.push(&batches[i]);
+  }
+
+  // the reading and the writing stage must not end the process on an error. a reader that fails
+  // returns FALSE so that the points read so far still get written, and this thread halts after the
+  // join
+
+  BOOL reading_halted = FALSE;
+  BOOL writing_halted = FALSE;
+
+  // the reading stage
+
+  std::thread reading([&]()
+  {
+    defer_halt_on_error = true;
+    BOOL more = TRUE;
+    while (more)
+    {
+      LASpointBatch* batch = free_batches.pop();
+      batch->clear();
+      while (!batch->is_full())
+      {
+        if (!lasreader->read_point_unprocessed() || (lasreader->p_count > stop))
+        {
+          more = FALSE;
+          break;
+        }
+        batch->add(&lasreader->point);
+      }
+      if (batch->count) read_batches.push(batch);
+    }
+    read_batches.push(0);
+    reading_halted = deferred_halt;
+  });
+
+  // the writing stage
+
+  I64 written = 0;
+  std::thread writing([&]()
+  {
+    defer_halt_on_error = true;
+    LASpointBatch* batch;
+    while ((batch = processed_batches.pop()) != 0)
+    {
+      for (U32 j = 0; j < batch->count; j++)
+      {
+        batch->get_point(j, &write_point);
+        LASpoint* point = &write_point;
+        if (target)
+        {
+          *target = write_point;
+          point = target;
+        }
+        laswriter->write_point(point);
+        if (update_inventory) laswriter->update_inventory(point);
+      }
+      written += batch->count;
+      free_batches.push(batch);
+    }
+    writing_halted = deferred_halt;
+  });
+
+  // the filtering and transforming stage
+
+  U8* keep = 0;
+  LASpointBatch* batch;
+  while ((batch = read_batches.pop()) != 0)
+  {
+    if (filter)
+    {
+      if (filter->can_filter(batch))
+      {
+        filter->filter(batch, 0, &process_point);
+      }
+      else
+      {
+        if (keep == 0) keep = new U8[batch_size];
+        for (i = 0; i < batch->count; i++)
+        {
+          batch->get_point(i, &process_point);
+          keep[i] = !filter->filter(&process_point);
+        }
+        batch->compact(0, keep);
+      }
+    }
+    if (transform)
+    {
+      if (transform->can_transform(batch))
+      {
+        transform->transform(batch, 0);
+      }
+      else
+      {
+        for (i = 0; i < batch->count; i++)
+        {
+          batch->get_point(i, &process_point);
+          transform->transform(&process_point);
+          batch->set_point(i, &process_point);
+        }
+      }
+    }
+    processed_batches.push(batch);
+  }
+  processed_batches.push(0);
+
+  reading.join();
+  writing.join();
+
+  if (keep) delete[] keep;
+  delete[] batches;
+
+  LASMessage(LAS_VERBOSE, "pipelined %lld points in %u batches of %u points", written, num_batches, batch_size);
+
+  // the errors were reported by the stages. halt like the serial loop would have
+
+  if (reading_halted || writing_halted)
+  {
+    byebye();
+  }
+  return written;
+}
+
+LASpipeline::LASpipeline(const U32 num_batches, const U32 batch_size)
+{
+  this->num_batches = (num_batches < 2 ? 2 : num_batches);
+  this->batch_size = (batch_size ? batch_size : LAS_PIPELINE_DEFAULT_BATCH_SIZE);
+}
@@ -0,0 +1,204 @@
+/*
+===============================================================================
+
+  FILE:  laspointbatch.cpp
+
+  CONTENTS:
+
+    see corresponding header file
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the GNU Lesser General Licence as published by the Free Software
+    Foundation. See the LICENSE.txt file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    see corresponding header file
+
+===============================================================================
+*/
+#include "laspointbatch.hpp"
+
+template <typename T>
+static BOOL grow_array(T*& array, const U32 capacity)
+{
+  T* grown = (T*)realloc(array, sizeof(T) * (size_t)capacity);
+  if (grown == 0) return FALSE;
+  array = grown;
+  return TRUE;
+}
+
+BOOL LASpointBatch::init(const LASpoint* point, const U32 capacity, const BOOL with_records)
+{
+  clean();
+  this->with_records = with_records;
+  // the fixed fields from X up to and including the GPS time followed by all other items
+  core_size = (point ? (U32)(((const U8*)&point->gps_time - (const U8*)&point->X) + sizeof(F64)) : 0);
+  record_size = (point ? core_size + point->total_point_size - point->items[0].size : 0);
+  quantizer = (point ? point->quantizer : 0);
+  have_gps_time = (point ? point->have_gps_time : FALSE);
+  extended_point_type = (point ? point->is_extended_point_type() : FALSE);
+  if (with_records && (record_size == 0))
+  {
+    laserror("cannot keep point records in batch without knowing the point size");
+    return FALSE;
+  }
+  return reserve(capacity);
+}
+
+BOOL LASpointBatch::reserve(const U32 capacity)
+{
+  if (capacity <= this->capacity) return TRUE;
+  if (!grow_array(X, capacity) || !grow_array(Y, capacity) || !grow_array(Z, capacity) ||
+      !grow_array(intensity, capacity) || !grow_array(return_number, capacity) || !grow_array(number_of_returns, capacity) ||
+      !grow_array(classification, capacity) || !grow_array(flags, capacity) || !grow_array(scan_angle, capacity) ||
+      !grow_array(user_data, capacity) || !grow_array(point_source_ID, capacity) || !grow_array(gps_time, capacity))
+  {
+    laserror("allocating point batch for %u points", capacity);
+    return FALSE;
+  }
+  if (with_records)
+  {
+    U8* grown = (U8*)realloc(records, (size_t)record_size * (size_t)capacity);
+    if (grown == 0)
+    {
+      laserror("allocating %u point records of %u bytes for point batch", capacity, record_size);
+      return FALSE;
+    }
+    records = grown;
+  }
+  this->capacity = capacity;
+  return TRUE;
+}
+
+void LASpointBatch::compact(const U32 start, const U8* keep)
+{
+  U32 i, n = start;
+  for (i = start; i < count; i++)
+  {
+    if (keep[i - start])
+    {
+      if (n != i)
+      {
+        X[n] = X[i];
+        Y[n] = Y[i];
+        Z[n] = Z[i];
+        intensity[n] = intensity[i];
+        return_number[n] = return_number[i];
+        number_of_returns[n] = number_of_returns[i];
+        classification[n] = classification[i];
+        flags[n] = flags[i];
+        scan_angle[n] = scan_angle[i];
+        user_data[n] = user_data[i];
+        point_source_ID[n] = point_source_ID[i];
+        gps_time[n] = gps_time[i];
+        if (records) memcpy(records + (size_t)n * record_size, records + (size_t)i * record_size, record_size);
+      }
+      n++;
+    }
+  }
+  count = n;
+}
+
+void LASpointBatch::update_records(const U32 start)
+{
+  if (records == 0) return;
+  // the attributes all lie within the LASpoint core at the front of each record
+  LASpoint core;
+  U32 i;
+  for (i = start; i < count; i++)
+  {
+    U8* record = records + (size_t)i * record_size;
+    memcpy(&core.X, record, core_size);
+    core.X = X[i];
+    core.Y = Y[i];
+    core.Z = Z[i];
+    if (extended_point_type)
+    {
+      core.set_extended_classification(classification[i]);
+    }
+    else
+    {
+      // like in the per-point path the legacy point types only write the legacy classification
+      core.classification = classification[i];
+    }
+    core.user_data = user_data[i];
+    core.point_source_ID = point_source_ID[i];
+    memcpy(record, &core.X, core_size);
+  }
+}
+
+BOOL LASpointBatch::get_point(const U32 i, LASpoint* point) const
+{
+  if ((records == 0) || (i >= count) || (core_size + point->total_point_size - point->items[0].size != record_size)) return FALSE;
+  const U8* record = records + (size_t)i * record_size;
+  memcpy(&point->X, record, core_size);
+  U32 j, b = core_size;
+  for (j = 1; j < point->num_items; j++)
+  {
+    memcpy(point->point[j], record + b, point->items[j].size);
+    b += point->items[j].size;
+  }
+  return TRUE;
+}
+
+void LASpointBatch::clean()
+{
+  free(X);
+  free(Y);
+  free(Z);
+  free(intensity);
+  free(return_number);
+  free(number_of_returns);
+  free(classification);
+  free(flags);
+  free(scan_angle);
+  free(user_data);
+  free(point_source_ID);
+  free(gps_time);
+  free(records);
+  X = Y = Z = 0;
+  intensity = 0;
+  return_number = number_of_returns = classification = flags = user_data = 0;
+  scan_angle = 0;
+  point_source_ID = 0;
+  gps_time = 0;
+  records = 0;
+  count = 0;
+  capacity = 0;
+}
+
+LASpointBatch::LASpointBatch()
+{
+  X = Y = Z = 0;
+  intensity = 0;
+  return_number = number_of_returns = classification = flags = user_data = 0;
+  scan_angle = 0;
+  point_source_ID = 0;
+  gps_time = 0;
+  records = 0;
+  count = 0;
+  quantizer = 0;
+  have_gps_time = FALSE;
+  extended_point_type = FALSE;
+  capacity = 0;
+  record_size = 0;
+  core_size = 0;
+  with_records = FALSE;
+}
+
+LASpointBatch::~LASpointBatch()
+{
+  clean();
+}
@@ -525,6 +525,40 @@ BOOL LASreader::read_point_filtered_and_transformed()
 	return FALSE;
 }
 
+U32 LASreader::read_points(LASpointBatch& batch, const U32 max)
+{
+	batch.clear();
+	if (batch.get_capacity() == 0)
+	{
+		if (!batch.init(&point, max)) return 0;
+	}
+	else if (!batch.reserve(max))
+	{
+		return 0;
+	}
+	if ((filter || transform) && (!filter || filter->can_filter(&batch)) && (!transform || transform->can_transform(&batch)))
+	{
+		// read the points as they are and then filter and transform them batch by batch
+		BOOL more = TRUE;
+		while (more && (batch.count < max))
+		{
+			U32 start = batch.count;
+			while ((batch.count < max) && (more = (this->*read_complex)()))
+			{
+				batch.add(&point);
+			}
+			if (filter) filter->filter(&batch, start, &point);
+			if (transform) transform->transform(&batch, start);
+		}
+		return batch.count;
+	}
+	while ((batch.count < max) && (this->*read_simple)())
+	{
+		batch.add(&point);
+	}
+	return batch.count;
+}
+
 BOOL LASreadOpener::is_piped() const
 {
 	return (!file_names && use_stdin);
@@ -614,6 +648,18 @@ I32 LASreadOpener::unparse(CHAR* string) const
 	{
 		n += sprintf(string + n, "-io_ibuffer %u ", io_ibuffer_size);
 	}
+	if (io_mmap)
+	{
+		n += sprintf(string + n, "-io_mmap ");
+	}
+	if (decompress_threads > 1)
+	{
+		n += sprintf(string + n, "-decompress_threads %u ", decompress_threads);
+	}
+	if (parse_threads > 1)
+	{
+		n += sprintf(string + n, "-parse_threads %u ", parse_threads);
+	}
 	if (!temp_file_base.empty())
 	{
 		n += sprintf(string + n, "-temp_files \"%s\" ", temp_file_base.c_str());
@@ -896,7 +942,25 @@ LASreader* LASreadOpener::open(const CHAR* other_file_name, BOOL reset_after_oth
 			{
 				transform->setPointSource(file_name_current + files_are_flightlines + files_are_flightlines_index);
 			}
-			if (strstr(file_name, ".las") || strstr(file_name, ".laz") || strstr(file_name, ".LAS") || strstr(file_name, ".LAZ"))
+			if (metadata_only && (strstr(file_name, ".las") || strstr(file_name, ".laz") || strstr(file_name, ".LAS") || strstr(file_name, ".LAZ")))
+			{
+				// only the header, the VLRs, the EVLRs and the chunk table. no spatial index, no points
+				LASreaderLAS* lasreaderlas = new LASreaderLAS(this);
+				lasreaderlas->set_keep_copc(keep_copc);
+				lasreaderlas->set_peek_metadata(TRUE);
+				if (lasreaderlas->open(file_name, io_ibuffer_size, TRUE))
+				{
+					LASMessage(LAS_VERY_VERBOSE, "open metadata of file '%s'", file_name);
+				}
+				else
+				{
+					laserror("cannot open lasreaderlas with file name '%s'", file_name);
+					delete lasreaderlas;
+					return 0;
+				}
+				return lasreaderlas;
+			}
+			else if (strstr(file_name, ".las") || strstr(file_name, ".laz") || strstr(file_name, ".LAS") || strstr(file_name, ".LAZ"))
 			{
 				LASreaderLAS* lasreaderlas = nullptr;
 				if (scale_factor == 0 && offset == 0)
@@ -1933,6 +1997,8 @@ void LASreadOpener::usage() const
 											 "  -rescale_xy 0.01 0.01\n" \
 											 "  -rescale_z 0.01\n" \
 											 "  -reoffset 600000 4000000 0\n" \
+											 "  -decompress_threads 4 (LAZ chunks in parallel)\n" \
+											 "  -parse_threads 4 (ASCII lines in parallel)\n" \
 											 "Fast AOI Queries for LAS/LAZ with spatial indexing LAX files\n" \
 											 "  -inside min_x min_y max_x max_y\n" \
 											 "  -inside_tile ll_x ll_y size\n" \
@@ -2197,6 +2263,11 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
 				set_io_ibuffer_size(buffer_size);
 				*argv[i] = '\0'; *argv[i + 1] = '\0'; i += 1;
 			}
+			else if (strcmp(argv[i], "-io_mmap") == 0)
+			{
+				set_io_mmap(TRUE);
+				*argv[i] = '\0';
+			}
 			else if (strcmp(argv[i], "-itranslate_intensity") == 0)
 			{
 				if ((i + 1) >= argc)
@@ -2534,6 +2605,42 @@ void LASreadOpener::parse(int argc, char* argv[], BOOL parse_ignore, BOOL suppre
 			set_buffer_size(buffer_size);
 			*argv[i] = '\0'; *argv[i + 1] = '\0'; i += 1;
 		}
+		else if (strcmp(argv[i], "-decompress_threads") == 0)
+		{
+			if ((i + 1) >= argc)
+			{
+				laserror("'%s' needs 1 argument: number", argv[i]);
+			}
+			I32 number;
+			if (sscanf(argv[i + 1], "%d", &number) != 1)
+			{
+				laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+			}
+			if (number <= 0)
+			{
+				laserror("'%s' needs 1 argument: number but %d is not valid.", argv[i], number);
+			}
+			set_decompress_threads((U32)number);
+			*argv[i] = '\0'; *argv[i + 1] = '\0'; i += 1;
+		}
+		else if (strcmp(argv[i], "-parse_threads") == 0)
+		{
+			if ((i + 1) >= argc)
+			{
+				laserror("'%s' needs 1 argument: number", argv[i]);
+			}
+			I32 number;
+			if (sscanf(argv[i + 1], "%d", &number) != 1)
+			{
+				laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+			}
+			if (number <= 0)
+			{
+				laserror("'%s' needs 1 argument: number but %d is not valid.", argv[i], number);
+			}
+			set_parse_threads((U32)number);
+			*argv[i] = '\0'; *argv[i + 1] = '\0'; i += 1;
+		}
 		else if (strcmp(argv[i], "-temp_files") == 0)
 		{
 			if ((i + 1) >= argc)
@@ -2948,6 +3055,26 @@ void LASreadOpener::set_io_ibuffer_size(const U32 buffer_size)
 	this->io_ibuffer_size = buffer_size;
 }
 
+void LASreadOpener::set_io_mmap(const BOOL io_mmap)
+{
+	this->io_mmap = io_mmap;
+}
+
+void LASreadOpener::set_decompress_threads(const U32 decompress_threads)
+{
+	this->decompress_threads = decompress_threads;
+}
+
+void LASreadOpener::set_parse_threads(const U32 parse_threads)
+{
+	this->parse_threads = parse_threads;
+}
+
+void LASreadOpener::set_metadata_only(const BOOL metadata_only)
+{
+	this->metadata_only = metadata_only;
+}
+
 void LASreadOpener::set_file_name(const CHAR* file_name, BOOL unique)
 {
 	add_file_name(file_name, unique);
@@ -3682,6 +3809,7 @@ BOOL LASreadOpener::active() const
 LASreadOpener::LASreadOpener()
 {
 	io_ibuffer_size = LAS_TOOLS_IO_IBUFFER_SIZE;
+	io_mmap = FALSE;
 	file_name = 0;
 	file_names = 0;
 	file_names_ID = 0;
@@ -3744,6 +3872,9 @@ LASreadOpener::LASreadOpener()
 	neighbor_file_name_number = 0;
 	neighbor_file_name_allocated = 0;
 	decompress_selective = LASZIP_DECOMPRESS_SELECTIVE_ALL;
+	decompress_threads = 1;
+	parse_threads = 1;
+	metadata_only = FALSE;
 	inside_tile = 0;
 	inside_circle = 0;
 	inside_rectangle = 0;
@@ -42,6 +42,9 @@
 
 extern "C" FILE * fopen_compressed(const char* filename, const char* mode, bool* piped);
 
+// the parsed rasters are kept in memory when they need at most this much
+#define LAS_READER_ASC_CACHE_MEMORY ((size_t)512 * 1024 * 1024)
+
 BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
 {
   if (file_name == 0)
@@ -106,7 +109,6 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
     line = (CHAR*)malloc(sizeof(CHAR) * line_size);
   }
 
-  CHAR dummy[32];
   BOOL complete = FALSE;
   ncols = 0;
   nrows = 0;
@@ -136,11 +138,9 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
       }
     }
 
-    unsigned int dummy_size = static_cast<unsigned int>(sizeof(dummy));
-
     if (strstr(line, "ncols") || strstr(line, "NCOLS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, &ncols);
+      sscanf_las(line, "%*s %d", &ncols);
       free(line);
       line_size = 1024 + 50 * ncols;
       line = (CHAR*)malloc(sizeof(CHAR) * line_size);
@@ -148,31 +148,31 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
 #pragma warning(pop)
     else if (strstr(line, "nrows") || strstr(line, "NROWS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, &nrows);
+      sscanf_las(line, "%*s %d", &nrows);
     }
     else if (strstr(line, "xllcorner") || strstr(line, "XLLCORNER"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &xllcorner);
+      sscanf_las(line, "%*s %lf", &xllcorner);
     }
     else if (strstr(line, "yllcorner") || strstr(line, "YLLCORNER"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &yllcorner);
+      sscanf_las(line, "%*s %lf", &yllcorner);
     }
     else if (strstr(line, "xllcenter") || strstr(line, "XLLCENTER"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &xllcenter);
+      sscanf_las(line, "%*s %lf", &xllcenter);
     }
     else if (strstr(line, "yllcenter") || strstr(line, "YLLCENTER"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &yllcenter);
+      sscanf_las(line, "%*s %lf", &yllcenter);
     }
     else if (strstr(line, "cellsize") || strstr(line, "CELLSIZE"))
     {
-      sscanf_las(line, "%s %f", dummy, dummy_size, &cellsize);
+      sscanf_las(line, "%*s %f", &cellsize);
     }
     else if (strstr(line, "nodata_value") || strstr(line, "NODATA_VALUE") || strstr(line, "nodata_VALUE") || strstr(line, "NODATA_value"))
     {
-      sscanf_las(line, "%s %f", dummy, dummy_size, &nodata);
+      sscanf_las(line, "%*s %f", &nodata);
     }
     else if ((ncols != 0) && (nrows != 0) && (((xllcorner != F64_MAX) && (yllcorner != F64_MAX)) || ((xllcenter != F64_MAX) && (yllcenter != F64_MAX))) && (cellsize > 0))
     {
@@ -241,58 +241,37 @@ BOOL LASreaderASC::open(const CHAR* file_name, BOOL comma_not_point)
   header.max_x = xllcenter + (ncols - 1) * cellsize;
   header.max_y = yllcenter + (nrows - 1) * cellsize;
 
-  // init the bounding box z and count the rasters
+  // init the bounding box z and count the rasters. unless the raster is huge the parsed elevations
+  // are kept so that reading the points does not have to parse the ASC file a second time
 
   F64 elevation = 0;
   npoints = 0;
   header.min_z = F64_MAX;
   header.max_z = F64_MIN;
 
+  I64 cell, number_cells = (I64)ncols * (I64)nrows;
+  if ((number_cells > 0) && ((size_t)number_cells <= LAS_READER_ASC_CACHE_MEMORY / sizeof(F64)))
+  {
+    elevations = (F64*)malloc(sizeof(F64) * (size_t)number_cells);
+  }
+
   // skip leading spaces
   line_curr = 0;
   while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
 
-  for (row = 0; row < nrows; row++)
+  for (cell = 0; cell < number_cells; cell++)
   {
-    for (col = 0; col < ncols; col++)
+    if (!read_elevation(elevation)) break;
+    if (elevations) elevations[cell] = elevation;
+    // should we use the raster
+    if (elevation != nodata)
     {
-      if (line[line_curr] == '\0')
-      {
-        if (!fgets(line, line_size, file))
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        }
-
-        // special handling for European numbers
-
-        if (comma_not_point)
-        {
-          I32 i, len = (I32)strlen(line);
-          for (i = 0; i < len; i++)
-          {
-            if (line[i] == ',') line[i] = '.';
-          }
-        }
-
-        // skip leading spaces
-        line_curr = 0;
-        while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
-      }
-      // get elevation value
-      sscanf_las(&(line[line_curr]), "%lf", &elevation);
-      // skip parsed number
-      while ((line[line_curr] != '\0') && (line[line_curr] > ' ')) line_curr++;
-      // skip following spaces
-      while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
-      // should we use the raster
-      if (elevation != nodata)
-      {
-        npoints++;
-        if (header.max_z < elevation) header.max_z = elevation;
-        if (header.min_z > elevation) header.min_z = elevation;
-      }
+      npoints++;
+      if (header.max_z < elevation) header.max_z = elevation;
+      if (header.min_z > elevation) header.min_z = elevation;
     }
   }
+  number_elevations = cell;
 
   // close the ASC file
 
@@ -380,45 +359,58 @@ BOOL LASreaderASC::seek(const I64 p_index)
   return FALSE;
 }
 
-BOOL LASreaderASC::read_point_default()
+// parses the next elevation from the current line and fetches the next non-empty line once the current
+// one is used up. a value that is not a number counts as no data. returns FALSE at the end of the file
+BOOL LASreaderASC::read_elevation(F64& elevation)
 {
-  F64 elevation;
-  while (p_count < npoints)
+  while (line[line_curr] == '\0')
   {
-    if (line[line_curr] == '\0')
-    {
-      if (!fgets(line, line_size, file))
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        npoints = p_count;
-        return FALSE;
-      }
+    if (!fgets(line, line_size, file)) return FALSE;
 
-      // special handling for European numbers
+    // special handling for European numbers
 
-      if (comma_not_point)
+    if (comma_not_point)
+    {
+      I32 i, len = (I32)strlen(line);
+      for (i = 0; i < len; i++)
       {
-        I32 i, len = (I32)strlen(line);
-        for (i = 0; i < len; i++)
-        {
-          if (line[i] == ',') line[i] = '.';
-        }
+        if (line[i] == ',') line[i] = '.';
       }
-      line_curr = 0;
-      // skip leading spaces
-      while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
     }
+    line_curr = 0;
+    // skip leading spaces
+    while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
+  }
+  // get elevation value
+  const CHAR* number = &(line[line_curr]);
+  const CHAR* end;
+  elevation = strtod_las(number, &end);
+  if (end == number) elevation = nodata;
+  // skip parsed number
+  while ((line[line_curr] != '\0') && (line[line_curr] > ' ')) line_curr++;
+  // skip following spaces
+  while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
+  return TRUE;
+}
+
+BOOL LASreaderASC::read_point_default()
+{
+  F64 elevation;
+  while (p_count < npoints)
+  {
+    I64 cell = (I64)row * ncols + col;
+    if (elevations ? (cell >= number_elevations) : !read_elevation(elevation))
+    {
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
+      npoints = p_count;
+      return FALSE;
+    }
+    if (elevations) elevation = elevations[cell];
     if (col == ncols)
     {
       col = 0;
       row++;
     }
-    // get elevation value
-    sscanf_las(&(line[line_curr]), "%lf", &elevation);
-    // skip parsed number
-    while ((line[line_curr] != '\0') && (line[line_curr] > ' ')) line_curr++;
-    // skip following spaces
-    while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
     // should we use the raster
     if (elevation != nodata)
     {
@@ -524,6 +516,14 @@ BOOL LASreaderASC::reopen(const CHAR* file_name)
     return FALSE;
   }
 
+  col = 0;
+  row = 0;
+  p_count = 0;
+
+  // the parsed rasters are still in memory
+
+  if (elevations) return TRUE;
+
   file = fopen_compressed(file_name, "r", &piped);
   if (file == 0)
   {
@@ -555,10 +555,6 @@ BOOL LASreaderASC::reopen(const CHAR* file_name)
     }
   }
 
-  col = 0;
-  row = 0;
-  p_count = 0;
-
   // skip leading spaces
   line_curr = 0;
   while ((line[line_curr] != '\0') && (line[line_curr] <= ' ')) line_curr++;
@@ -578,6 +574,12 @@ void LASreaderASC::clean()
     free(line);
     line = 0;
   }
+  if (elevations)
+  {
+    free(elevations);
+    elevations = 0;
+  }
+  number_elevations = 0;
   header_lines = 0;
   line_size = 0;
   line_curr = 0;
@@ -599,6 +601,7 @@ LASreaderASC::LASreaderASC(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
   line = 0;
+  elevations = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
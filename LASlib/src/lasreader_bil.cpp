@@ -33,6 +33,7 @@
 #include "lasmessage.hpp"
 #include "lasvlrpayload.hpp"
 
+#include <limits>
 #include <stdlib.h>
 #include <string.h>
 
@@ -40,6 +41,26 @@
 #include <windows.h>
 #endif
 
+// counts the elevations that are not 'nodata' and widens the z range by them. the loop has no
+// branches so that the compiler can vectorize it
+static I64 summarize_elevations(const F32* elevations, const I32 count, const F32 nodata, F64& min_z, F64& max_z)
+{
+  F32 lowest = std::numeric_limits<F32>::infinity();
+  F32 highest = -std::numeric_limits<F32>::infinity();
+  I32 valid = 0;
+  for (I32 i = 0; i < count; i++)
+  {
+    F32 elevation = elevations[i];
+    I32 use = (elevation != nodata);
+    valid += use;
+    lowest = ((use & (elevation < lowest)) ? elevation : lowest);
+    highest = ((use & (elevation > highest)) ? elevation : highest);
+  }
+  if (min_z > lowest) min_z = lowest;
+  if (max_z < highest) max_z = highest;
+  return valid;
+}
+
 BOOL LASreaderBIL::open(const CHAR* file_name)
 {
   if (file_name == 0)
@@ -146,167 +167,20 @@ BOOL LASreaderBIL::open(const CHAR* file_name)
   header.min_z = F64_MAX;
   header.max_z = F64_MIN;
 
-  // init the bounding box z and count the rasters
-
-  F32 elevation = 0;
-  npoints = 0;
+  // init the bounding box z and count the rasters row by row
 
-  if (nbits == 32)
+  if (!alloc_rows())
   {
-    if (floatpixels)
-    {
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elevation, 4, 1, file) == 1)
-          {
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      I32 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 4, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-  }
-  else if (nbits == 16)
-  {
-    if (signedpixels)
-    {
-      I16 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U16 elev;
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&elev, 2, 1, file) == 1)
-          {
-            elevation = (F32)elev;
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
+    return FALSE;
   }
-  else
+
+  npoints = 0;
+
+  for (row = 0; row < nrows; row++)
   {
-    if (signedpixels)
-    {
-      I8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
-    else
-    {
-      U8 rgb[4];
-      for (col = 0; col < ncols; col++)
-      {
-        for (row = 0; row < nrows; row++)
-        {
-          if (fread((void*)&rgb, 1, nbands, file) == (U32)nbands)
-          {
-            elevation = (F32)(rgb[0]);
-            if (elevation != nodata)
-            {
-              if (header.max_z < elevation) header.max_z = elevation;
-              if (header.min_z > elevation) header.min_z = elevation;
-              npoints++;
-            }
-          }
-          else
-          {
-            col = ncols;
-            row = nrows;
-          }
-        }
-      }
-    }
+    I32 cells = read_row();
+    npoints += summarize_elevations(row_elevations, cells, nodata, header.min_z, header.max_z);
+    if (cells < ncols) break;
   }
 
   // close the BIL file
@@ -408,7 +282,6 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
 
   CHAR line[512];
   CHAR dummy[32];
-  unsigned int dummy_size = static_cast<unsigned int>(sizeof(dummy));
   col = 0;
   row = 0;
   ncols = 0;
@@ -430,19 +303,19 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
     }
     else if (strstr(line, "ncols") || strstr(line, "NCOLS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, & ncols);
+      sscanf_las(line, "%*s %d", & ncols);
     }
     else if (strstr(line, "nrows") || strstr(line, "NROWS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, &nrows);
+      sscanf_las(line, "%*s %d", &nrows);
     }
     else if (strstr(line, "nbands") || strstr(line, "NBANDS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, &nbands);
+      sscanf_las(line, "%*s %d", &nbands);
     }
     else if (strstr(line, "nbits") || strstr(line, "NBITS"))
     {
-      sscanf_las(line, "%s %d", dummy, dummy_size, &nbits);
+      sscanf_las(line, "%*s %d", &nbits);
     }
     else if (strstr(line, "layout") || strstr(line, "LAYOUT"))
     {
@@ -462,7 +335,7 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
     else if (strstr(line, "pixeltype") || strstr(line, "PIXELTYPE"))
     {
       CHAR pixeltype[32] = {0};
-      sscanf_las(line, "%s %s", dummy, dummy_size, pixeltype);
+      sscanf_las(line, "%*s %s", pixeltype, (unsigned int)sizeof(pixeltype));
       if ((strcmp(pixeltype, "float") == 0) || (strcmp(pixeltype, "FLOAT") == 0))
       {
         floatpixels = TRUE;
@@ -478,12 +351,12 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
     }
     else if (strstr(line, "nodata") || strstr(line, "NODATA"))
     {
-      sscanf_las(line, "%s %f", dummy, dummy_size, &nodata);
+      sscanf_las(line, "%*s %f", &nodata);
     }
     else if (strstr(line, "byteorder") || strstr(line, "BYTEORDER")) // if little or big endian machine (i == intel, m == motorola)
     {
       CHAR byteorder[32] = {0};
-      sscanf_las(line, "%s %s", dummy, dummy_size, byteorder);
+      sscanf_las(line, "%*s %s", byteorder, (unsigned int)sizeof(byteorder));
       if (strcmp(byteorder, "i") && strcmp(byteorder, "I"))
       {
         LASMessage(LAS_WARNING, "byteorder '%s' not recognized by LASreader_bil", byteorder);
@@ -491,19 +364,19 @@ BOOL LASreaderBIL::read_hdr_file(const CHAR* file_name)
     }
     else if (strstr(line, "ulxmap") || strstr(line, "ULXMAP"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &ulxmap);
+      sscanf_las(line, "%*s %lf", &ulxmap);
     }
     else if (strstr(line, "ulymap") || strstr(line, "ULYMAP"))
     {
-      sscanf_las(line, "%s %lf", dummy, dummy_size, &ulymap);
+      sscanf_las(line, "%*s %lf", &ulymap);
     }
     else if (strstr(line, "xdim") || strstr(line, "XDIM"))
     {
-      sscanf_las(line, "%s %f", dummy, dummy_size, &xdim);
+      sscanf_las(line, "%*s %f", &xdim);
     }
     else if (strstr(line, "ydim") || strstr(line, "YDIM"))
     {
-      sscanf_las(line, "%s %f", dummy, dummy_size, &ydim);
+      sscanf_las(line, "%*s %f", &ydim);
     }
   }
 
@@ -660,90 +533,110 @@ BOOL LASreaderBIL::seek(const I64 p_index)
   return FALSE;
 }
 
-BOOL LASreaderBIL::read_point_default()
+BOOL LASreaderBIL::alloc_rows()
 {
-  F32 elevation;
-  while (p_count < npoints)
+  free(raw_row);
+  free(row_elevations);
+  raw_row = (U8*)malloc((size_t)ncols * get_cell_size());
+  row_elevations = (F32*)malloc(sizeof(F32) * (size_t)ncols);
+  if ((raw_row == 0) || (row_elevations == 0))
   {
-    if (col == ncols)
+    laserror("allocating rows of %d cells", ncols);
+    return FALSE;
+  }
+  row_cells = 0;
+  row_loaded = -1;
+  return TRUE;
+}
+
+I32 LASreaderBIL::read_row()
+{
+  I32 c, cells;
+  if (nbits == 32)
+  {
+    if (floatpixels)
     {
-      col = 0;
-      row++;
+      cells = (I32)fread((void*)row_elevations, 4, ncols, file);
     }
-
-    if (nbits == 32)
+    else
     {
-      if (floatpixels)
-      {
-        if (fread((void*)&elevation, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-      }
-      else
+      cells = (I32)fread((void*)raw_row, 4, ncols, file);
+      for (c = 0; c < cells; c++)
       {
         I32 elev;
-        if (fread((void*)&elev, 4, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        memcpy(&elev, raw_row + 4 * c, 4);
+        row_elevations[c] = (F32)elev;
       }
     }
-    else if (nbits == 16)
+  }
+  else if (nbits == 16)
+  {
+    cells = (I32)fread((void*)raw_row, 2, ncols, file);
+    if (signedpixels)
     {
-      if (signedpixels)
+      for (c = 0; c < cells; c++)
       {
         I16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        memcpy(&elev, raw_row + 2 * c, 2);
+        row_elevations[c] = (F32)elev;
       }
-      else
+    }
+    else
+    {
+      for (c = 0; c < cells; c++)
       {
         U16 elev;
-        if (fread((void*)&elev, 2, 1, file) != 1)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-        elevation = (F32)elev;
+        memcpy(&elev, raw_row + 2 * c, 2);
+        row_elevations[c] = (F32)elev;
       }
     }
-    else
+  }
+  else
+  {
+    // only the first of the bands is used
+    cells = (I32)fread((void*)raw_row, nbands, ncols, file);
+    if (signedpixels)
     {
-      if (signedpixels)
+      for (c = 0; c < cells; c++)
       {
-        I8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-        elevation = rgb[0];
+        row_elevations[c] = (F32)((I8)raw_row[nbands * c]);
       }
-      else
+    }
+    else
+    {
+      for (c = 0; c < cells; c++)
       {
-        U8 rgb[4];
-        if (fread((void*)rgb, 1, nbands, file) != (U32)nbands)
-        {
-          LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-          npoints = p_count;
-          return FALSE;
-        }
-        elevation = rgb[0];
+        row_elevations[c] = (F32)raw_row[nbands * c];
       }
     }
+  }
+  return cells;
+}
+
+BOOL LASreaderBIL::read_point_default()
+{
+  while (p_count < npoints)
+  {
+    if (col == ncols)
+    {
+      col = 0;
+      row++;
+    }
+
+    if (row != row_loaded)
+    {
+      row_cells = read_row();
+      row_loaded = row;
+    }
+
+    if (col >= row_cells)
+    {
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
+      npoints = p_count;
+      return FALSE;
+    }
+
+    F32 elevation = row_elevations[col];
 
     if (elevation != nodata)
     {
@@ -858,6 +751,8 @@ BOOL LASreaderBIL::reopen(const CHAR* file_name)
 
   col = 0;
   row = 0;
+  row_cells = 0;
+  row_loaded = -1;
   p_count = 0;
 
   return TRUE;
@@ -870,6 +765,12 @@ void LASreaderBIL::clean()
     fclose(file);
     file = 0;
   }
+  free(raw_row);
+  raw_row = 0;
+  free(row_elevations);
+  row_elevations = 0;
+  row_cells = 0;
+  row_loaded = -1;
   col = 0;
   row = 0;
   ncols = 0;
@@ -891,6 +792,8 @@ void LASreaderBIL::clean()
 LASreaderBIL::LASreaderBIL(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
+  raw_row = 0;
+  row_elevations = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
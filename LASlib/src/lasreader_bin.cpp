@@ -37,6 +37,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+extern "C" FILE* fopen_compressed(const char* filename, const char* mode, bool* piped);
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -87,8 +91,12 @@ BOOL LASreaderBIN::open(const char* file_name)
     return FALSE;
   }
 
-  // open file
+  // open file (*.gz, *.zip or *.zst are decompressed in-process where supported)
+#ifdef _WIN32
   file = LASfopen(file_name, "rb");
+#else
+  file = fopen_compressed(file_name, "rb", 0);
+#endif
   if (file == 0)
   {
     laserror("cannot open file '%s'", file_name);
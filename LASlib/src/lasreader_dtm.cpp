@@ -33,6 +33,34 @@
 #include "lasmessage.hpp"
 #include "lasvlrpayload.hpp"
 
+#include <limits>
+#include <stdlib.h>
+#include <string.h>
+
+// counts the elevations that are not 'nodata' and widens the z range by them. the loop has no
+// branches so that the compiler can vectorize it
+template <typename T>
+static I64 summarize_elevations(const T* elevations, const I32 count, const F32 nodata, F64& min_z, F64& max_z)
+{
+  T lowest = std::numeric_limits<T>::max();
+  T highest = std::numeric_limits<T>::lowest();
+  I32 valid = 0;
+  for (I32 i = 0; i < count; i++)
+  {
+    T elevation = elevations[i];
+    I32 use = (((F32)elevation) != nodata);
+    valid += use;
+    lowest = ((use & (elevation < lowest)) ? elevation : lowest);
+    highest = ((use & (elevation > highest)) ? elevation : highest);
+  }
+  if (valid)
+  {
+    if (min_z > lowest) min_z = lowest;
+    if (max_z < highest) max_z = highest;
+  }
+  return valid;
+}
+
 // used to map GeoTIFF codes to GCTP codes
 
 static const unsigned short PCS_NAD83_Alabama_East = 26929;
@@ -1034,110 +1062,41 @@ BOOL LASreaderDTM::open(const CHAR* file_name)
   header.min_z = F64_MAX;
   header.max_z = F64_MIN;
 
-  // init the bounding box z and count the rasters
+  // init the bounding box z and count the rasters column by column
+
+  if ((data_type < 0) || (data_type > 3))
+  {
+    laserror("unknown data type %d", (I32)data_type);
+    return FALSE;
+  }
+
+  if (!alloc_columns())
+  {
+    return FALSE;
+  }
 
   npoints = 0;
 
-  if (data_type == 2) // F32
+  for (col = 0; col < ncols; col++)
   {
-    F32 elevation = 0;
-    for (row = 0; row < nrows; row++)
+    I32 cells = (I32)fread((void*)raw_column, get_cell_size(), nrows, file);
+    if (data_type == 2) // F32
     {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (elevation != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
+      npoints += summarize_elevations((const F32*)raw_column, cells, nodata, header.min_z, header.max_z);
     }
-  }
-  else if (data_type == 1) // I32
-  {
-    I32 elevation = 0;
-    for (row = 0; row < nrows; row++)
+    else if (data_type == 1) // I32
     {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 4, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
+      npoints += summarize_elevations((const I32*)raw_column, cells, nodata, header.min_z, header.max_z);
     }
-  }
-  else if (data_type == 0) // I16
-  {
-    I16 elevation;
-    for (row = 0; row < nrows; row++)
+    else if (data_type == 0) // I16
     {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 2, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
+      npoints += summarize_elevations((const I16*)raw_column, cells, nodata, header.min_z, header.max_z);
     }
-  }
-  else if (data_type == 3) // F64
-  {
-    F64 elevation;
-    for (row = 0; row < nrows; row++)
+    else // F64
     {
-      for (col = 0; col < ncols; col++)
-      {
-        if (fread((void*)&elevation, 8, 1, file) == 1)
-        {
-          if (((F32)elevation) != nodata)
-          {
-            if (header.max_z < elevation) header.max_z = elevation;
-            if (header.min_z > elevation) header.min_z = elevation;
-            npoints++;
-          }
-        }
-        else
-        {
-          col = ncols;
-          row = nrows;
-        }
-      }
+      npoints += summarize_elevations((const F64*)raw_column, cells, nodata, header.min_z, header.max_z);
     }
-  }
-  else
-  {
-    laserror("unknown data type %d", (I32)data_type);
-    return FALSE;
+    if (cells < nrows) break;
   }
 
   // update the header point count
@@ -1232,56 +1191,21 @@ BOOL LASreaderDTM::read_point_default()
       col++;
     }
 
-    F32 elevation;
-
-    if (data_type == 2) // F32
+    if (col != column_loaded)
     {
-      if (fread((void*)&elevation, 4, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        npoints = p_count;
-        return FALSE;
-      }
-    }
-    else if (data_type == 1) // I32
-    {
-      I32 elev;
-      if (fread((void*)&elev, 4, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        npoints = p_count;
-        return FALSE;
-      }
-      elevation = (F32)elev;
-    }
-    else if (data_type == 0) // I16
-    {
-      I16 elev;
-      if (fread((void*)&elev, 2, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        npoints = p_count;
-        return FALSE;
-      }
-      elevation = (F32)elev;
-    }
-    else if (data_type == 3) // F64
-    {
-      F64 elev;
-      if (fread((void*)&elev, 8, 1, file) != 1)
-      {
-        LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
-        npoints = p_count;
-        return FALSE;
-      }
-      elevation = (F32)elev;
+      column_cells = read_column();
+      column_loaded = col;
     }
-    else
+
+    if (row >= column_cells)
     {
-      laserror("unknown data type %d", (I32)data_type);
+      LASMessage(LAS_WARNING, "end-of-file after %d of %d rows and %d of %d cols. read %lld points", row, nrows, col, ncols, p_count);
+      npoints = p_count;
       return FALSE;
     }
 
+    F32 elevation = column_elevations[row];
+
     if (elevation != nodata)
     {
       F64 x = ll_x + col* xdim;
@@ -1345,6 +1269,44 @@ BOOL LASreaderDTM::read_point_default()
   return FALSE;
 }
 
+BOOL LASreaderDTM::alloc_columns()
+{
+  free(raw_column);
+  free(column_elevations);
+  raw_column = (U8*)malloc((size_t)nrows * get_cell_size());
+  column_elevations = (F32*)malloc(sizeof(F32) * (size_t)nrows);
+  if ((raw_column == 0) || (column_elevations == 0))
+  {
+    laserror("allocating columns of %d cells", nrows);
+    return FALSE;
+  }
+  column_cells = 0;
+  column_loaded = -1;
+  return TRUE;
+}
+
+I32 LASreaderDTM::read_column()
+{
+  I32 r, cells = (I32)fread((void*)raw_column, get_cell_size(), nrows, file);
+  if (data_type == 2) // F32
+  {
+    memcpy(column_elevations, raw_column, sizeof(F32) * (size_t)cells);
+  }
+  else if (data_type == 1) // I32
+  {
+    for (r = 0; r < cells; r++) column_elevations[r] = (F32)((const I32*)raw_column)[r];
+  }
+  else if (data_type == 0) // I16
+  {
+    for (r = 0; r < cells; r++) column_elevations[r] = (F32)((const I16*)raw_column)[r];
+  }
+  else // F64
+  {
+    for (r = 0; r < cells; r++) column_elevations[r] = (F32)((const F64*)raw_column)[r];
+  }
+  return cells;
+}
+
 ByteStreamIn* LASreaderDTM::get_stream() const
 {
   return 0;
@@ -1404,6 +1366,8 @@ BOOL LASreaderDTM::reopen(const CHAR* file_name)
 
   col = 0;
   row = 0;
+  column_cells = 0;
+  column_loaded = -1;
   p_count = 0;
 
   // skip 200 bytes of header
@@ -1424,6 +1388,12 @@ void LASreaderDTM::clean()
     fclose(file);
     file = 0;
   }
+  free(raw_column);
+  raw_column = 0;
+  free(column_elevations);
+  column_elevations = 0;
+  column_cells = 0;
+  column_loaded = -1;
   col = 0;
   row = 0;
   ncols = 0;
@@ -1442,6 +1412,8 @@ void LASreaderDTM::clean()
 LASreaderDTM::LASreaderDTM(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
+  raw_column = 0;
+  column_elevations = 0;
   scale_factor = 0;
   offset = 0;
   orig_x_offset = 0.0;
@@ -34,6 +34,7 @@
 #include "bytestreamin.hpp"
 #include "bytestreamin_file.hpp"
 #include "bytestreamin_istream.hpp"
+#include "bytestreamin_mmap.hpp"
 #include "lasreadpoint.hpp"
 #include "lasindex.hpp"
 #include "lascopc.hpp"
@@ -70,6 +71,25 @@ BOOL LASreaderLAS::open(const char* file_name, I32 io_buffer_size, BOOL peek_onl
   }
   this->file_name = LASCopyString(file_name);
 
+  // maybe read straight from the file cache via memory mapping
+
+  if (opener && opener->get_io_mmap())
+  {
+    if (IS_LITTLE_ENDIAN())
+    {
+      ByteStreamInMapLE* in = new ByteStreamInMapLE();
+      if (in->open(file)) return open(in, peek_only, decompress_selective);
+      delete in;
+    }
+    else
+    {
+      ByteStreamInMapBE* in = new ByteStreamInMapBE();
+      if (in->open(file)) return open(in, peek_only, decompress_selective);
+      delete in;
+    }
+    LASMessage(LAS_VERBOSE, "cannot memory map '%s'. reading it via buffered IO", file_name);
+  }
+
   if (setvbuf(file, NULL, _IOFBF, io_buffer_size) != 0)
   {
     LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", io_buffer_size);
@@ -389,7 +409,7 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
   npoints = (header.number_of_point_records ? header.number_of_point_records : header.extended_number_of_point_records);
   p_count = 0;
 
-  if (peek_only)
+  if (peek_only && !peek_metadata)
   {
     // at least repair point type in incomplete header (no VLRs, no LASzip, no LAStiling)
     header.point_data_format &= 127;
@@ -1367,6 +1387,21 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
     }
   }
 
+  // when only peeking at the metadata we describe the points and the chunks but do not read them
+
+  if (peek_only)
+  {
+    if (header.laszip)
+    {
+      if (!point.init(&header, header.laszip->num_items, header.laszip->items, &header)) return FALSE;
+    }
+    else
+    {
+      if (!point.init(&header, header.point_data_format, header.point_data_record_length, &header)) return FALSE;
+    }
+    return read_chunk_statistics();
+  }
+
   // create the point reader
   reader = new LASreadPoint(decompress_selective);
 
@@ -1430,6 +1465,13 @@ BOOL LASreaderLAS::open(ByteStreamIn* stream, BOOL peek_only, U32 decompress_sel
 
   if (!reader->init(stream)) return FALSE;
 
+  // maybe decompress the chunks of the LAZ file with several threads
+
+  if (opener && (opener->get_decompress_threads() > 1))
+  {
+    reader->set_threads(opener->get_decompress_threads(), npoints);
+  }
+
   checked_end = FALSE;
 
   return TRUE;
@@ -1462,6 +1504,8 @@ BOOL LASreaderLAS::seek(const I64 p_index)
 
 BOOL LASreaderLAS::read_point_default()
 {
+  if (reader == 0) return FALSE;
+
   if (p_count < npoints)
   {
     if (reader->read(point.point) == FALSE)
@@ -1525,6 +1569,75 @@ BOOL LASreaderLAS::read_point_default()
   return FALSE;
 }
 
+BOOL LASreaderLAS::read_chunk_statistics()
+{
+  chunk_statistics.clean();
+
+  // only chunked LAZ has a chunk table and we must be able to seek to it
+
+  if ((header.laszip == 0) || (header.laszip->compressor == LASZIP_COMPRESSOR_NONE) || (header.laszip->compressor == LASZIP_COMPRESSOR_POINTWISE) || !stream->isSeekable())
+  {
+    return TRUE;
+  }
+
+  // the stream is at the start of the points (the header no longer counts the removed laszip VLR)
+
+  LASreadPoint chunk_table;
+  if (!chunk_table.peek_chunk_table(stream, header.laszip))
+  {
+    if (chunk_table.error())
+    {
+      LASMessage(LAS_WARNING, "'%s' for '%s'", chunk_table.error(), file_name);
+    }
+    else
+    {
+      LASMessage(LAS_WARNING, "cannot read chunk table for '%s'", file_name);
+    }
+    return TRUE;
+  }
+  if (chunk_table.warning())
+  {
+    LASMessage(LAS_WARNING, "'%s' for '%s'", chunk_table.warning(), file_name);
+  }
+
+  U32 number_chunks = chunk_table.get_number_chunks();
+  if (number_chunks == 0) return TRUE;
+
+  const I64* chunk_starts = chunk_table.get_chunk_starts();
+  const U32* chunk_totals = chunk_table.get_chunk_totals();
+
+  chunk_statistics.number_chunks = number_chunks;
+  chunk_statistics.variable_size = (chunk_totals != 0);
+  chunk_statistics.start_of_chunks = chunk_starts[0];
+  chunk_statistics.start_of_chunk_table = chunk_starts[number_chunks];
+  chunk_statistics.min_points = I64_MAX;
+  chunk_statistics.min_bytes = I64_MAX;
+
+  U32 i;
+  I64 remaining = npoints;
+  for (i = 0; i < number_chunks; i++)
+  {
+    I64 points;
+    if (chunk_totals)
+    {
+      points = chunk_totals[i+1] - chunk_totals[i];
+    }
+    else
+    {
+      // with fixed-size chunking only the last chunk may have fewer points
+      points = (remaining < header.laszip->chunk_size ? remaining : header.laszip->chunk_size);
+      remaining -= points;
+    }
+    if (points < chunk_statistics.min_points) chunk_statistics.min_points = points;
+    if (points > chunk_statistics.max_points) chunk_statistics.max_points = points;
+    I64 bytes = chunk_starts[i+1] - chunk_starts[i];
+    if (bytes < chunk_statistics.min_bytes) chunk_statistics.min_bytes = bytes;
+    if (bytes > chunk_statistics.max_bytes) chunk_statistics.max_bytes = bytes;
+  }
+
+  return TRUE;
+}
+
 ByteStreamIn* LASreaderLAS::get_stream() const
 {
   return stream;
@@ -1569,6 +1682,7 @@ LASreaderLAS::LASreaderLAS(LASreadOpener* opener) : LASreader(opener)
   delete_stream = TRUE;
   reader = 0;
   keep_copc = FALSE;
+  peek_metadata = FALSE;
   checked_end = FALSE;
 }
 
@@ -31,17 +31,194 @@
 #include "lasreader_txt.hpp"
 
 #include "lasmessage.hpp"
+#include "laspointbatch.hpp"
+#include "lasthreadpool.hpp"
 #include "lastransform.hpp"
 
 #include <stdlib.h>
 #include <string.h>
 
+#include <deque>
+#include <vector>
+
 #ifdef _WIN32
 #include <windows.h>
 #endif
 
 extern "C" FILE * fopen_compressed(const char* filename, const char* mode, bool* piped);
 
+// the lines are split in place from blocks that are read with a single fread(). the newline that
+// terminates the current line is overwritten with a zero and put back before the next line is read
+
+#define LAS_READER_TXT_BLOCK_SIZE (16 * LAS_TOOLS_IO_IBUFFER_SIZE)
+
+// with '-parse_threads' all complete lines in the block are copied into a range that one of the threads
+// parses into a batch of points while the next ranges are read. the points are handed out range by range
+// so that they arrive in the same order as when the lines are parsed one by one
+
+class LASreaderTXTrange
+{
+public:
+  std::vector<CHAR> text;
+  LASpointBatch batch;
+  std::vector<F64> coordinates;
+  U32 next;
+  std::future<void> parsed;
+};
+
+class LASreaderTXTranges
+{
+public:
+  LASthreadPool pool;
+  LASpoint start;    // every range is parsed starting from the first point of the file
+  std::deque<LASreaderTXTrange*> parsing;
+  std::vector<LASreaderTXTrange*> idle;
+  LASreaderTXTrange* current;
+  size_t max_parsing;
+  BOOL end_of_file;
+  LASreaderTXTranges(const U32 threads) : pool(threads)
+  {
+    current = 0;
+    max_parsing = 2 * (size_t)threads;
+    end_of_file = FALSE;
+  };
+  ~LASreaderTXTranges()
+  {
+    size_t i;
+    for (i = 0; i < parsing.size(); i++)
+    {
+      parsing[i]->parsed.wait();
+      delete parsing[i];
+    }
+    for (i = 0; i < idle.size(); i++)
+    {
+      delete idle[i];
+    }
+    if (current) delete current;
+  };
+};
+
+// when the header is populated the lines are parsed only once. the points are kept as complete records
+// plus their coordinates in chunks of up to 64K points, first in memory and then in a temporary file,
+// until all points have been seen and the header is known
+
+#define LAS_READER_TXT_SPILL_MEMORY ((size_t)512 * 1024 * 1024)
+
+class LASreaderTXTspill
+{
+public:
+  LASpointBatch batch;    // the chunk that is filled or handed out
+  std::vector<F64> coordinates;
+  U32 next;
+  I64 points_in_file;
+  BOOL init(const LASpoint* point)
+  {
+    coordinates.reserve(3 * (size_t)LAS_POINT_BATCH_DEFAULT_SIZE);
+    return batch.init(point, LAS_POINT_BATCH_DEFAULT_SIZE, TRUE);
+  };
+  BOOL add(const LASpoint* point)
+  {
+    if (batch.is_full() && !store()) return FALSE;
+    batch.add(point);
+    coordinates.push_back(point->coordinates[0]);
+    coordinates.push_back(point->coordinates[1]);
+    coordinates.push_back(point->coordinates[2]);
+    return TRUE;
+  };
+  BOOL store()
+  {
+    size_t record_bytes = (size_t)batch.count * batch.get_record_size();
+    size_t coordinate_bytes = sizeof(F64) * coordinates.size();
+    U8* chunk = 0;
+    if ((file == 0) && (memory + record_bytes + coordinate_bytes <= LAS_READER_TXT_SPILL_MEMORY))
+    {
+      chunk = (U8*)malloc(record_bytes + coordinate_bytes);
+    }
+    if (chunk)
+    {
+      memcpy(chunk, batch.records, record_bytes);
+      memcpy(chunk + record_bytes, coordinates.data(), coordinate_bytes);
+      memory += record_bytes + coordinate_bytes;
+    }
+    else
+    {
+      // once a chunk went into the temporary file all following chunks go there too
+      if (file == 0)
+      {
+        file = tmpfile();
+        if (file == 0)
+        {
+          laserror("cannot create temporary file for populating the header");
+          return FALSE;
+        }
+      }
+      if ((fwrite(batch.records, 1, record_bytes, file) != record_bytes) || (fwrite(coordinates.data(), 1, coordinate_bytes, file) != coordinate_bytes))
+      {
+        laserror("writing %u points to temporary file for populating the header", batch.count);
+        return FALSE;
+      }
+      points_in_file += batch.count;
+    }
+    chunks.push_back(chunk);
+    counts.push_back(batch.count);
+    batch.clear();
+    coordinates.clear();
+    return TRUE;
+  };
+  BOOL load()
+  {
+    if (next_chunk == chunks.size()) return FALSE;
+    U32 count = counts[next_chunk];
+    size_t record_bytes = (size_t)count * batch.get_record_size();
+    size_t coordinate_bytes = sizeof(F64) * 3 * (size_t)count;
+    coordinates.resize(3 * (size_t)count);
+    if (chunks[next_chunk])
+    {
+      memcpy(batch.records, chunks[next_chunk], record_bytes);
+      memcpy(coordinates.data(), chunks[next_chunk] + record_bytes, coordinate_bytes);
+    }
+    else if ((fread(batch.records, 1, record_bytes, file) != record_bytes) || (fread(coordinates.data(), 1, coordinate_bytes, file) != coordinate_bytes))
+    {
+      laserror("reading %u points from temporary file for populating the header", count);
+      return FALSE;
+    }
+    batch.count = count;
+    next = 0;
+    next_chunk++;
+    return TRUE;
+  };
+  void rewind()
+  {
+    batch.clear();
+    next = 0;
+    next_chunk = 0;
+    if (file) fseek(file, 0, SEEK_SET);
+  };
+  LASreaderTXTspill()
+  {
+    next = 0;
+    points_in_file = 0;
+    file = 0;
+    memory = 0;
+    next_chunk = 0;
+  };
+  ~LASreaderTXTspill()
+  {
+    size_t i;
+    for (i = 0; i < chunks.size(); i++)
+    {
+      if (chunks[i]) free(chunks[i]);
+    }
+    if (file) fclose(file);
+  };
+private:
+  std::vector<U8*> chunks;    // zero for the chunks in the temporary file
+  std::vector<U32> counts;
+  FILE* file;
+  size_t memory;
+  size_t next_chunk;
+};
+
 BOOL LASreaderTXT::open(const CHAR* file_name, U8 point_type, const CHAR* parse_string, I32 skip_lines, BOOL populate_header)
 {
   if (file_name == 0)
@@ -81,6 +258,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
   header.clean();
   // set the file pointer
   this->file = file;
+  reset_lines();
   // add attributes in extra bytes
   if (number_attributes)
   {
@@ -117,10 +295,10 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
     // User-input parse string has the precedence
     this->parse_string = LASCopyString(parse_string);
     // User provided a parse_string but the file may contain the column description
-    for (i = 0; i < this->skip_lines; i++) fgets(line, 512, file);
+    for (i = 0; i < this->skip_lines; i++) read_line();
     char* auto_parse_string = 0;
     has_column_description = parse_column_description(&auto_parse_string);
-    fseek(file, 0, SEEK_SET);
+    rewind_lines();
     if (has_column_description && auto_parse_string == 0)
     {
       return FALSE;
@@ -134,9 +312,9 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
   else
   {
     // User did not provide a parse_string the file may contain the column description
-    for (i = 0; i < this->skip_lines; i++) fgets(line, 512, file);
+    for (i = 0; i < this->skip_lines; i++) read_line();
     has_column_description = parse_column_description(&this->parse_string);
-    fseek(file, 0, SEEK_SET);
+    rewind_lines();
     // Column description found but nothing parsed.
     if (has_column_description && this->parse_string == 0) return FALSE;
   }
@@ -286,371 +464,6 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
 
   npoints = 0;
 
-  // should we perform an extra pass to fully populate the header
-
-  if (populate_header && file_name)
-  {
-    // create a cheaper parse string that only looks for 'x' 'y' 'z' 'r' and attributes in extra bytes
-
-    char* parse_less;
-    if (this->parse_string == 0)
-    {
-      parse_less = LASCopyString("xyz");
-    }
-    else
-    {
-      parse_less = LASCopyString(this->parse_string);
-      for (i = 0; i < (int)strlen(parse_less); i++)
-      {
-        if (parse_less[i] != 'x' && parse_less[i] != 'y' && parse_less[i] != 'z' && parse_less[i] != 'r' && (parse_less[i] < '0' || parse_less[i] > '0'))
-        {
-          parse_less[i] = 's';
-        }
-      }
-      do
-      {
-        parse_less[i] = '\0';
-        i--;
-      } while (parse_less[i] == 's');
-    }
-
-    // skip lines if we have to
-
-    for (i = 0; i < this->skip_lines; i++) fgets(line, 512, file);
-    if (has_column_description) fgets(line, 512, file);
-
-    if (ipts)
-    {
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lld", &npoints) != 1)
-        {
-          laserror("parsing number of points for '-itps'");
-          return FALSE;
-        }
-        LASMessage(LAS_INFO, "PTS header states %lld points. ignoring ...", npoints);
-        npoints = 0;
-      }
-      else
-      {
-        laserror("reading PTS header for '-itps'");
-        return FALSE;
-      }
-    }
-    else if (iptx || iptx_transform)
-    {
-      I32 ncols;
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%d", &ncols) != 1)
-        {
-          laserror("parsing number of cols");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with number of cols");
-        return FALSE;
-      }
-      I32 nrows;
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%d", &nrows) != 1)
-        {
-          laserror("parsing number of rows");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with number of rows");
-        return FALSE;
-      }
-      npoints = (I64)ncols * (I64)nrows;
-      LASMessage(LAS_INFO, "PTX header states %d cols by %d rows aka %lld points. ignoring ...", ncols, nrows, npoints);
-      F64 ptx_scan_pos[3];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf", &(ptx_scan_pos[0]), &(ptx_scan_pos[1]), &(ptx_scan_pos[2])) != 3)
-        {
-          laserror("parsing ptx_scan_pos");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with ptx_scan_pos");
-        return FALSE;
-      }
-      F64 ptx_scan_axis_x[3];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_x[0]), &(ptx_scan_axis_x[1]), &(ptx_scan_axis_x[2])) != 3)
-        {
-          laserror("parsing rotation row 0");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with rotation row 0");
-        return FALSE;
-      }
-      F64 ptx_scan_axis_y[3];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_y[0]), &(ptx_scan_axis_y[1]), &(ptx_scan_axis_y[2])) != 3)
-        {
-          laserror("parsing rotation row 1");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with rotation row 1");
-        return FALSE;
-      }
-      F64 ptx_scan_axis_z[3];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_z[0]), &(ptx_scan_axis_z[1]), &(ptx_scan_axis_z[2])) != 3)
-        {
-          laserror("parsing rotation row 2");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with rotation row 2");
-        return FALSE;
-      }
-      F64 ptx_matrix_row_0[4];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_0[0]), &(ptx_matrix_row_0[1]), &(ptx_matrix_row_0[2]), &(ptx_matrix_row_0[3])) != 4)
-        {
-          laserror("parsing transformation row 0");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with transformation row 0");
-        return FALSE;
-      }
-      F64 ptx_matrix_row_1[4];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_1[0]), &(ptx_matrix_row_1[1]), &(ptx_matrix_row_1[2]), &(ptx_matrix_row_1[3])) != 4)
-        {
-          laserror("parsing transformation row 1");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with transformation row 1");
-        return FALSE;
-      }
-      F64 ptx_matrix_row_2[4];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_2[0]), &(ptx_matrix_row_2[1]), &(ptx_matrix_row_2[2]), &(ptx_matrix_row_2[3])) != 4)
-        {
-          laserror("parsing transformation row 2");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with transformation row 2");
-        return FALSE;
-      }
-      F64 ptx_matrix_row_3[4];
-      if (fgets(line, 512, file))
-      {
-        if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_3[0]), &(ptx_matrix_row_3[1]), &(ptx_matrix_row_3[2]), &(ptx_matrix_row_3[3])) != 4)
-        {
-          laserror("parsing transformation row 3");
-          return FALSE;
-        }
-      }
-      else
-      {
-        laserror("reading line with transformation row 3");
-        return FALSE;
-      }
-      npoints = 0;
-    }
-
-    // read the first line
-
-    while (fgets(line, 512, file))
-    {
-      if (parse(parse_less))
-      {
-        // mark that we found the first point
-        npoints++;
-        // we can stop this loop
-        break;
-      }
-      else
-      {
-        line[strlen(line) - 1] = '\0';
-        LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, parse_less);
-      }
-    }
-
-    // did we manage to parse a line
-
-    if (npoints == 0)
-    {
-      laserror("could not parse any lines with '%s'", parse_less);
-      fclose(file);
-      file = 0;
-      free(parse_less);
-      return FALSE;
-    }
-
-    // init the bounding box
-
-    header.min_x = header.max_x = point.coordinates[0];
-    header.min_y = header.max_y = point.coordinates[1];
-    header.min_z = header.max_z = point.coordinates[2];
-
-    // create return histogram
-
-    if (point.extended_point_type)
-    {
-      if (point.extended_return_number >= 1 && point.extended_return_number <= 15) header.extended_number_of_points_by_return[point.extended_return_number - 1]++;
-    }
-    else
-    {
-      if (point.return_number >= 1 && point.return_number <= 7) header.extended_number_of_points_by_return[point.return_number - 1]++;
-    }
-
-    // init the min and max of attributes in extra bytes
-
-    if (number_attributes)
-    {
-      for (i = 0; i < number_attributes; i++)
-      {
-        header.attributes[i].set_min(point.extra_bytes + attribute_starts[i]);
-        header.attributes[i].set_max(point.extra_bytes + attribute_starts[i]);
-      }
-    }
-
-    // loop over the remaining lines
-
-    while (fgets(line, 512, file))
-    {
-      if (parse(parse_less))
-      {
-        // count points
-        npoints++;
-        // create return histogram
-        if (point.extended_point_type)
-        {
-          if (point.extended_return_number >= 1 && point.extended_return_number <= 15) header.extended_number_of_points_by_return[point.extended_return_number - 1]++;
-        }
-        else
-        {
-          if (point.return_number >= 1 && point.return_number <= 7) header.extended_number_of_points_by_return[point.return_number - 1]++;
-        }
-        // update bounding box
-        if (point.coordinates[0] < header.min_x) header.min_x = point.coordinates[0];
-        else if (point.coordinates[0] > header.max_x) header.max_x = point.coordinates[0];
-        if (point.coordinates[1] < header.min_y) header.min_y = point.coordinates[1];
-        else if (point.coordinates[1] > header.max_y) header.max_y = point.coordinates[1];
-        if (point.coordinates[2] < header.min_z) header.min_z = point.coordinates[2];
-        else if (point.coordinates[2] > header.max_z) header.max_z = point.coordinates[2];
-        // update the min and max of attributes in extra bytes
-        if (number_attributes)
-        {
-          for (i = 0; i < number_attributes; i++)
-          {
-            header.attributes[i].update_min(point.extra_bytes + attribute_starts[i]);
-            header.attributes[i].update_max(point.extra_bytes + attribute_starts[i]);
-          }
-        }
-      }
-      else
-      {
-        line[strlen(line) - 1] = '\0';
-        LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, parse_less);
-      }
-    }
-
-    LASMessage(LAS_INFO, "counted %lld points in populate pass.", npoints);
-
-    if (point.extended_point_type || (npoints > U32_MAX) || header.extended_number_of_points_by_return[5] || header.extended_number_of_points_by_return[6] || header.extended_number_of_points_by_return[7] || header.extended_number_of_points_by_return[8] || header.extended_number_of_points_by_return[9] || header.extended_number_of_points_by_return[10] || header.extended_number_of_points_by_return[11] || header.extended_number_of_points_by_return[12] || header.extended_number_of_points_by_return[13] || header.extended_number_of_points_by_return[14])
-    {
-      header.version_minor = 4;
-      header.header_size = 375;
-      header.offset_to_point_data = 375;
-      header.number_of_point_records = 0;
-      header.number_of_points_by_return[0] = 0;
-      header.number_of_points_by_return[1] = 0;
-      header.number_of_points_by_return[2] = 0;
-      header.number_of_points_by_return[3] = 0;
-      header.number_of_points_by_return[4] = 0;
-      header.extended_number_of_point_records = npoints;
-    }
-    else
-    {
-      header.version_minor = 2;
-      header.header_size = 227;
-      header.offset_to_point_data = 227;
-      header.number_of_point_records = (U32)npoints;
-      header.number_of_points_by_return[0] = (U32)header.extended_number_of_points_by_return[0];
-      header.number_of_points_by_return[1] = (U32)header.extended_number_of_points_by_return[1];
-      header.number_of_points_by_return[2] = (U32)header.extended_number_of_points_by_return[2];
-      header.number_of_points_by_return[3] = (U32)header.extended_number_of_points_by_return[3];
-      header.number_of_points_by_return[4] = (U32)header.extended_number_of_points_by_return[4];
-      header.extended_number_of_point_records = 0;
-      header.extended_number_of_points_by_return[0] = 0;
-      header.extended_number_of_points_by_return[1] = 0;
-      header.extended_number_of_points_by_return[2] = 0;
-      header.extended_number_of_points_by_return[3] = 0;
-      header.extended_number_of_points_by_return[4] = 0;
-    }
-
-    // free the parse less string
-
-    free(parse_less);
-
-    // close the input file
-
-    fclose(file);
-
-    // populate scale and offset
-
-    populate_scale_and_offset();
-
-    // populate bounding box
-
-    populate_bounding_box();
-
-    // mark that header is already populated
-
-    populated_header = TRUE;
-
-    // reopen input file for the second pass
-
-    file = fopen_compressed(file_name, "r", &piped);
-    if (file == 0)
-    {
-      laserror("could not open '%s' for second pass", file_name);
-      return FALSE;
-    }
-
-    if (setvbuf(file, NULL, _IOFBF, 10 * LAS_TOOLS_IO_IBUFFER_SIZE) != 0)
-    {
-      LASMessage(LAS_WARNING, "setvbuf() failed with buffer size %d", 10 * LAS_TOOLS_IO_IBUFFER_SIZE);
-    }
-  }
-
   if (this->parse_string == 0)
   {
     this->parse_string_unparsed = LASCopyString("xyz");
@@ -661,11 +474,11 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
 
   if (this->skip_lines)
   {
-    for (i = 0; i < this->skip_lines; i++) fgets(line, 512, file);
+    for (i = 0; i < this->skip_lines; i++) read_line();
   }
   else if (ipts)
   {
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (!populated_header)
       {
@@ -718,7 +531,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
   else if (iptx || iptx_transform)
   {
     I32 ncols;
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%d", &ncols) != 1)
       {
@@ -732,7 +545,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     I32 nrows;
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%d", &nrows) != 1)
       {
@@ -771,7 +584,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       }
     }
     F64 ptx_scan_pos[3];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf", &(ptx_scan_pos[0]), &(ptx_scan_pos[1]), &(ptx_scan_pos[2])) != 3)
       {
@@ -785,7 +598,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_scan_axis_x[3];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_x[0]), &(ptx_scan_axis_x[1]), &(ptx_scan_axis_x[2])) != 3)
       {
@@ -799,7 +612,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_scan_axis_y[3];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_y[0]), &(ptx_scan_axis_y[1]), &(ptx_scan_axis_y[2])) != 3)
       {
@@ -813,7 +626,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_scan_axis_z[3];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf", &(ptx_scan_axis_z[0]), &(ptx_scan_axis_z[1]), &(ptx_scan_axis_z[2])) != 3)
       {
@@ -827,7 +640,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_matrix_row_0[4];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_0[0]), &(ptx_matrix_row_0[1]), &(ptx_matrix_row_0[2]), &(ptx_matrix_row_0[3])) != 4)
       {
@@ -841,7 +654,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_matrix_row_1[4];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_1[0]), &(ptx_matrix_row_1[1]), &(ptx_matrix_row_1[2]), &(ptx_matrix_row_1[3])) != 4)
       {
@@ -855,7 +668,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_matrix_row_2[4];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_2[0]), &(ptx_matrix_row_2[1]), &(ptx_matrix_row_2[2]), &(ptx_matrix_row_2[3])) != 4)
       {
@@ -869,7 +682,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
       return FALSE;
     }
     F64 ptx_matrix_row_3[4];
-    if (fgets(line, 512, file))
+    if (read_line())
     {
       if (sscanf(line, "%lf %lf %lf %lf", &(ptx_matrix_row_3[0]), &(ptx_matrix_row_3[1]), &(ptx_matrix_row_3[2]), &(ptx_matrix_row_3[3])) != 4)
       {
@@ -964,7 +777,7 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
   // read the first line with full parse_string
 
   i = 0;
-  while (fgets(line, 512, file))
+  while (read_line())
   {
     if (parse(this->parse_string))
     {
@@ -974,7 +787,6 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
     }
     else
     {
-      line[strlen(line) - 1] = '\0';
       LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, this->parse_string_unparsed);
     }
   }
@@ -1015,6 +827,23 @@ BOOL LASreaderTXT::open(FILE* file, const CHAR* file_name, U8 point_type, const
     populate_scale_and_offset();
   }
 
+  start_ranges();
+
+  // parse all points once to fully populate the header
+
+  if (populate_header)
+  {
+    if (!spill_points())
+    {
+      stop_spill();
+      stop_ranges();
+      fclose(this->file);
+      this->file = 0;
+      return FALSE;
+    }
+    stop_ranges();
+  }
+
   p_count = 0;
 
   return TRUE;
@@ -1135,16 +964,24 @@ BOOL LASreaderTXT::seek(const I64 p_index)
   {
     delta = (U32)(p_index - p_count);
   }
+  else if ((p_index < p_count) && spill)
+  {
+    // the spilled points are simply handed out again
+    spill->rewind();
+    p_count = 0;
+    delta = (U32)p_index;
+  }
   else if (p_index < p_count)
   {
     if (piped) return FALSE;
-    fseek(file, 0, SEEK_SET);
+    stop_ranges();
+    rewind_lines();
     // skip lines if we have to
     int i;
-    for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
+    for (i = 0; i < skip_lines; i++) read_line();
     // read the first line with full parse_string
     i = 0;
-    while (fgets(line, 512, file))
+    while (read_line())
     {
       if (parse(this->parse_string))
       {
@@ -1154,7 +991,6 @@ BOOL LASreaderTXT::seek(const I64 p_index)
       }
       else
       {
-        line[strlen(line) - 1] = '\0';
         LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, this->parse_string_unparsed);
       }
     }
@@ -1168,6 +1004,7 @@ BOOL LASreaderTXT::seek(const I64 p_index)
       this->parse_string = 0;
       return FALSE;
     }
+    start_ranges();
     delta = (U32)p_index;
   }
   while (delta)
@@ -1181,46 +1018,28 @@ BOOL LASreaderTXT::seek(const I64 p_index)
 
 BOOL LASreaderTXT::read_point_default()
 {
-  if (p_count)
+  if (spill ? !read_spilled_point() : (p_count && !read_parsed_point()))
   {
-    while (true)
+    if (populated_header)
     {
-      if (fgets(line, 512, file))
+      if (p_count != npoints)
       {
-        if (parse(parse_string))
-        {
-          break;
-        }
-        else
-        {
-          line[strlen(line) - 1] = '\0';
-          LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, parse_string_unparsed);
-        }
+        LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_count, npoints);
       }
-      else
+    }
+    else
+    {
+      if (npoints)
       {
-        if (populated_header)
+        if (p_count != npoints)
         {
-          if (p_count != npoints)
-          {
-            LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_count, npoints);
-          }
+          LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_count, npoints);
         }
-        else
-        {
-          if (npoints)
-          {
-            if (p_count != npoints)
-            {
-              LASMessage(LAS_WARNING, "end-of-file after %lld of %lld points", p_count, npoints);
-            }
-          }
-          npoints = p_count;
-          populate_bounding_box();
-        }
-        return FALSE;
       }
+      npoints = p_count;
+      populate_bounding_box();
     }
+    return FALSE;
   }
   // compute the quantized x, y, and z values
   if (opener->is_offset_adjust() == FALSE) 
@@ -1284,6 +1103,387 @@ BOOL LASreaderTXT::read_point_default()
   return TRUE;
 }
 
+BOOL LASreaderTXT::read_line()
+{
+  // put back the newline that terminated the previous line
+  if (line_end)
+  {
+    *line_end = '\n';
+    line_end = 0;
+  }
+  while (true)
+  {
+    if (block_next < block_fill)
+    {
+      CHAR* newline = (CHAR*)memchr(block + block_next, '\n', block_fill - block_next);
+      if (newline)
+      {
+        line = block + block_next;
+        line_end = newline;
+        *line_end = '\0';
+        block_next = (size_t)(newline - block) + 1;
+        return TRUE;
+      }
+    }
+    if (block_eof)
+    {
+      if (block_next == block_fill) return FALSE;
+      // the last line without a newline
+      line = block + block_next;
+      block[block_fill] = '\0';
+      block_next = block_fill;
+      return TRUE;
+    }
+    if (!fill_block()) return FALSE;
+  }
+}
+
+BOOL LASreaderTXT::fill_block()
+{
+  // move the incomplete line to the front of the block and read more
+  if (block_next)
+  {
+    memmove(block, block + block_next, block_fill - block_next);
+    block_start += block_next;
+    block_fill -= block_next;
+    block_next = 0;
+  }
+  // a line that does not fit into the block (or the first read) grows it
+  if (block_fill + 1 >= block_size)
+  {
+    size_t size = (block_size ? 2 * block_size : LAS_READER_TXT_BLOCK_SIZE);
+    CHAR* grown = (CHAR*)realloc(block, size);
+    if (grown == 0)
+    {
+      laserror("allocating %llu bytes for reading lines", (U64)size);
+      return FALSE;
+    }
+    block = grown;
+    block_size = size;
+  }
+  size_t bytes = fread(block + block_fill, 1, block_size - block_fill - 1, file);
+  if (bytes == 0) block_eof = TRUE;
+  block_fill += bytes;
+  return TRUE;
+}
+
+BOOL LASreaderTXT::read_range(LASreaderTXTrange* range)
+{
+  if (line_end)
+  {
+    *line_end = '\n';
+    line_end = 0;
+  }
+  while (true)
+  {
+    if (block_next < block_fill)
+    {
+      // the range ends after the last newline in the block or with the last line of the file
+      size_t last = block_fill;
+      while ((last > block_next) && (block[last - 1] != '\n')) last--;
+      if ((last == block_next) && block_eof) last = block_fill;
+      if (last > block_next)
+      {
+        range->text.assign(block + block_next, block + last);
+        range->text.push_back('\0');
+        block_next = last;
+        return TRUE;
+      }
+    }
+    else if (block_eof)
+    {
+      return FALSE;
+    }
+    if (!fill_block()) return FALSE;
+  }
+}
+
+void LASreaderTXT::parse_range(LASreaderTXTrange* range, const LASpoint* start) const
+{
+  LASpoint parsed;
+  parsed.init(start->quantizer, start->num_items, start->items, start->attributer);
+  parsed = *start;
+  range->batch.clear();
+  range->coordinates.clear();
+  CHAR* text = range->text.data();
+  CHAR* text_end = text + range->text.size() - 1;
+  while (text < text_end)
+  {
+    CHAR* newline = (CHAR*)memchr(text, '\n', text_end - text);
+    if (newline)
+    {
+      *newline = '\0';
+    }
+    else
+    {
+      newline = text_end;
+    }
+    if (parse(parse_string, text, &parsed))
+    {
+      if (range->batch.is_full() && !range->batch.reserve(2 * range->batch.get_capacity()))
+      {
+        return;
+      }
+      range->batch.add(&parsed);
+      range->coordinates.push_back(parsed.coordinates[0]);
+      range->coordinates.push_back(parsed.coordinates[1]);
+      range->coordinates.push_back(parsed.coordinates[2]);
+    }
+    else
+    {
+      LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", text, parse_string_unparsed);
+    }
+    text = newline + 1;
+  }
+}
+
+BOOL LASreaderTXT::read_range_point()
+{
+  LASreaderTXTrange* range = ranges->current;
+  while ((range == 0) || (range->next == range->batch.count))
+  {
+    if (range)
+    {
+      ranges->idle.push_back(range);
+      ranges->current = 0;
+    }
+    // keep the threads busy with the next ranges
+    while (!ranges->end_of_file && (ranges->parsing.size() < ranges->max_parsing))
+    {
+      LASreaderTXTrange* next;
+      if (ranges->idle.size())
+      {
+        next = ranges->idle.back();
+        ranges->idle.pop_back();
+      }
+      else
+      {
+        next = new LASreaderTXTrange;
+        if (!next->batch.init(&point, LAS_POINT_BATCH_DEFAULT_SIZE, TRUE))
+        {
+          delete next;
+          return FALSE;
+        }
+      }
+      if (!read_range(next))
+      {
+        ranges->idle.push_back(next);
+        ranges->end_of_file = TRUE;
+        break;
+      }
+      const LASpoint* start = &ranges->start;
+      next->parsed = ranges->pool.submit<void>([this, next, start]() { parse_range(next, start); });
+      ranges->parsing.push_back(next);
+    }
+    if (ranges->parsing.empty()) return FALSE;
+    range = ranges->parsing.front();
+    ranges->parsing.pop_front();
+    range->parsed.get();
+    range->next = 0;
+    ranges->current = range;
+  }
+  range->batch.get_point(range->next, &point);
+  point.coordinates[0] = range->coordinates[3 * (size_t)range->next];
+  point.coordinates[1] = range->coordinates[3 * (size_t)range->next + 1];
+  point.coordinates[2] = range->coordinates[3 * (size_t)range->next + 2];
+  range->next++;
+  return TRUE;
+}
+
+void LASreaderTXT::start_ranges()
+{
+  stop_ranges();
+  if (opener && (opener->get_parse_threads() > 1))
+  {
+    ranges = new LASreaderTXTranges(opener->get_parse_threads());
+    ranges->start.init(point.quantizer, point.num_items, point.items, point.attributer);
+    ranges->start = point;
+  }
+}
+
+void LASreaderTXT::stop_ranges()
+{
+  if (ranges)
+  {
+    delete ranges;
+    ranges = 0;
+  }
+}
+
+BOOL LASreaderTXT::read_parsed_point()
+{
+  if (ranges) return read_range_point();
+  while (read_line())
+  {
+    if (parse(parse_string))
+    {
+      return TRUE;
+    }
+    else
+    {
+      LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, parse_string_unparsed);
+    }
+  }
+  return FALSE;
+}
+
+BOOL LASreaderTXT::spill_points()
+{
+  I32 i;
+  spill = new LASreaderTXTspill;
+  if (!spill->init(&point)) return FALSE;
+
+  // the first point was already parsed by open()
+
+  npoints = 0;
+  do
+  {
+    if (!spill->add(&point)) return FALSE;
+    // count points
+    npoints++;
+    // create return histogram
+    if (point.extended_point_type)
+    {
+      if (point.extended_return_number >= 1 && point.extended_return_number <= 15) header.extended_number_of_points_by_return[point.extended_return_number - 1]++;
+    }
+    else
+    {
+      if (point.return_number >= 1 && point.return_number <= 7) header.extended_number_of_points_by_return[point.return_number - 1]++;
+    }
+    // update bounding box
+    if (point.coordinates[0] < header.min_x) header.min_x = point.coordinates[0];
+    else if (point.coordinates[0] > header.max_x) header.max_x = point.coordinates[0];
+    if (point.coordinates[1] < header.min_y) header.min_y = point.coordinates[1];
+    else if (point.coordinates[1] > header.max_y) header.max_y = point.coordinates[1];
+    if (point.coordinates[2] < header.min_z) header.min_z = point.coordinates[2];
+    else if (point.coordinates[2] > header.max_z) header.max_z = point.coordinates[2];
+    // update the min and max of attributes in extra bytes
+    if (number_attributes)
+    {
+      for (i = 0; i < number_attributes; i++)
+      {
+        header.attributes[i].update_min(point.extra_bytes + attribute_starts[i]);
+        header.attributes[i].update_max(point.extra_bytes + attribute_starts[i]);
+      }
+    }
+  } while (read_parsed_point());
+  if (spill->batch.count && !spill->store()) return FALSE;
+
+  LASMessage(LAS_INFO, "counted %lld points in populate pass.", npoints);
+  if (spill->points_in_file)
+  {
+    LASMessage(LAS_VERBOSE, "kept %lld of them in a temporary file", spill->points_in_file);
+  }
+
+  if (point.extended_point_type || (npoints > U32_MAX) || header.extended_number_of_points_by_return[5] || header.extended_number_of_points_by_return[6] || header.extended_number_of_points_by_return[7] || header.extended_number_of_points_by_return[8] || header.extended_number_of_points_by_return[9] || header.extended_number_of_points_by_return[10] || header.extended_number_of_points_by_return[11] || header.extended_number_of_points_by_return[12] || header.extended_number_of_points_by_return[13] || header.extended_number_of_points_by_return[14])
+  {
+    header.version_minor = 4;
+    header.header_size = 375;
+    header.offset_to_point_data = 375;
+    header.number_of_point_records = 0;
+    header.number_of_points_by_return[0] = 0;
+    header.number_of_points_by_return[1] = 0;
+    header.number_of_points_by_return[2] = 0;
+    header.number_of_points_by_return[3] = 0;
+    header.number_of_points_by_return[4] = 0;
+    header.extended_number_of_point_records = npoints;
+  }
+  else
+  {
+    header.version_minor = 2;
+    header.header_size = 227;
+    header.offset_to_point_data = 227;
+    header.number_of_point_records = (U32)npoints;
+    header.number_of_points_by_return[0] = (U32)header.extended_number_of_points_by_return[0];
+    header.number_of_points_by_return[1] = (U32)header.extended_number_of_points_by_return[1];
+    header.number_of_points_by_return[2] = (U32)header.extended_number_of_points_by_return[2];
+    header.number_of_points_by_return[3] = (U32)header.extended_number_of_points_by_return[3];
+    header.number_of_points_by_return[4] = (U32)header.extended_number_of_points_by_return[4];
+    header.extended_number_of_point_records = 0;
+    header.extended_number_of_points_by_return[0] = 0;
+    header.extended_number_of_points_by_return[1] = 0;
+    header.extended_number_of_points_by_return[2] = 0;
+    header.extended_number_of_points_by_return[3] = 0;
+    header.extended_number_of_points_by_return[4] = 0;
+  }
+
+  // populate scale and offset
+
+  populate_scale_and_offset();
+
+  // populate bounding box
+
+  populate_bounding_box();
+
+  // mark that header is already populated
+
+  populated_header = TRUE;
+
+  // hand out the points from the start
+
+  spill->rewind();
+  return TRUE;
+}
+
+BOOL LASreaderTXT::read_spilled_point()
+{
+  if ((spill->next == spill->batch.count) && !spill->load()) return FALSE;
+  spill->batch.get_point(spill->next, &point);
+  point.coordinates[0] = spill->coordinates[3 * (size_t)spill->next];
+  point.coordinates[1] = spill->coordinates[3 * (size_t)spill->next + 1];
+  point.coordinates[2] = spill->coordinates[3 * (size_t)spill->next + 2];
+  spill->next++;
+  return TRUE;
+}
+
+void LASreaderTXT::stop_spill()
+{
+  if (spill)
+  {
+    delete spill;
+    spill = 0;
+  }
+}
+
+void LASreaderTXT::unread_line()
+{
+  if (line_end)
+  {
+    *line_end = '\n';
+    line_end = 0;
+  }
+  block_next = (size_t)(line - block);
+}
+
+void LASreaderTXT::rewind_lines()
+{
+  if (line_end)
+  {
+    *line_end = '\n';
+    line_end = 0;
+  }
+  if (block && (block_start == 0))
+  {
+    // the start of the file is still in the block (which also works for piped input)
+    block_next = 0;
+  }
+  else
+  {
+    fseek(file, 0, SEEK_SET);
+    reset_lines();
+  }
+}
+
+void LASreaderTXT::reset_lines()
+{
+  line = 0;
+  line_end = 0;
+  block_fill = 0;
+  block_next = 0;
+  block_start = 0;
+  block_eof = FALSE;
+}
+
 ByteStreamIn* LASreaderTXT::get_stream() const
 {
   return 0;
@@ -1291,9 +1491,11 @@ ByteStreamIn* LASreaderTXT::get_stream() const
 
 void LASreaderTXT::close(BOOL close_stream)
 {
+  stop_ranges();
+  stop_spill();
   if (file)
   {
-    if (piped) while (fgets(line, 512, file));
+    if (piped) while (read_line());
     fclose(file);
     file = 0;
   }
@@ -1315,6 +1517,9 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     laserror("cannot reopen file '%s'", file_name);
     return FALSE;
   }
+  stop_ranges();
+  stop_spill();
+  reset_lines();
 
   if (setvbuf(file, NULL, _IOFBF, 10 * LAS_TOOLS_IO_IBUFFER_SIZE) != 0)
   {
@@ -1323,12 +1528,12 @@ BOOL LASreaderTXT::reopen(const char* file_name)
 
   // skip lines if we have to
 
-  for (i = 0; i < skip_lines; i++) fgets(line, 512, file);
+  for (i = 0; i < skip_lines; i++) read_line();
 
   // read the first line with full parse_string
 
   i = 0;
-  while (fgets(line, 512, file))
+  while (read_line())
   {
     if (parse(parse_string))
     {
@@ -1338,7 +1543,6 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     }
     else
     {
-      line[strlen(line) - 1] = '\0';
       LASMessage(LAS_WARNING, "cannot parse '%s' with '%s'. skipping ...", line, parse_string_unparsed);
     }
   }
@@ -1353,6 +1557,8 @@ BOOL LASreaderTXT::reopen(const char* file_name)
     return FALSE;
   }
 
+  start_ranges();
+
   p_count = 0;
 
   return TRUE;
@@ -1375,13 +1581,20 @@ void LASreaderTXT::clean()
     free(parse_string_unparsed);
     parse_string_unparsed = 0;
   }
+  stop_ranges();
+  stop_spill();
   skip_lines = 0;
   populated_header = FALSE;
+  reset_lines();
 }
 
 LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
 {
   file = 0;
+  block = 0;
+  block_size = 0;
+  ranges = 0;
+  spill = 0;
   piped = false;
   point_type = 0;
   parse_string = 0;
@@ -1408,6 +1621,11 @@ LASreaderTXT::LASreaderTXT(LASreadOpener* opener) :LASreader(opener)
 LASreaderTXT::~LASreaderTXT()
 {
   clean();
+  if (block)
+  {
+    free(block);
+    block = 0;
+  }
   if (scale_factor)
   {
     delete[] scale_factor;
@@ -1420,14 +1638,15 @@ LASreaderTXT::~LASreaderTXT()
   }
 }
 
-BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
+BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index, LASpoint* point) const
 {
   if (index >= header.number_attributes)
   {
     return FALSE;
   }
-  F64 temp_d;
-  if (sscanf(lptr, "%lf", &temp_d) != 1) return FALSE;
+  const CHAR* end;
+  F64 temp_d = strtod_las(lptr, &end);
+  if (end == lptr) return FALSE;
   if (attribute_pre_scales[index] != 1.0)
   {
     temp_d *= attribute_pre_scales[index];
@@ -1454,11 +1673,11 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     if (temp_i < U8_MIN || temp_i > U8_MAX)
     {
       LASMessage(LAS_WARNING, "attribute %d of type U8 is %d. clamped to [%d %d] range.", index, temp_i, U8_MIN, U8_MAX);
-      point.set_attribute(attribute_starts[index], U8_CLAMP(temp_i));
+      point->set_attribute(attribute_starts[index], U8_CLAMP(temp_i));
     }
     else
     {
-      point.set_attribute(attribute_starts[index], (U8)temp_i);
+      point->set_attribute(attribute_starts[index], (U8)temp_i);
     }
   }
   else if (header.attributes[index].data_type == 2)
@@ -1479,11 +1698,11 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     if (temp_i < I8_MIN || temp_i > I8_MAX)
     {
       LASMessage(LAS_WARNING, "attribute %d of type I8 is %d. clamped to [%d %d] range.", index, temp_i, I8_MIN, I8_MAX);
-      point.set_attribute(attribute_starts[index], I8_CLAMP(temp_i));
+      point->set_attribute(attribute_starts[index], I8_CLAMP(temp_i));
     }
     else
     {
-      point.set_attribute(attribute_starts[index], (I8)temp_i);
+      point->set_attribute(attribute_starts[index], (I8)temp_i);
     }
   }
   else if (header.attributes[index].data_type == 3)
@@ -1504,11 +1723,11 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     if (temp_i < U16_MIN || temp_i > U16_MAX)
     {
       LASMessage(LAS_WARNING, "attribute %d of type U16 is %d. clamped to [%d %d] range.", index, temp_i, U16_MIN, U16_MAX);
-      point.set_attribute(attribute_starts[index], U16_CLAMP(temp_i));
+      point->set_attribute(attribute_starts[index], U16_CLAMP(temp_i));
     }
     else
     {
-      point.set_attribute(attribute_starts[index], (U16)temp_i);
+      point->set_attribute(attribute_starts[index], (U16)temp_i);
     }
   }
   else if (header.attributes[index].data_type == 4)
@@ -1529,11 +1748,11 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     if (temp_i < I16_MIN || temp_i > I16_MAX)
     {
       LASMessage(LAS_WARNING, "attribute %d of type I16 is %d. clamped to [%d %d] range.", index, temp_i, I16_MIN, I16_MAX);
-      point.set_attribute(attribute_starts[index], I16_CLAMP(temp_i));
+      point->set_attribute(attribute_starts[index], I16_CLAMP(temp_i));
     }
     else
     {
-      point.set_attribute(attribute_starts[index], (I16)temp_i);
+      point->set_attribute(attribute_starts[index], (I16)temp_i);
     }
   }
   else if (header.attributes[index].data_type == 5)
@@ -1551,7 +1770,7 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     {
       temp_u = U32_QUANTIZE(temp_d);
     }
-    point.set_attribute(attribute_starts[index], temp_u);
+    point->set_attribute(attribute_starts[index], temp_u);
   }
   else if (header.attributes[index].data_type == 6)
   {
@@ -1568,16 +1787,16 @@ BOOL LASreaderTXT::parse_attribute(const char* lptr, I32 index)
     {
       temp_i = I32_QUANTIZE(temp_d);
     }
-    point.set_attribute(attribute_starts[index], temp_i);
+    point->set_attribute(attribute_starts[index], temp_i);
   }
   else if (header.attributes[index].data_type == 9)
   {
     F32 temp_f = (F32)temp_d;
-    point.set_attribute(attribute_starts[index], temp_f);
+    point->set_attribute(attribute_starts[index], temp_f);
   }
   else if (header.attributes[index].data_type == 10)
   {
-    point.set_attribute(attribute_starts[index], temp_d);
+    point->set_attribute(attribute_starts[index], temp_d);
   }
   else
   {
@@ -1643,8 +1862,7 @@ BOOL LASreaderTXT::parse_extended_flags(CHAR* parse_string)
 BOOL LASreaderTXT::parse_column_description(CHAR** parse_string)
 {
   // Read the first line
-  I32 here = ftell(file);
-  fgets(line, 512, file);
+  if (!read_line()) return FALSE;
 
   // If it contains column description
   if (strstr(line, "x") || strstr(line, "y") || strstr(line, "z") || strstr(line, "X") || strstr(line, "Y") || strstr(line, "Z"))
@@ -1796,13 +2014,13 @@ BOOL LASreaderTXT::parse_column_description(CHAR** parse_string)
   }
   else
   {
-    fseek(file, here, SEEK_SET);
+    unread_line();
     return FALSE;
   }
 }
 
 // first leading white spaces
-BOOL LASreaderTXT::skip_pre() {
+BOOL LASreaderTXT::skip_pre(const CHAR*& lptr) const {
   while (lptr[0] && (lptr[0] == ' ' || lptr[0] == ',' || lptr[0] == '\t' || lptr[0] == ';')) lptr++;
   if (lptr[0] == 0) {
     return FALSE;
@@ -1814,49 +2032,54 @@ BOOL LASreaderTXT::skip_pre() {
 }
 
 // skip remaining white spaces
-void LASreaderTXT::skip_post() {
+void LASreaderTXT::skip_post(const CHAR*& lptr) const {
   while (lptr[0] && lptr[0] != ' ' && lptr[0] != ',' && lptr[0] != '\t' && lptr[0] != ';') lptr++;
 }
 
 template<typename T>
-BOOL LASreaderTXT::parse_item_i(I32* out, const I32 imin, const I32 imax, const CHAR* context, T addon) {
+BOOL LASreaderTXT::parse_item_i(const CHAR*& lptr, I32* out, const I32 imin, const I32 imax, const CHAR* context, T addon) const {
   I32 temp_i;
-  if (!skip_pre()) return FALSE;
-  if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+  const CHAR* end;
+  if (!skip_pre(lptr)) return FALSE;
+  temp_i = strtoi_las(lptr, &end);
+  if (end == lptr) return FALSE;
   addon();
   if (temp_i < imin || temp_i > imax) LASMessage(LAS_WARNING, "%s %d is out of range [%d,%d]", context, temp_i, imin, imax);
   *out = (temp_i <= imin) ? imin : ((temp_i >= imax) ? imax : temp_i);
-  skip_post();
+  skip_post(lptr);
   return TRUE;
 }
 
-BOOL LASreaderTXT::parse_item_i(I32* out, const I32 imin, const I32 imax, const CHAR* context) {
-  return parse_item_i(out, imin, imax, context, [&]() {});
+BOOL LASreaderTXT::parse_item_i(const CHAR*& lptr, I32* out, const I32 imin, const I32 imax, const CHAR* context) const {
+  return parse_item_i(lptr, out, imin, imax, context, [&]() {});
 }
 
 template<typename T>
-BOOL LASreaderTXT::parse_item_f(F32* out, const F32 imin, const F32 imax, const CHAR* context, T addon) {
+BOOL LASreaderTXT::parse_item_f(const CHAR*& lptr, F32* out, const F32 imin, const F32 imax, const CHAR* context, T addon) const {
   F32 temp_f;
-  if (!skip_pre()) return FALSE;
+  const CHAR* end;
+  if (!skip_pre(lptr)) return FALSE;
   if (lptr[0] == 0) return FALSE;
-  if (sscanf(lptr, "%f", &temp_f) != 1) return FALSE;
+  temp_f = (F32)strtod_las(lptr, &end);
+  if (end == lptr) return FALSE;
   addon();
   if (temp_f < imin || temp_f > imax) LASMessage(LAS_WARNING, "%s %f is out of range [%f,%f]", context, temp_f, imin, imax);
   *out = (temp_f <= imin) ? imin : ((temp_f >= imax) ? imax : temp_f);
-  skip_post();
+  skip_post(lptr);
   return TRUE;
 }
 
-BOOL LASreaderTXT::parse_item_f(F32* out, const F32 imin, const F32 imax, const CHAR* context) {
-  return parse_item_f(out, imin, imax, context, [&]() {});
+BOOL LASreaderTXT::parse_item_f(const CHAR*& lptr, F32* out, const F32 imin, const F32 imax, const CHAR* context) const {
+  return parse_item_f(lptr, out, imin, imax, context, [&]() {});
 }
 
-BOOL LASreaderTXT::parse(const char* parse_string)
+BOOL LASreaderTXT::parse(const char* parse_string, const CHAR* line, LASpoint* point) const
 {
   I32 temp_i;
   F32 temp_f;
+  const CHAR* end;
   const char* p = parse_string;
-  lptr = line;
+  const CHAR* lptr = line;
   // HSL HSV special parsing
   BOOL has_hsl = false;
   BOOL has_hsv = false;
@@ -1867,199 +2090,207 @@ BOOL LASreaderTXT::parse(const char* parse_string)
   {
     if (p[0] == 'x') // we expect the x coordinate
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[0])) != 1) return FALSE;
-      skip_post();
+      if (!skip_pre(lptr)) return FALSE;
+      point->coordinates[0] = strtod_las(lptr, &end);
+      if (end == lptr) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 'y') // we expect the y coordinate
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[1])) != 1) return FALSE;
-      skip_post();
+      if (!skip_pre(lptr)) return FALSE;
+      point->coordinates[1] = strtod_las(lptr, &end);
+      if (end == lptr) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 'z') // we expect the x coordinate
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.coordinates[2])) != 1) return FALSE;
-      skip_post();
+      if (!skip_pre(lptr)) return FALSE;
+      point->coordinates[2] = strtod_las(lptr, &end);
+      if (end == lptr) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 't') // we expect the gps time
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%lf", &(point.gps_time)) != 1) return FALSE;
-      skip_post();
+      if (!skip_pre(lptr)) return FALSE;
+      point->gps_time = strtod_las(lptr, &end);
+      if (end == lptr) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 'R') // we expect the red channel of the RGB field
     {
-      if (parse_item_i(&temp_i, 0, 0xffff, "RGB red")) {
-        point.rgb[0] = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 0xffff, "RGB red")) {
+        point->rgb[0] = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 'G') // we expect the green channel of the RGB field
     {
-      if (parse_item_i(&temp_i, 0, 0xffff, "RGB green")) {
-        point.rgb[1] = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 0xffff, "RGB green")) {
+        point->rgb[1] = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 'B') // we expect the blue channel of the RGB field
     {
-      if (parse_item_i(&temp_i, 0, 0xffff, "RGB blue")) {
-        point.rgb[2] = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 0xffff, "RGB blue")) {
+        point->rgb[2] = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 'I') // we expect the NIR channel of LAS 1.4 point type 8
     {
-      if (parse_item_i(&temp_i, 0, 0xffff, "NIR")) {
-        point.rgb[3] = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 0xffff, "NIR")) {
+        point->rgb[3] = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 's') // we expect a string or a number that we don't care about
     {
-      if (!skip_pre()) return FALSE;
-      skip_post();
+      if (!skip_pre(lptr)) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 'i') // we expect the intensity
     {
-      if (parse_item_f(&temp_f, 0.0f, 65535.5f, "intensity",
+      if (parse_item_f(lptr, &temp_f, 0.0f, 65535.5f, "intensity",
         [&]() {
           if (translate_intensity != 0.0f) temp_f = temp_f + translate_intensity;
           if (scale_intensity != 1.0f) temp_f = temp_f * scale_intensity;
         })) 
       {
-        point.set_intensity(U16_QUANTIZE(temp_f));
+        point->set_intensity(U16_QUANTIZE(temp_f));
       } 
       else return FALSE;
     }
     else if (p[0] == 'a') // we expect the scan angle
     {
-      if (parse_item_f(&temp_f, -128.0f, 127.0f, "scan angle",
+      if (parse_item_f(lptr, &temp_f, -128.0f, 127.0f, "scan angle",
         [&]() {
           if (translate_scan_angle != 0.0f) temp_f = temp_f + translate_scan_angle;
           if (scale_scan_angle != 1.0f) temp_f = temp_f * scale_scan_angle;
         })) 
       {
-        point.set_scan_angle(temp_f);
+        point->set_scan_angle(temp_f);
       }
       else return FALSE;
     }
     else if (p[0] == 'n') // we expect the number of returns of given pulse
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
+      temp_i = strtoi_las(lptr, &end);
+      if (end == lptr) return FALSE;
       if (point_type > 5)
       {
         if (temp_i < 0 || temp_i > 15) LASMessage(LAS_WARNING, "number of returns of given pulse %d is out of range of four bits", temp_i);
-        point.set_extended_number_of_returns(temp_i & 15);
+        point->set_extended_number_of_returns(temp_i & 15);
       }
       else
       {
         if (temp_i < 0 || temp_i > 7) LASMessage(LAS_WARNING, "number of returns of given pulse %d is out of range of three bits", temp_i);
-        point.set_number_of_returns(temp_i & 7);
+        point->set_number_of_returns(temp_i & 7);
       }
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == 'r') // we expect the number of the return
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
+      temp_i = strtoi_las(lptr, &end);
+      if (end == lptr) return FALSE;
       if (point_type > 5)
       {
         if (temp_i < 0 || temp_i > 15) LASMessage(LAS_WARNING, "return number %d is out of range of four bits", temp_i);
-        point.set_extended_return_number(temp_i & 15);
+        point->set_extended_return_number(temp_i & 15);
       }
       else
       {
         if (temp_i < 0 || temp_i > 7) LASMessage(LAS_WARNING, "return number %d is out of range of three bits", temp_i);
-        point.set_return_number(temp_i & 7);
+        point->set_return_number(temp_i & 7);
       }
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == 'h') // we expect the with<h>eld flag
     {
-      if (parse_item_i(&temp_i, 0, 1, "withheld flag")) {
-        point.set_withheld_flag(temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 1, "withheld flag")) {
+        point->set_withheld_flag(temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'k') // we expect the <k>eypoint flag
     {
-      if (parse_item_i(&temp_i, 0, 1, "keypoint flag")) {
-        point.set_keypoint_flag(temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 1, "keypoint flag")) {
+        point->set_keypoint_flag(temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'g') // we expect the synthetic fla<g>
     {
-      if (parse_item_i(&temp_i, 0, 1, "synthetic flag")) {
-        point.set_synthetic_flag(temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 1, "synthetic flag")) {
+        point->set_synthetic_flag(temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'o') // we expect the overlap flag
     {
-      if (parse_item_i(&temp_i, 0, 1, "overlap flag")) {
-        point.set_extended_overlap_flag(temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 1, "overlap flag")) {
+        point->set_extended_overlap_flag(temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'l') // we expect the scanner channel
     {
-      if (parse_item_i(&temp_i, 0, 3, "scanner channel")) {
-        point.extended_scanner_channel = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 3, "scanner channel")) {
+        point->extended_scanner_channel = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 'E') // we expect a terrasolid echo encoding)
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
+      temp_i = strtoi_las(lptr, &end);
+      if (end == lptr) return FALSE;
       if (temp_i < 0 || temp_i > 3) LASMessage(LAS_WARNING, "terrasolid echo encoding %d is out of range of 0 to 3", temp_i);
       if (temp_i == 0) // only echo
       {
-        point.number_of_returns = 1;
-        point.return_number = 1;
+        point->number_of_returns = 1;
+        point->return_number = 1;
       }
       else if (temp_i == 1) // first (of many)
       {
-        point.number_of_returns = 2;
-        point.return_number = 1;
+        point->number_of_returns = 2;
+        point->return_number = 1;
       }
       else if (temp_i == 3) // last (of many)
       {
-        point.number_of_returns = 2;
-        point.return_number = 2;
+        point->number_of_returns = 2;
+        point->return_number = 2;
       }
       else // intermediate
       {
-        point.number_of_returns = 3;
-        point.return_number = 2;
+        point->number_of_returns = 3;
+        point->return_number = 2;
       }
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == 'c') // we expect the classification
     {
-      if (!skip_pre()) return FALSE;
-      if (sscanf(lptr, "%d", &temp_i) != 1) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
+      temp_i = strtoi_las(lptr, &end);
+      if (end == lptr) return FALSE;
       if (temp_i < 0)
       {
         LASMessage(LAS_WARNING, "classification %d is negative. zeroing ...", temp_i);
-        point.set_classification(0);
-        point.set_extended_classification(0);
+        point->set_classification(0);
+        point->set_extended_classification(0);
       }
-      else if (point.extended_point_type)
+      else if (point->extended_point_type)
       {
         if (temp_i > 255)
         {
           LASMessage(LAS_WARNING, "extended classification %d is larger than 255. clamping ...", temp_i);
-          point.set_extended_classification(255);
+          point->set_extended_classification(255);
         }
         else
         {
-          point.set_extended_classification((U8)temp_i);
+          point->set_extended_classification((U8)temp_i);
         }
       }
       else
@@ -2067,53 +2298,53 @@ BOOL LASreaderTXT::parse(const char* parse_string)
         if (temp_i > 31)
         {
           LASMessage(LAS_WARNING, "classification %d is larger than 31. clamping ...", temp_i);
-          point.set_classification(31);
+          point->set_classification(31);
         }
         else
         {
-          point.set_classification((U8)temp_i);
+          point->set_classification((U8)temp_i);
         }
       }
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == 'u') // we expect the user data
     {
-      if (parse_item_i(&temp_i, 0, 255, "user data")) {
-        point.set_user_data((U8)temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 255, "user data")) {
+        point->set_user_data((U8)temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'p') // we expect the point source ID
     {
-      if (parse_item_i(&temp_i, 0, 0xffff, "point source ID")) {
-        point.set_point_source_ID((U16)temp_i);
+      if (parse_item_i(lptr, &temp_i, 0, 0xffff, "point source ID")) {
+        point->set_point_source_ID((U16)temp_i);
       }
       else return FALSE;
     }
     else if (p[0] == 'e') // we expect the edge of flight line flag
     {
-      if (parse_item_i(&temp_i, 0, 1, "edge of flight line")) {
-        point.edge_of_flight_line = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 1, "edge of flight line")) {
+        point->edge_of_flight_line = temp_i;
       }
       else return FALSE;
     }
     else if (p[0] == 'd') // we expect the direction of scan flag
     {
-      if (parse_item_i(&temp_i, 0, 1, "direction of scan")) {
-        point.scan_direction_flag = temp_i;
+      if (parse_item_i(lptr, &temp_i, 0, 1, "direction of scan")) {
+        point->scan_direction_flag = temp_i;
       }
       else return FALSE;
     }
     else if ((p[0] >= '0') && (p[0] <= '9')) // we expect attribute number 0 to 9
     {
-      if (!skip_pre()) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
       I32 index = (I32)(p[0] - '0');
-      if (!parse_attribute(lptr, index)) return FALSE;
-      skip_post();
+      if (!parse_attribute(lptr, index, point)) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == '(') // we expect attribute number 10 or higher
     {
-      if (!skip_pre()) return FALSE;
+      if (!skip_pre(lptr)) return FALSE;
       p++;
       I32 index = 0;
       while (p[0] >= '0' && p[0] <= '9')
@@ -2121,8 +2352,8 @@ BOOL LASreaderTXT::parse(const char* parse_string)
         index = 10 * index + (I32)(p[0] - '0');
         p++;
       }
-      if (!parse_attribute(lptr, index)) return FALSE;
-      skip_post();
+      if (!parse_attribute(lptr, index, point)) return FALSE;
+      skip_post(lptr);
     }
     else if (p[0] == 'H') // we expect a hexadecimal coded RGB color
     {
@@ -2132,15 +2363,15 @@ BOOL LASreaderTXT::parse(const char* parse_string)
       if (lptr[0] == 0) return FALSE;
       hex_string[0] = lptr[0]; hex_string[1] = lptr[1];
       sscanf_las(hex_string, "%x", &hex_value);
-      point.rgb[0] = hex_value;
+      point->rgb[0] = hex_value;
       hex_string[0] = lptr[2]; hex_string[1] = lptr[3];
       sscanf_las(hex_string, "%x", &hex_value);
-      point.rgb[1] = hex_value;
+      point->rgb[1] = hex_value;
       hex_string[0] = lptr[4]; hex_string[1] = lptr[5];
       sscanf_las(hex_string, "%x", &hex_value);
-      point.rgb[2] = hex_value;
+      point->rgb[2] = hex_value;
       lptr += 6;
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == 'J') // we expect a hexadecimal coded intensity
     {
@@ -2148,13 +2379,13 @@ BOOL LASreaderTXT::parse(const char* parse_string)
       while (lptr[0] && (lptr[0] == ' ' || lptr[0] == ',' || lptr[0] == '\t' || lptr[0] == ';' || lptr[0] == '\"')) lptr++; // first skip white spaces and quotes
       if (lptr[0] == 0) return FALSE;
       sscanf_las(lptr, "%x", &hex_value);
-      point.intensity = U8_CLAMP(((F64)hex_value / (F64)0xFFFFFF) * 255);
+      point->intensity = U8_CLAMP(((F64)hex_value / (F64)0xFFFFFF) * 255);
       lptr += 6;
-      skip_post();
+      skip_post(lptr);
     }
     else if (p[0] == HSL_H) // we expect the HSL hue representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 360, "HSL hue")) {
+      if (parse_item_i(lptr, &temp_i, 0, 360, "HSL hue")) {
         hsl[0] = (F32)temp_i / 360.0f;
         has_hsl = true;
       }
@@ -2162,7 +2393,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSL_S) // we expect the HSL saturation representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 100, "HSL saturation")) {
+      if (parse_item_i(lptr, &temp_i, 0, 100, "HSL saturation")) {
         hsl[1] = (F32)temp_i / 100.0f;
         has_hsl = true;
       }
@@ -2170,7 +2401,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSL_L) // we expect the HSL lightness representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 100, "HSL lightness")) {
+      if (parse_item_i(lptr, &temp_i, 0, 100, "HSL lightness")) {
         hsl[2] = (F32)temp_i / 100.0f;
         has_hsl = true;
       }
@@ -2178,7 +2409,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSL_h) // we expect the HSL hue representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSL hue")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSL hue")) {
         hsl[0] = temp_f;
         has_hsl = true;
       }
@@ -2186,7 +2417,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSL_s) // we expect the HSL saturation representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSL saturation")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSL saturation")) {
         hsl[1] = temp_f;
         has_hsl = true;
       }
@@ -2194,7 +2425,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSL_l) // we expect the HSL lightness representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSL lightness")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSL lightness")) {
         hsl[2] = temp_f;
         has_hsl = true;
       }
@@ -2202,7 +2433,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_H) // we expect the HSV hue representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 360, "HSV hue")) {
+      if (parse_item_i(lptr, &temp_i, 0, 360, "HSV hue")) {
         hsv[0] = temp_i / 360.f;
         has_hsv = true;
       }
@@ -2210,7 +2441,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_S) // we expect the HSV saturation representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 100, "HSV saturation")) {
+      if (parse_item_i(lptr, &temp_i, 0, 100, "HSV saturation")) {
         hsv[1] = temp_i / 100.f;
         has_hsv = true;
       }
@@ -2218,7 +2449,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_V) // we expect the HSV value representation of RGB in range [0,255]
     {
-      if (parse_item_i(&temp_i, 0, 100, "HSV value")) {
+      if (parse_item_i(lptr, &temp_i, 0, 100, "HSV value")) {
         hsv[2] = temp_i / 100.f;
         has_hsv = true;
       }
@@ -2226,7 +2457,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_h) // we expect the HSV hue representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSV hue")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSV hue")) {
         hsv[0] = temp_f;
         has_hsv = true;
       }
@@ -2234,7 +2465,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_s) // we expect the HSV saturation representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSV saturation")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSV saturation")) {
         hsv[1] = temp_f;
         has_hsv = true;
       }
@@ -2242,7 +2473,7 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     }
     else if (p[0] == HSV_v) // we expect the HSV value representation of RGB in range [0,1]
     {
-      if (parse_item_f(&temp_f, 0.0, 1.0, "HSV value")) {
+      if (parse_item_f(lptr, &temp_f, 0.0, 1.0, "HSV value")) {
         hsv[2] = temp_f;
         has_hsv = true;
       }
@@ -2255,10 +2486,10 @@ BOOL LASreaderTXT::parse(const char* parse_string)
     p++;
   }
   if (has_hsl) {
-    point.set_RGB_from_HSL(hsl);
+    point->set_RGB_from_HSL(hsl);
   }
   else if (has_hsv) {
-    point.set_RGB_from_HSV(hsv);
+    point->set_RGB_from_HSV(hsv);
   }
   return TRUE;
 }
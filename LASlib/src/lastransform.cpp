@@ -155,6 +155,204 @@ void LASoperation::set_offset_adjust_coord_without_trafo_changes(LASpoint* point
   }
 };
 
+/// whether row r (0 for x, 1 for y, 2 for z) of an affine map leaves the coordinate as it is
+static inline BOOL is_identity_row(const F64* m, const U32 r)
+{
+  return (m[r * 4 + 0] == (r == 0 ? 1.0 : 0.0)) && (m[r * 4 + 1] == (r == 1 ? 1.0 : 0.0)) && (m[r * 4 + 2] == (r == 2 ? 1.0 : 0.0)) && (m[r * 4 + 3] == 0.0);
+}
+
+/// applies an affine map to the coordinates of the points from index 'start' onwards of a batch. the
+/// arithmetic is that of the single operations so that e.g. a batched '-translate_xyz' gives identical
+/// results. the overflows are counted for the operation 'op'
+static void transform_affine_batch(LASpointBatch* batch, const U32 start, const F64* m, LASoperation* op)
+{
+  const LASquantizer* quantizer = batch->quantizer;
+  BOOL set_x = !is_identity_row(m, 0);
+  BOOL set_y = !is_identity_row(m, 1);
+  BOOL set_z = !is_identity_row(m, 2);
+  I64 overflow = 0;
+  U32 i;
+  for (i = start; i < batch->count; i++)
+  {
+    F64 x = quantizer->get_x(batch->X[i]);
+    F64 y = quantizer->get_y(batch->Y[i]);
+    F64 z = quantizer->get_z(batch->Z[i]);
+    if (set_x)
+    {
+      I64 X = quantizer->get_X(m[0] * x + m[1] * y + m[2] * z + m[3]);
+      batch->X[i] = (I32)X;
+      overflow += !I32_FITS_IN_RANGE(X);
+    }
+    if (set_y)
+    {
+      I64 Y = quantizer->get_Y(m[4] * x + m[5] * y + m[6] * z + m[7]);
+      batch->Y[i] = (I32)Y;
+      overflow += !I32_FITS_IN_RANGE(Y);
+    }
+    if (set_z)
+    {
+      I64 Z = quantizer->get_Z(m[8] * x + m[9] * y + m[10] * z + m[11]);
+      batch->Z[i] = (I32)Z;
+      overflow += !I32_FITS_IN_RANGE(Z);
+    }
+  }
+  if (overflow) op->add_overflow(overflow);
+}
+
+/// several consecutive coordinate operations fused into one affine map by LAStransform::compile(). the
+/// overflows are counted for the last of the fused operations
+class LASoperationFusedAffine : public LASoperation
+{
+   public:
+    inline const CHAR* name() const
+    {
+        return "fused_xyz_operations";
+    };
+    inline I32 get_command(CHAR* string) const
+    {
+        return sprintf(string, "-%s %lf,%lf,%lf,%lf %lf,%lf,%lf,%lf %lf,%lf,%lf,%lf ", name(), m[0], m[1], m[2], m[3], m[4], m[5], m[6], m[7], m[8], m[9], m[10], m[11]);
+    };
+    inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
+    {
+      F64* tranformed_coord = new F64[3]{0.0, 0.0, 0.0};
+      tranformed_coord[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+      tranformed_coord[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+      tranformed_coord[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+      return tranformed_coord;
+    };
+    inline void transform(LASpoint* point)
+    {
+        F64 x = point->get_x();
+        F64 y = point->get_y();
+        F64 z = point->get_z();
+        if (set_x && !point->set_x(m[0] * x + m[1] * y + m[2] * z + m[3]))
+        {
+            last->add_overflow(1);
+        }
+        if (set_y && !point->set_y(m[4] * x + m[5] * y + m[6] * z + m[7]))
+        {
+            last->add_overflow(1);
+        }
+        if (set_z && !point->set_z(m[8] * x + m[9] * y + m[10] * z + m[11]))
+        {
+            last->add_overflow(1);
+        }
+    };
+    inline BOOL get_affine(F64* m) const
+    {
+        memcpy(m, this->m, sizeof(F64) * 12);
+        return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return TRUE;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        transform_affine_batch(batch, start, m, last);
+    };
+    LASoperationFusedAffine(const F64* m, LASoperation* last)
+    {
+        memcpy(this->m, m, sizeof(F64) * 12);
+        this->last = last;
+        set_x = !is_identity_row(m, 0);
+        set_y = !is_identity_row(m, 1);
+        set_z = !is_identity_row(m, 2);
+    };
+
+   private:
+    F64 m[12];
+    BOOL set_x, set_y, set_z;
+    LASoperation* last;
+};
+
+/// several consecutive mappings of one attribute folded into one lookup table by LAStransform::compile()
+class LASoperationLookup : public LASoperation
+{
+   public:
+    inline const CHAR* name() const
+    {
+        return "lookup";
+    };
+    inline I32 get_command(CHAR* string) const
+    {
+        return sprintf(string, "-%s %u ", name(), field);
+    };
+    inline F64* transform_coords_for_offset_adjustment(F64 x, F64 y, F64 z)
+    {
+      return get_offset_adjust_coord_without_trafo_changes(x, y, z);
+    };
+    inline void transform(LASpoint* point)
+    {
+        if (field == LASOPERATION_LUT_USER_DATA)
+        {
+            point->user_data = (U8)lut[point->user_data];
+        }
+        else if (field == LASOPERATION_LUT_CLASSIFICATION)
+        {
+            U16 value = lut[(point->classification << 8) | point->extended_classification];
+            point->classification = (value >> 8);
+            point->extended_classification = (value & 255);
+        }
+        else
+        {
+            point->point_source_ID = lut[point->point_source_ID];
+        }
+    };
+    inline BOOL has_batch() const
+    {
+        return TRUE;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        U32 i;
+        if (field == LASOPERATION_LUT_USER_DATA)
+        {
+            for (i = start; i < batch->count; i++) batch->user_data[i] = (U8)lut[batch->user_data[i]];
+        }
+        else if (field == LASOPERATION_LUT_CLASSIFICATION)
+        {
+            // a batch only has the extended classification of the new LAS 1.4 point types (from
+            // which the legacy one follows) or the legacy classification of the older ones
+            if (batch->extended_point_type)
+            {
+                for (i = start; i < batch->count; i++)
+                {
+                    U8 c = batch->classification[i];
+                    batch->classification[i] = (lut[((c < 32 ? c : 0) << 8) | c] & 255);
+                }
+            }
+            else
+            {
+                for (i = start; i < batch->count; i++) batch->classification[i] = (lut[batch->classification[i] << 8] >> 8);
+            }
+        }
+        else
+        {
+            for (i = start; i < batch->count; i++) batch->point_source_ID[i] = lut[batch->point_source_ID[i]];
+        }
+    };
+    static U32 get_size(const U32 field)
+    {
+        return (field == LASOPERATION_LUT_USER_DATA ? 256 : (field == LASOPERATION_LUT_CLASSIFICATION ? 8192 : 65536));
+    };
+    LASoperationLookup(const U32 field)
+    {
+        this->field = field;
+        U32 i, size = get_size(field);
+        lut = new U16[size];
+        for (i = 0; i < size; i++) lut[i] = (U16)i;
+    };
+    ~LASoperationLookup()
+    {
+        delete[] lut;
+    };
+    U16* lut;
+
+   private:
+    U32 field;
+};
+
 class LASoperationTranslateX : public LASoperation
 {
    public:
@@ -193,6 +391,23 @@ class LASoperationTranslateX : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = offset;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationTranslateX(F64 offset)
     {
         this->offset = offset;
@@ -237,6 +452,23 @@ class LASoperationTranslateY : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = offset;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationTranslateY(F64 offset)
     {
         this->offset = offset;
@@ -286,6 +518,23 @@ class LASoperationTranslateZ : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = offset;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationTranslateZ(F64 offset)
     {
         this->offset = offset;
@@ -344,6 +593,23 @@ class LASoperationTranslateXYZ : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = offset[0];
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = offset[1];
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = offset[2];
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationTranslateXYZ(F64 x_offset, F64 y_offset, F64 z_offset)
     {
         this->offset[0] = x_offset;
@@ -392,6 +658,23 @@ class LASoperationScaleX : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = scale; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationScaleX(F64 scale)
     {
         this->scale = scale;
@@ -437,6 +720,23 @@ class LASoperationScaleY : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = scale; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationScaleY(F64 scale)
     {
         this->scale = scale;
@@ -486,6 +786,23 @@ class LASoperationScaleZ : public LASoperation
           }
         }      
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = scale; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationScaleZ(F64 scale)
     {
         this->scale = scale;
@@ -543,6 +860,23 @@ class LASoperationScaleXYZ : public LASoperation
           }
         }      
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = scale[0]; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = scale[1]; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = scale[2]; m[11] = 0.0;
+      return TRUE;
+    };
+    inline BOOL has_batch() const
+    {
+        return !offset_adjust;
+    };
+    inline void transform_batch(LASpointBatch* batch, const U32 start)
+    {
+        F64 m[12];
+        get_affine(m);
+        transform_affine_batch(batch, start, m, this);
+    };
     LASoperationScaleXYZ(F64 x_scale, F64 y_scale, F64 z_scale)
     {
         this->scale[0] = x_scale;
@@ -590,6 +924,13 @@ class LASoperationTranslateThenScaleX : public LASoperation
           }
         }            
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = scale; m[1] = 0.0; m[2] = 0.0; m[3] = offset * scale;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationTranslateThenScaleX(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -637,6 +978,13 @@ class LASoperationTranslateThenScaleY : public LASoperation
           }
         }    
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = scale; m[6] = 0.0; m[7] = offset * scale;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationTranslateThenScaleY(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -688,6 +1036,13 @@ class LASoperationTranslateThenScaleZ : public LASoperation
           }
         }  
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = scale; m[11] = offset * scale;
+      return TRUE;
+    };
     LASoperationTranslateThenScaleZ(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -735,6 +1090,13 @@ class LASoperationTranslateScaleTranslateX : public LASoperation
           }
         }  
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = scale; m[1] = 0.0; m[2] = 0.0; m[3] = offset - offset * scale;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationTranslateScaleTranslateX(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -782,6 +1144,13 @@ class LASoperationTranslateScaleTranslateY : public LASoperation
           }
         } 
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = scale; m[6] = 0.0; m[7] = offset - offset * scale;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationTranslateScaleTranslateY(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -833,6 +1202,13 @@ class LASoperationTranslateScaleTranslateZ : public LASoperation
           }
         } 
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = 0.0; m[9] = 0.0; m[10] = scale; m[11] = offset - offset * scale;
+      return TRUE;
+    };
     LASoperationTranslateScaleTranslateZ(F64 offset, F64 scale)
     {
         this->offset = offset;
@@ -890,6 +1266,13 @@ class LASoperationRotateXY : public LASoperation
           }
         } 
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = cos_angle; m[1] = -sin_angle; m[2] = 0.0; m[3] = x_offset - cos_angle * x_offset + sin_angle * y_offset;
+      m[4] = sin_angle; m[5] = cos_angle; m[6] = 0.0; m[7] = y_offset - cos_angle * y_offset - sin_angle * x_offset;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationRotateXY(F64 angle, F64 x_offset, F64 y_offset)
     {
         this->angle = angle;
@@ -955,6 +1338,13 @@ class LASoperationRotateXZ : public LASoperation
           }
         } 
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = cos_angle; m[1] = 0.0; m[2] = -sin_angle; m[3] = x_offset - cos_angle * x_offset + sin_angle * z_offset;
+      m[4] = 0.0; m[5] = 1.0; m[6] = 0.0; m[7] = 0.0;
+      m[8] = sin_angle; m[9] = 0.0; m[10] = cos_angle; m[11] = z_offset - cos_angle * z_offset - sin_angle * x_offset;
+      return TRUE;
+    };
     LASoperationRotateXZ(F64 angle, F64 x_offset, F64 z_offset)
     {
         this->angle = angle;
@@ -1020,6 +1410,13 @@ class LASoperationRotateYZ : public LASoperation
           }
         } 
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = 1.0; m[1] = 0.0; m[2] = 0.0; m[3] = 0.0;
+      m[4] = 0.0; m[5] = cos_angle; m[6] = -sin_angle; m[7] = y_offset - cos_angle * y_offset + sin_angle * z_offset;
+      m[8] = 0.0; m[9] = sin_angle; m[10] = cos_angle; m[11] = z_offset - cos_angle * z_offset - sin_angle * y_offset;
+      return TRUE;
+    };
     LASoperationRotateYZ(F64 angle, F64 y_offset, F64 z_offset)
     {
         this->angle = angle;
@@ -1092,6 +1489,13 @@ class LASoperationTransformHelmert : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = scale; m[1] = -scale * rz_rad; m[2] = scale * ry_rad; m[3] = dx;
+      m[4] = scale * rz_rad; m[5] = scale; m[6] = -scale * rx_rad; m[7] = dy;
+      m[8] = -scale * ry_rad; m[9] = scale * rx_rad; m[10] = scale; m[11] = dz;
+      return TRUE;
+    };
     LASoperationTransformHelmert(F64 dx, F64 dy, F64 dz, F64 rx, F64 ry, F64 rz, F64 m)
     {
         this->dx = dx;
@@ -1160,6 +1564,13 @@ class LASoperationTransformAffine : public LASoperation
           }
         }
     };
+    inline BOOL get_affine(F64* m) const
+    {
+      m[0] = r * cosw; m[1] = r * sinw; m[2] = 0.0; m[3] = tx;
+      m[4] = -r * sinw; m[5] = r * cosw; m[6] = 0.0; m[7] = ty;
+      m[8] = 0.0; m[9] = 0.0; m[10] = 1.0; m[11] = 0.0;
+      return TRUE;
+    };
     LASoperationTransformAffine(F64 r, F64 w, F64 tx, F64 ty)
     {
         this->r = r;
@@ -3178,6 +3589,17 @@ class LASoperationSetClassification : public LASoperation
 
         point->set_extended_classification(classification);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_CLASSIFICATION;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            lut[i] = ((classification < 32 ? classification : 0) << 8) | classification;
+        }
+    };
     LASoperationSetClassification(U8 classification)
     {
         this->classification = classification;
@@ -3222,6 +3644,20 @@ class LASoperationChangeClassificationFromTo : public LASoperation
             point->set_extended_classification(class_to);
         }
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_CLASSIFICATION;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            if ((class_from > 31) ? ((lut[i] & 255) == class_from) : ((lut[i] >> 8) == class_from))
+            {
+                lut[i] = ((class_to < 32 ? class_to : 0) << 8) | class_to;
+            }
+        }
+    };
     LASoperationChangeClassificationFromTo(U8 class_from, U8 class_to)
     {
         this->class_from = class_from;
@@ -3918,6 +4354,17 @@ class LASoperationSetUserData : public LASoperation
 
         point->user_data = user_data;
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_USER_DATA;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            lut[i] = user_data;
+        }
+    };
     LASoperationSetUserData(U8 user_data)
     {
         this->user_data = user_data;
@@ -3987,6 +4434,20 @@ class LASoperationChangeUserDataFromTo : public LASoperation
         if (point->get_user_data() == user_data_from)
             point->set_user_data(user_data_to);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_USER_DATA;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            if (lut[i] == user_data_from)
+            {
+                lut[i] = user_data_to;
+            }
+        }
+    };
     LASoperationChangeUserDataFromTo(U8 user_data_from, U8 user_data_to)
     {
         this->user_data_from = user_data_from;
@@ -4024,6 +4485,17 @@ class LASoperationMapUserData : public LASoperation
         U8 user_data = point->get_user_data();
         point->set_user_data(map[user_data]);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_USER_DATA;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            lut[i] = map[lut[i]];
+        }
+    };
     LASoperationMapUserData(const CHAR* file_name)
     {
         for (U32 u = 0; u < 256; u++)
@@ -4318,6 +4790,17 @@ class LASoperationSetPointSource : public LASoperation
 
         point->set_point_source_ID(psid);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_POINT_SOURCE;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            lut[i] = psid;
+        }
+    };
     LASoperationSetPointSource(U16 psid)
     {
         this->psid = psid;
@@ -4353,6 +4836,20 @@ class LASoperationChangePointSourceFromTo : public LASoperation
         if (point->get_point_source_ID() == psid_from)
             point->set_point_source_ID(psid_to);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_POINT_SOURCE;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            if (lut[i] == psid_from)
+            {
+                lut[i] = psid_to;
+            }
+        }
+    };
     LASoperationChangePointSourceFromTo(U16 psid_from, U16 psid_to)
     {
         this->psid_from = psid_from;
@@ -4390,6 +4887,17 @@ class LASoperationMapPointSource : public LASoperation
         U16 point_source = point->get_point_source_ID();
         point->set_point_source_ID(map[point_source]);
     };
+    inline U32 get_lut() const
+    {
+        return LASOPERATION_LUT_POINT_SOURCE;
+    };
+    inline void map_lut(U16* lut, const U32 size) const
+    {
+        for (U32 i = 0; i < size; i++)
+        {
+            lut[i] = map[lut[i]];
+        }
+    };
     LASoperationMapPointSource(const CHAR* file_name)
     {
         for (U32 u = 0; u < 65536; u++)
@@ -6618,6 +7126,119 @@ void LAStransform::clean()
         delete filter;
         filter = 0;
     }
+    clean_stages();
+}
+
+void LAStransform::clean_stages()
+{
+    U32 i;
+    for (i = 0; i < num_owned_stages; i++)
+    {
+        delete owned_stages[i];
+    }
+    if (owned_stages)
+        delete[] owned_stages;
+    if (stages)
+        delete[] stages;
+    num_owned_stages = 0;
+    owned_stages = 0;
+    num_stages = 0;
+    stages = 0;
+    compiled = FALSE;
+}
+
+/// Turns the list of operations into the list of stages that is actually applied to the points. Operations
+/// that only map the user data, the classification, or the point source ID become lookup tables and runs of
+/// them on the same attribute are folded into one table. With '-fuse_xyz_operations' consecutive affine coordinate operations are also fused into
+/// one matrix. Operations that adjust the offset are always applied as they are.
+void LAStransform::compile()
+{
+    U32 i, j;
+    clean_stages();
+    if (num_operations == 0)
+    {
+        compiled = TRUE;
+        return;
+    }
+    stages = new LASoperation*[num_operations];
+    owned_stages = new LASoperation*[num_operations];
+    for (i = 0; i < num_operations; i = j)
+    {
+        LASoperation* operation = operations[i];
+        j = i + 1;
+        if (operation->get_offset_adjust())
+        {
+            stages[num_stages++] = operation;
+            continue;
+        }
+        F64 m[12];
+        if (fuse_operations && operation->get_affine(m))
+        {
+            F64 n[12];
+            while ((j < num_operations) && !operations[j]->get_offset_adjust() && operations[j]->get_affine(n))
+            {
+                // the fused map first applies m and then n
+                F64 fused[12];
+                for (U32 r = 0; r < 3; r++)
+                {
+                    for (U32 c = 0; c < 4; c++)
+                    {
+                        fused[r * 4 + c] = n[r * 4 + 0] * m[0 * 4 + c] + n[r * 4 + 1] * m[1 * 4 + c] + n[r * 4 + 2] * m[2 * 4 + c] + (c == 3 ? n[r * 4 + 3] : 0.0);
+                    }
+                }
+                memcpy(m, fused, sizeof(F64) * 12);
+                j++;
+            }
+            if (j > i + 1)
+            {
+                LASoperation* stage = new LASoperationFusedAffine(m, operations[j - 1]);
+                stages[num_stages++] = stage;
+                owned_stages[num_owned_stages++] = stage;
+                LASMessage(LAS_VERBOSE, "fused %u coordinate operations into one", j - i);
+                continue;
+            }
+        }
+        U32 field = operation->get_lut();
+        if (field != LASOPERATION_LUT_NONE)
+        {
+            LASoperationLookup* stage = new LASoperationLookup(field);
+            U32 size = LASoperationLookup::get_size(field);
+            operation->map_lut(stage->lut, size);
+            while ((j < num_operations) && !operations[j]->get_offset_adjust() && (operations[j]->get_lut() == field))
+            {
+                operations[j]->map_lut(stage->lut, size);
+                j++;
+            }
+            stages[num_stages++] = stage;
+            owned_stages[num_owned_stages++] = stage;
+            continue;
+        }
+        stages[num_stages++] = operation;
+    }
+    compiled = TRUE;
+}
+
+BOOL LAStransform::can_transform(const LASpointBatch* batch)
+{
+    U32 i;
+    if (filter || (batch->quantizer == 0)) return FALSE;
+    if (!compiled) compile();
+    for (i = 0; i < num_stages; i++)
+    {
+        if (!stages[i]->has_batch()) return FALSE;
+    }
+    return TRUE;
+}
+
+void LAStransform::transform(LASpointBatch* batch, const U32 start)
+{
+    U32 i;
+    if (!compiled) compile();
+    for (i = 0; i < num_stages; i++)
+    {
+        stages[i]->transform_batch(batch, start);
+    }
+    batch->update_records(start);
 }
 
 void LAStransform::usage() const
@@ -6642,6 +7263,7 @@ void LAStransform::usage() const
         "  -add_scaled_attribute_to_z 1 -1.2\n"
         "  -copy_intensity_into_z\n"
         "  -copy_user_data_into_z\n"
+        "  -fuse_xyz_operations (one matrix for consecutive coordinate operations)\n"
         "Transform raw xyz integers.\n"
         "  -translate_raw_z 20\n"
         "  -translate_raw_xyz 1 1 0\n"
@@ -10331,6 +10953,11 @@ BOOL LAStransform::parse(int argc, char* argv[])
             is_filtered = TRUE;
             *argv[i] = '\0';
         }
+        else if (strcmp(argv[i], "-fuse_xyz_operations") == 0)
+        {
+            fuse_operations = TRUE;
+            *argv[i] = '\0';
+        }
         else if (strncmp(argv[i], "-add_", 5) == 0)
         {
             if (strcmp(argv[i], "-add_registers") == 0)
@@ -10763,6 +11390,10 @@ I32 LAStransform::unparse(CHAR* string) const
     {
         n += operations[i]->get_command(&string[n]);
     }
+    if (fuse_operations)
+    {
+        n += sprintf(&string[n], "-fuse_xyz_operations ");
+    }
     return n;
 }
 
@@ -10787,8 +11418,9 @@ void LAStransform::transform(LASpoint* point)
             return;
         }
     }
-    for (i = 0; i < num_operations; i++) {
-      operations[i]->transform(point);
+    if (!compiled) compile();
+    for (i = 0; i < num_stages; i++) {
+      stages[i]->transform(point);
     }
 }
 
@@ -10811,18 +11443,26 @@ LAStransform::LAStransform()
     operations = 0;
     is_filtered = FALSE;
     filter = 0;
+    fuse_operations = FALSE;
+    compiled = FALSE;
+    num_stages = 0;
+    stages = 0;
+    num_owned_stages = 0;
+    owned_stages = 0;
 }
 
 LAStransform::~LAStransform()
 {
     if (operations)
         clean();
+    clean_stages();
 }
 
 /// Calculates a new offset after operations (transformations) to avoid an I32 overflow.
 void LAStransform::adjust_offset(LASreader* lasreader, F64* scale_factor) 
 {
   if (!operations || !lasreader) return;
+  clean_stages();
 
   BOOL min_max_known = TRUE;
   F64* adj_offset = new F64[3]{0.0, 0.0, 0.0};
@@ -10958,6 +11598,7 @@ void LAStransform::add_operation(LASoperation* transform_operation)
     }
     operations[num_operations] = transform_operation;
     num_operations++;
+    clean_stages();
 }
 
 void LAStransform::delete_operation(const CHAR* name)
@@ -10975,6 +11616,7 @@ void LAStransform::delete_operation(const CHAR* name)
                     operations[i - 1] = operations[i];
                 }
                 num_operations--;
+                clean_stages();
                 return;
             }
         }
@@ -32,6 +32,7 @@
 
 #include "lasmessage.hpp"
 
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -98,6 +99,31 @@ BOOL LASinventory::add(const LASpoint* point)
   return TRUE;
 }
 
+BOOL LASinventory::merge(const LASinventory* inventory)
+{
+  if (inventory->first) return TRUE;
+  U32 i;
+  extended_number_of_point_records += inventory->extended_number_of_point_records;
+  for (i = 0; i < 16; i++) extended_number_of_points_by_return[i] += inventory->extended_number_of_points_by_return[i];
+  if (first)
+  {
+    min_X = inventory->min_X; max_X = inventory->max_X;
+    min_Y = inventory->min_Y; max_Y = inventory->max_Y;
+    min_Z = inventory->min_Z; max_Z = inventory->max_Z;
+    first = FALSE;
+  }
+  else
+  {
+    if (inventory->min_X < min_X) min_X = inventory->min_X;
+    if (inventory->max_X > max_X) max_X = inventory->max_X;
+    if (inventory->min_Y < min_Y) min_Y = inventory->min_Y;
+    if (inventory->max_Y > max_Y) max_Y = inventory->max_Y;
+    if (inventory->min_Z < min_Z) min_Z = inventory->min_Z;
+    if (inventory->max_Z > max_Z) max_Z = inventory->max_Z;
+  }
+  return TRUE;
+}
+
 BOOL LASinventory::update_header(LASheader* header) const
 {
   if (header)
@@ -182,6 +208,29 @@ LASsummary::LASsummary()
   flagged_withheld = 0;
   flagged_extended_overlap = 0;
   first = TRUE;
+  fluff_reference = FALSE;
+}
+
+void LASsummary::set_low_digits(const LASpoint* point)
+{
+  xyz_low_digits_10[0] = (U16)(point->get_X()%10);
+  xyz_low_digits_10[1] = (U16)(point->get_Y()%10);
+  xyz_low_digits_10[2] = (U16)(point->get_Z()%10);
+  xyz_low_digits_100[0] = (U16)(point->get_X()%100);
+  xyz_low_digits_100[1] = (U16)(point->get_Y()%100);
+  xyz_low_digits_100[2] = (U16)(point->get_Z()%100);
+  xyz_low_digits_1000[0] = (U16)(point->get_X()%1000);
+  xyz_low_digits_1000[1] = (U16)(point->get_Y()%1000);
+  xyz_low_digits_1000[2] = (U16)(point->get_Z()%1000);
+  xyz_low_digits_10000[0] = (U16)(point->get_X()%10000);
+  xyz_low_digits_10000[1] = (U16)(point->get_Y()%10000);
+  xyz_low_digits_10000[2] = (U16)(point->get_Z()%10000);
+}
+
+void LASsummary::set_fluff_reference(const LASpoint* point)
+{
+  set_low_digits(point);
+  fluff_reference = TRUE;
 }
 
 BOOL LASsummary::add(const LASpoint* point)
@@ -224,18 +273,7 @@ BOOL LASsummary::add(const LASpoint* point)
     min = *point;
     max = *point;
     // initialize fluff detection
-    xyz_low_digits_10[0] = (U16)(point->get_X()%10);
-    xyz_low_digits_10[1] = (U16)(point->get_Y()%10);
-    xyz_low_digits_10[2] = (U16)(point->get_Z()%10);
-    xyz_low_digits_100[0] = (U16)(point->get_X()%100);
-    xyz_low_digits_100[1] = (U16)(point->get_Y()%100);
-    xyz_low_digits_100[2] = (U16)(point->get_Z()%100);
-    xyz_low_digits_1000[0] = (U16)(point->get_X()%1000);
-    xyz_low_digits_1000[1] = (U16)(point->get_Y()%1000);
-    xyz_low_digits_1000[2] = (U16)(point->get_Z()%1000);
-    xyz_low_digits_10000[0] = (U16)(point->get_X()%10000);
-    xyz_low_digits_10000[1] = (U16)(point->get_Y()%10000);
-    xyz_low_digits_10000[2] = (U16)(point->get_Z()%10000);
+    if (!fluff_reference) set_low_digits(point);
     first = FALSE;
   }
   else
@@ -388,6 +426,172 @@ BOOL LASsummary::add(const LASpoint* point)
   return TRUE;
 }
 
+static void copy_min_max(LASpoint* point, const LASpoint* other)
+{
+  point->set_X(other->get_X());
+  point->set_Y(other->get_Y());
+  point->set_Z(other->get_Z());
+  point->intensity = other->intensity;
+  point->edge_of_flight_line = other->edge_of_flight_line;
+  point->scan_direction_flag = other->scan_direction_flag;
+  point->number_of_returns = other->number_of_returns;
+  point->return_number = other->return_number;
+  point->classification = other->classification;
+  point->scan_angle_rank = other->scan_angle_rank;
+  point->user_data = other->user_data;
+  point->point_source_ID = other->point_source_ID;
+  point->gps_time = other->gps_time;
+  for (U32 c = 0; c < 4; c++) point->rgb[c] = other->rgb[c];
+  point->extended_classification = other->extended_classification;
+  point->extended_return_number = other->extended_return_number;
+  point->extended_number_of_returns = other->extended_number_of_returns;
+  point->extended_scan_angle = other->extended_scan_angle;
+  point->extended_scanner_channel = other->extended_scanner_channel;
+  point->wavepacket = other->wavepacket;
+}
+
+static void merge_min_max(LASpoint* min, LASpoint* max, const LASpoint* other_min, const LASpoint* other_max)
+{
+  if (other_min->get_X() < min->get_X()) min->set_X(other_min->get_X());
+  if (other_max->get_X() > max->get_X()) max->set_X(other_max->get_X());
+  if (other_min->get_Y() < min->get_Y()) min->set_Y(other_min->get_Y());
+  if (other_max->get_Y() > max->get_Y()) max->set_Y(other_max->get_Y());
+  if (other_min->get_Z() < min->get_Z()) min->set_Z(other_min->get_Z());
+  if (other_max->get_Z() > max->get_Z()) max->set_Z(other_max->get_Z());
+  if (other_min->intensity < min->intensity) min->intensity = other_min->intensity;
+  if (other_max->intensity > max->intensity) max->intensity = other_max->intensity;
+  if (other_min->edge_of_flight_line < min->edge_of_flight_line) min->edge_of_flight_line = other_min->edge_of_flight_line;
+  if (other_max->edge_of_flight_line > max->edge_of_flight_line) max->edge_of_flight_line = other_max->edge_of_flight_line;
+  if (other_min->scan_direction_flag < min->scan_direction_flag) min->scan_direction_flag = other_min->scan_direction_flag;
+  if (other_max->scan_direction_flag > max->scan_direction_flag) max->scan_direction_flag = other_max->scan_direction_flag;
+  if (other_min->number_of_returns < min->number_of_returns) min->number_of_returns = other_min->number_of_returns;
+  if (other_max->number_of_returns > max->number_of_returns) max->number_of_returns = other_max->number_of_returns;
+  if (other_min->return_number < min->return_number) min->return_number = other_min->return_number;
+  if (other_max->return_number > max->return_number) max->return_number = other_max->return_number;
+  if (other_min->classification < min->classification) min->classification = other_min->classification;
+  if (other_max->classification > max->classification) max->classification = other_max->classification;
+  if (other_min->scan_angle_rank < min->scan_angle_rank) min->scan_angle_rank = other_min->scan_angle_rank;
+  if (other_max->scan_angle_rank > max->scan_angle_rank) max->scan_angle_rank = other_max->scan_angle_rank;
+  if (other_min->user_data < min->user_data) min->user_data = other_min->user_data;
+  if (other_max->user_data > max->user_data) max->user_data = other_max->user_data;
+  if (other_min->point_source_ID < min->point_source_ID) min->point_source_ID = other_min->point_source_ID;
+  if (other_max->point_source_ID > max->point_source_ID) max->point_source_ID = other_max->point_source_ID;
+  if (other_min->gps_time < min->gps_time) min->gps_time = other_min->gps_time;
+  if (other_max->gps_time > max->gps_time) max->gps_time = other_max->gps_time;
+  for (U32 c = 0; c < 4; c++)
+  {
+    if (other_min->rgb[c] < min->rgb[c]) min->rgb[c] = other_min->rgb[c];
+    if (other_max->rgb[c] > max->rgb[c]) max->rgb[c] = other_max->rgb[c];
+  }
+  if (other_min->extended_classification < min->extended_classification) min->extended_classification = other_min->extended_classification;
+  if (other_max->extended_classification > max->extended_classification) max->extended_classification = other_max->extended_classification;
+  if (other_min->extended_return_number < min->extended_return_number) min->extended_return_number = other_min->extended_return_number;
+  if (other_max->extended_return_number > max->extended_return_number) max->extended_return_number = other_max->extended_return_number;
+  if (other_min->extended_number_of_returns < min->extended_number_of_returns) min->extended_number_of_returns = other_min->extended_number_of_returns;
+  if (other_max->extended_number_of_returns > max->extended_number_of_returns) max->extended_number_of_returns = other_max->extended_number_of_returns;
+  if (other_min->extended_scan_angle < min->extended_scan_angle) min->extended_scan_angle = other_min->extended_scan_angle;
+  if (other_max->extended_scan_angle > max->extended_scan_angle) max->extended_scan_angle = other_max->extended_scan_angle;
+  if (other_min->extended_scanner_channel < min->extended_scanner_channel) min->extended_scanner_channel = other_min->extended_scanner_channel;
+  if (other_max->extended_scanner_channel > max->extended_scanner_channel) max->extended_scanner_channel = other_max->extended_scanner_channel;
+  if (other_min->wavepacket.getIndex() < min->wavepacket.getIndex()) min->wavepacket.setIndex(other_min->wavepacket.getIndex());
+  if (other_max->wavepacket.getIndex() > max->wavepacket.getIndex()) max->wavepacket.setIndex(other_max->wavepacket.getIndex());
+  if (other_min->wavepacket.getOffset() < min->wavepacket.getOffset()) min->wavepacket.setOffset(other_min->wavepacket.getOffset());
+  if (other_max->wavepacket.getOffset() > max->wavepacket.getOffset()) max->wavepacket.setOffset(other_max->wavepacket.getOffset());
+  if (other_min->wavepacket.getSize() < min->wavepacket.getSize()) min->wavepacket.setSize(other_min->wavepacket.getSize());
+  if (other_max->wavepacket.getSize() > max->wavepacket.getSize()) max->wavepacket.setSize(other_max->wavepacket.getSize());
+  if (other_min->wavepacket.getLocation() < min->wavepacket.getLocation()) min->wavepacket.setLocation(other_min->wavepacket.getLocation());
+  if (other_max->wavepacket.getLocation() > max->wavepacket.getLocation()) max->wavepacket.setLocation(other_max->wavepacket.getLocation());
+  if (other_min->wavepacket.getXt() < min->wavepacket.getXt()) min->wavepacket.setXt(other_min->wavepacket.getXt());
+  if (other_max->wavepacket.getXt() > max->wavepacket.getXt()) max->wavepacket.setXt(other_max->wavepacket.getXt());
+  if (other_min->wavepacket.getYt() < min->wavepacket.getYt()) min->wavepacket.setYt(other_min->wavepacket.getYt());
+  if (other_max->wavepacket.getYt() > max->wavepacket.getYt()) max->wavepacket.setYt(other_max->wavepacket.getYt());
+  if (other_min->wavepacket.getZt() < min->wavepacket.getZt()) min->wavepacket.setZt(other_min->wavepacket.getZt());
+  if (other_max->wavepacket.getZt() > max->wavepacket.getZt()) max->wavepacket.setZt(other_max->wavepacket.getZt());
+}
+
+BOOL LASsummary::merge(const LASsummary* summary, const LASattributer* attributer)
+{
+  if (summary->first) return TRUE;
+  U32 i;
+  number_of_point_records += summary->number_of_point_records;
+  for (i = 0; i < 16; i++) number_of_points_by_return[i] += summary->number_of_points_by_return[i];
+  for (i = 0; i < 16; i++) number_of_returns[i] += summary->number_of_returns[i];
+  for (i = 0; i < 32; i++) classification[i] += summary->classification[i];
+  for (i = 0; i < 256; i++)
+  {
+    extended_classification[i] += summary->extended_classification[i];
+    flagged_synthetic_classification[i] += summary->flagged_synthetic_classification[i];
+    flagged_keypoint_classification[i] += summary->flagged_keypoint_classification[i];
+    flagged_withheld_classification[i] += summary->flagged_withheld_classification[i];
+    flagged_extended_overlap_classification[i] += summary->flagged_extended_overlap_classification[i];
+  }
+  flagged_synthetic += summary->flagged_synthetic;
+  flagged_keypoint += summary->flagged_keypoint;
+  flagged_withheld += summary->flagged_withheld;
+  flagged_extended_overlap += summary->flagged_extended_overlap;
+  if (first)
+  {
+    copy_min_max(&min, &summary->min);
+    copy_min_max(&max, &summary->max);
+    if (summary->min.extra_bytes_number)
+    {
+      min.extra_bytes = new U8[summary->min.extra_bytes_number];
+      min.extra_bytes_number = summary->min.extra_bytes_number;
+      memcpy(min.extra_bytes, summary->min.extra_bytes, min.extra_bytes_number);
+      max.extra_bytes = new U8[summary->max.extra_bytes_number];
+      max.extra_bytes_number = summary->max.extra_bytes_number;
+      memcpy(max.extra_bytes, summary->max.extra_bytes, max.extra_bytes_number);
+    }
+    for (i = 0; i < 3; i++)
+    {
+      xyz_low_digits_10[i] = summary->xyz_low_digits_10[i];
+      xyz_low_digits_100[i] = summary->xyz_low_digits_100[i];
+      xyz_low_digits_1000[i] = summary->xyz_low_digits_1000[i];
+      xyz_low_digits_10000[i] = summary->xyz_low_digits_10000[i];
+      xyz_fluff_10[i] = summary->xyz_fluff_10[i];
+      xyz_fluff_100[i] = summary->xyz_fluff_100[i];
+      xyz_fluff_1000[i] = summary->xyz_fluff_1000[i];
+      xyz_fluff_10000[i] = summary->xyz_fluff_10000[i];
+    }
+    first = FALSE;
+  }
+  else
+  {
+    merge_min_max(&min, &max, &summary->min, &summary->max);
+    if (attributer && min.extra_bytes && summary->min.extra_bytes)
+    {
+      I32 a;
+      for (a = 0; a < attributer->number_attributes; a++)
+      {
+        I32 start = attributer->attribute_starts[a];
+        I32 size = attributer->attribute_sizes[a];
+        if (attributer->attributes[a].get_value_as_float(summary->min.extra_bytes + start) < attributer->attributes[a].get_value_as_float(min.extra_bytes + start))
+        {
+          memcpy(min.extra_bytes + start, summary->min.extra_bytes + start, size);
+        }
+        if (attributer->attributes[a].get_value_as_float(summary->max.extra_bytes + start) > attributer->attributes[a].get_value_as_float(max.extra_bytes + start))
+        {
+          memcpy(max.extra_bytes + start, summary->max.extra_bytes + start, size);
+        }
+      }
+    }
+    // only when the other summary counted against the same low digits (see set_fluff_reference()) are its
+    // counts those of one pass. otherwise its first point has other digits so it cannot all be fluff
+    for (i = 0; i < 3; i++)
+    {
+      if (summary->xyz_low_digits_10[i] != xyz_low_digits_10[i]) continue;
+      xyz_fluff_10[i] += summary->xyz_fluff_10[i];
+      if (summary->xyz_low_digits_100[i] != xyz_low_digits_100[i]) continue;
+      xyz_fluff_100[i] += summary->xyz_fluff_100[i];
+      if (summary->xyz_low_digits_1000[i] != xyz_low_digits_1000[i]) continue;
+      xyz_fluff_1000[i] += summary->xyz_fluff_1000[i];
+      if (summary->xyz_low_digits_10000[i] != xyz_low_digits_10000[i]) continue;
+      xyz_fluff_10000[i] += summary->xyz_fluff_10000[i];
+    }
+  }
+  return TRUE;
+}
+
 F64 LASbin::get_step() const
 {
   return step;
@@ -396,6 +600,7 @@ F64 LASbin::get_step() const
 LASbin::LASbin(F64 step, F64 clamp_min, F64 clamp_max)
 {
   total = 0;
+  total_error = 0;
   count = 0;
   this->step = step;
   this->one_over_step = 1.0/step;
@@ -445,12 +650,24 @@ void LASbin::add(F64 item)
   {
     item = clamp_min;
   }
-  total += item;
+  add_to_total(item);
   count++;
   I32 bin = I32_FLOOR(one_over_step*item);
   add_to_bin(bin);
 }
 
+// keeps the rounding error of the sum so that its value does not depend on the order of the items (as
+// when the totals of bins that were filled in parallel are merged)
+void LASbin::add_to_total(F64 item)
+{
+  F64 sum = total + item;
+  if (fabs(total) >= fabs(item))
+    total_error += (total - sum) + item;
+  else
+    total_error += (item - sum) + total;
+  total = sum;
+}
+
 void LASbin::add(I64 item)
 {
   if (item > clamp_max)
@@ -652,7 +869,7 @@ void LASbin::add(F64 item, F64 value)
 {
 #pragma warning(push)
 #pragma warning(disable : 6011)
-  total += item;
+  add_to_total(item);
   count++;
   I32 bin = I32_FLOOR(one_over_step*item);
   if (first)
@@ -786,6 +1003,83 @@ static void lidardouble2string(CHAR* string, F64 value, F64 precision)
     lidardouble2string(string, value);
 }
 
+void LASbin::add_to_bin(I32 bin, U32 number, const F64* value)
+{
+  if (first)
+  {
+    anker = bin;
+    first = FALSE;
+  }
+  bin = bin - anker;
+  U32** bins = &bins_pos;
+  F64** values = &values_pos;
+  I32* size = &size_pos;
+  if (bin < 0)
+  {
+    bin = -(bin+1);
+    bins = &bins_neg;
+    values = &values_neg;
+    size = &size_neg;
+  }
+  I32 i;
+  if (bin >= *size)
+  {
+    I32 new_size = bin + 1024;
+    *bins = (U32*)realloc_las(*bins, sizeof(U32)*new_size);
+    if (*bins == 0)
+    {
+      laserror("reallocating %u bins", new_size);
+      byebye();
+    }
+    for (i = *size; i < new_size; i++) (*bins)[i] = 0;
+    if (*values)
+    {
+      *values = (F64*)realloc_las(*values, sizeof(F64)*new_size);
+      if (*values == 0)
+      {
+        laserror("reallocating %u values", new_size);
+        byebye();
+      }
+      for (i = *size; i < new_size; i++) (*values)[i] = 0;
+    }
+    *size = new_size;
+  }
+  if (value && (*values == 0))
+  {
+    *values = (F64*)malloc(sizeof(F64)*(*size));
+    if (*values == 0)
+    {
+      laserror("allocating %u values", *size);
+      byebye();
+    }
+    for (i = 0; i < *size; i++) (*values)[i] = 0;
+  }
+  (*bins)[bin] += number;
+  if (value) (*values)[bin] += *value;
+}
+
+void LASbin::merge(const LASbin* bin)
+{
+  I32 i;
+  add_to_total(bin->total);
+  total_error += bin->total_error;
+  count += bin->count;
+  // the bins of the other one are added in the order of their position so that the first one to be
+  // added is its anker. for the first merge into an empty bin this makes it the same anker
+  if (bin->size_pos && bin->bins_pos[0])
+  {
+    add_to_bin(bin->anker, bin->bins_pos[0], (bin->values_pos ? &bin->values_pos[0] : 0));
+  }
+  for (i = bin->size_neg-1; i >= 0; i--)
+  {
+    if (bin->bins_neg[i]) add_to_bin(-(i+1) + bin->anker, bin->bins_neg[i], (bin->values_neg ? &bin->values_neg[i] : 0));
+  }
+  for (i = 1; i < bin->size_pos; i++)
+  {
+    if (bin->bins_pos[i]) add_to_bin(i + bin->anker, bin->bins_pos[i], (bin->values_pos ? &bin->values_pos[i] : 0));
+  }
+}
+
 void LASbin::report(FILE* file, const CHAR* name, const CHAR* name_avg) const
 {
   I32 i, bin;
@@ -857,7 +1151,7 @@ void LASbin::report(FILE* file, const CHAR* name, const CHAR* name_avg) const
   }
   if (count)
   {
-    lidardouble2string(temp1, total/count, step);
+    lidardouble2string(temp1, (total+total_error)/count, step);
     if (name)
       fprintf(file, "  average %s %s for %lld element(s)\012", name, temp1, count);
     else
@@ -870,6 +1164,7 @@ void LASbin::reset()
   first = TRUE;
   count = 0;
   total = 0.0;
+  total_error = 0.0;
   if (size_pos)
   {
     memset(bins_pos, 0, sizeof(U32)*size_pos);
@@ -1196,6 +1491,54 @@ BOOL LAShistogram::histo_avg(const CHAR* name, F64 step, const CHAR* name_avg)
   return TRUE;
 }
 
+BOOL LAShistogram::setup(const LAShistogram* histogram)
+{
+  // counter bins
+  if (histogram->x_bin) x_bin = new LASbin(histogram->x_bin->get_step(), histogram->x_bin->get_clamp_min(), histogram->x_bin->get_clamp_max());
+  if (histogram->y_bin) y_bin = new LASbin(histogram->y_bin->get_step(), histogram->y_bin->get_clamp_min(), histogram->y_bin->get_clamp_max());
+  if (histogram->z_bin) z_bin = new LASbin(histogram->z_bin->get_step(), histogram->z_bin->get_clamp_min(), histogram->z_bin->get_clamp_max());
+  if (histogram->X_bin) X_bin = new LASbin(histogram->X_bin->get_step(), histogram->X_bin->get_clamp_min(), histogram->X_bin->get_clamp_max());
+  if (histogram->Y_bin) Y_bin = new LASbin(histogram->Y_bin->get_step(), histogram->Y_bin->get_clamp_min(), histogram->Y_bin->get_clamp_max());
+  if (histogram->Z_bin) Z_bin = new LASbin(histogram->Z_bin->get_step(), histogram->Z_bin->get_clamp_min(), histogram->Z_bin->get_clamp_max());
+  if (histogram->intensity_bin) intensity_bin = new LASbin(histogram->intensity_bin->get_step(), histogram->intensity_bin->get_clamp_min(), histogram->intensity_bin->get_clamp_max());
+  if (histogram->classification_bin) classification_bin = new LASbin(histogram->classification_bin->get_step(), histogram->classification_bin->get_clamp_min(), histogram->classification_bin->get_clamp_max());
+  if (histogram->scan_angle_bin) scan_angle_bin = new LASbin(histogram->scan_angle_bin->get_step(), histogram->scan_angle_bin->get_clamp_min(), histogram->scan_angle_bin->get_clamp_max());
+  if (histogram->extended_scan_angle_bin) extended_scan_angle_bin = new LASbin(histogram->extended_scan_angle_bin->get_step(), histogram->extended_scan_angle_bin->get_clamp_min(), histogram->extended_scan_angle_bin->get_clamp_max());
+  if (histogram->return_number_bin) return_number_bin = new LASbin(histogram->return_number_bin->get_step(), histogram->return_number_bin->get_clamp_min(), histogram->return_number_bin->get_clamp_max());
+  if (histogram->number_of_returns_bin) number_of_returns_bin = new LASbin(histogram->number_of_returns_bin->get_step(), histogram->number_of_returns_bin->get_clamp_min(), histogram->number_of_returns_bin->get_clamp_max());
+  if (histogram->user_data_bin) user_data_bin = new LASbin(histogram->user_data_bin->get_step(), histogram->user_data_bin->get_clamp_min(), histogram->user_data_bin->get_clamp_max());
+  if (histogram->point_source_id_bin) point_source_id_bin = new LASbin(histogram->point_source_id_bin->get_step(), histogram->point_source_id_bin->get_clamp_min(), histogram->point_source_id_bin->get_clamp_max());
+  if (histogram->gps_time_bin) gps_time_bin = new LASbin(histogram->gps_time_bin->get_step(), histogram->gps_time_bin->get_clamp_min(), histogram->gps_time_bin->get_clamp_max());
+  if (histogram->scanner_channel_bin) scanner_channel_bin = new LASbin(histogram->scanner_channel_bin->get_step(), histogram->scanner_channel_bin->get_clamp_min(), histogram->scanner_channel_bin->get_clamp_max());
+  if (histogram->R_bin) R_bin = new LASbin(histogram->R_bin->get_step(), histogram->R_bin->get_clamp_min(), histogram->R_bin->get_clamp_max());
+  if (histogram->G_bin) G_bin = new LASbin(histogram->G_bin->get_step(), histogram->G_bin->get_clamp_min(), histogram->G_bin->get_clamp_max());
+  if (histogram->B_bin) B_bin = new LASbin(histogram->B_bin->get_step(), histogram->B_bin->get_clamp_min(), histogram->B_bin->get_clamp_max());
+  if (histogram->I_bin) I_bin = new LASbin(histogram->I_bin->get_step(), histogram->I_bin->get_clamp_min(), histogram->I_bin->get_clamp_max());
+  if (histogram->attribute0_bin) attribute0_bin = new LASbin(histogram->attribute0_bin->get_step(), histogram->attribute0_bin->get_clamp_min(), histogram->attribute0_bin->get_clamp_max());
+  if (histogram->attribute1_bin) attribute1_bin = new LASbin(histogram->attribute1_bin->get_step(), histogram->attribute1_bin->get_clamp_min(), histogram->attribute1_bin->get_clamp_max());
+  if (histogram->attribute2_bin) attribute2_bin = new LASbin(histogram->attribute2_bin->get_step(), histogram->attribute2_bin->get_clamp_min(), histogram->attribute2_bin->get_clamp_max());
+  if (histogram->attribute3_bin) attribute3_bin = new LASbin(histogram->attribute3_bin->get_step(), histogram->attribute3_bin->get_clamp_min(), histogram->attribute3_bin->get_clamp_max());
+  if (histogram->attribute4_bin) attribute4_bin = new LASbin(histogram->attribute4_bin->get_step(), histogram->attribute4_bin->get_clamp_min(), histogram->attribute4_bin->get_clamp_max());
+  if (histogram->attribute5_bin) attribute5_bin = new LASbin(histogram->attribute5_bin->get_step(), histogram->attribute5_bin->get_clamp_min(), histogram->attribute5_bin->get_clamp_max());
+  if (histogram->attribute6_bin) attribute6_bin = new LASbin(histogram->attribute6_bin->get_step(), histogram->attribute6_bin->get_clamp_min(), histogram->attribute6_bin->get_clamp_max());
+  if (histogram->attribute7_bin) attribute7_bin = new LASbin(histogram->attribute7_bin->get_step(), histogram->attribute7_bin->get_clamp_min(), histogram->attribute7_bin->get_clamp_max());
+  if (histogram->attribute8_bin) attribute8_bin = new LASbin(histogram->attribute8_bin->get_step(), histogram->attribute8_bin->get_clamp_min(), histogram->attribute8_bin->get_clamp_max());
+  if (histogram->attribute9_bin) attribute9_bin = new LASbin(histogram->attribute9_bin->get_step(), histogram->attribute9_bin->get_clamp_min(), histogram->attribute9_bin->get_clamp_max());
+  if (histogram->wavepacket_index_bin) wavepacket_index_bin = new LASbin(histogram->wavepacket_index_bin->get_step(), histogram->wavepacket_index_bin->get_clamp_min(), histogram->wavepacket_index_bin->get_clamp_max());
+  if (histogram->wavepacket_offset_bin) wavepacket_offset_bin = new LASbin(histogram->wavepacket_offset_bin->get_step(), histogram->wavepacket_offset_bin->get_clamp_min(), histogram->wavepacket_offset_bin->get_clamp_max());
+  if (histogram->wavepacket_size_bin) wavepacket_size_bin = new LASbin(histogram->wavepacket_size_bin->get_step(), histogram->wavepacket_size_bin->get_clamp_min(), histogram->wavepacket_size_bin->get_clamp_max());
+  if (histogram->wavepacket_location_bin) wavepacket_location_bin = new LASbin(histogram->wavepacket_location_bin->get_step(), histogram->wavepacket_location_bin->get_clamp_min(), histogram->wavepacket_location_bin->get_clamp_max());
+  // averages bins
+  if (histogram->classification_bin_intensity) classification_bin_intensity = new LASbin(histogram->classification_bin_intensity->get_step(), histogram->classification_bin_intensity->get_clamp_min(), histogram->classification_bin_intensity->get_clamp_max());
+  if (histogram->classification_bin_scan_angle) classification_bin_scan_angle = new LASbin(histogram->classification_bin_scan_angle->get_step(), histogram->classification_bin_scan_angle->get_clamp_min(), histogram->classification_bin_scan_angle->get_clamp_max());
+  if (histogram->scan_angle_bin_z) scan_angle_bin_z = new LASbin(histogram->scan_angle_bin_z->get_step(), histogram->scan_angle_bin_z->get_clamp_min(), histogram->scan_angle_bin_z->get_clamp_max());
+  if (histogram->scan_angle_bin_number_of_returns) scan_angle_bin_number_of_returns = new LASbin(histogram->scan_angle_bin_number_of_returns->get_step(), histogram->scan_angle_bin_number_of_returns->get_clamp_min(), histogram->scan_angle_bin_number_of_returns->get_clamp_max());
+  if (histogram->scan_angle_bin_intensity) scan_angle_bin_intensity = new LASbin(histogram->scan_angle_bin_intensity->get_step(), histogram->scan_angle_bin_intensity->get_clamp_min(), histogram->scan_angle_bin_intensity->get_clamp_max());
+  if (histogram->return_map_bin_intensity) return_map_bin_intensity = new LASbin(histogram->return_map_bin_intensity->get_step(), histogram->return_map_bin_intensity->get_clamp_min(), histogram->return_map_bin_intensity->get_clamp_max());
+  is_active = histogram->is_active;
+  return TRUE;
+}
+
 void LAShistogram::add(const LASpoint* point)
 {
   // counter bins
@@ -1265,6 +1608,52 @@ void LAShistogram::add(const LASpoint* point)
   }
 }
 
+void LAShistogram::merge(const LAShistogram* histogram)
+{
+  // counter bins
+  if (x_bin && histogram->x_bin) x_bin->merge(histogram->x_bin);
+  if (y_bin && histogram->y_bin) y_bin->merge(histogram->y_bin);
+  if (z_bin && histogram->z_bin) z_bin->merge(histogram->z_bin);
+  if (X_bin && histogram->X_bin) X_bin->merge(histogram->X_bin);
+  if (Y_bin && histogram->Y_bin) Y_bin->merge(histogram->Y_bin);
+  if (Z_bin && histogram->Z_bin) Z_bin->merge(histogram->Z_bin);
+  if (intensity_bin && histogram->intensity_bin) intensity_bin->merge(histogram->intensity_bin);
+  if (classification_bin && histogram->classification_bin) classification_bin->merge(histogram->classification_bin);
+  if (scan_angle_bin && histogram->scan_angle_bin) scan_angle_bin->merge(histogram->scan_angle_bin);
+  if (extended_scan_angle_bin && histogram->extended_scan_angle_bin) extended_scan_angle_bin->merge(histogram->extended_scan_angle_bin);
+  if (return_number_bin && histogram->return_number_bin) return_number_bin->merge(histogram->return_number_bin);
+  if (number_of_returns_bin && histogram->number_of_returns_bin) number_of_returns_bin->merge(histogram->number_of_returns_bin);
+  if (user_data_bin && histogram->user_data_bin) user_data_bin->merge(histogram->user_data_bin);
+  if (point_source_id_bin && histogram->point_source_id_bin) point_source_id_bin->merge(histogram->point_source_id_bin);
+  if (gps_time_bin && histogram->gps_time_bin) gps_time_bin->merge(histogram->gps_time_bin);
+  if (scanner_channel_bin && histogram->scanner_channel_bin) scanner_channel_bin->merge(histogram->scanner_channel_bin);
+  if (R_bin && histogram->R_bin) R_bin->merge(histogram->R_bin);
+  if (G_bin && histogram->G_bin) G_bin->merge(histogram->G_bin);
+  if (B_bin && histogram->B_bin) B_bin->merge(histogram->B_bin);
+  if (I_bin && histogram->I_bin) I_bin->merge(histogram->I_bin);
+  if (attribute0_bin && histogram->attribute0_bin) attribute0_bin->merge(histogram->attribute0_bin);
+  if (attribute1_bin && histogram->attribute1_bin) attribute1_bin->merge(histogram->attribute1_bin);
+  if (attribute2_bin && histogram->attribute2_bin) attribute2_bin->merge(histogram->attribute2_bin);
+  if (attribute3_bin && histogram->attribute3_bin) attribute3_bin->merge(histogram->attribute3_bin);
+  if (attribute4_bin && histogram->attribute4_bin) attribute4_bin->merge(histogram->attribute4_bin);
+  if (attribute5_bin && histogram->attribute5_bin) attribute5_bin->merge(histogram->attribute5_bin);
+  if (attribute6_bin && histogram->attribute6_bin) attribute6_bin->merge(histogram->attribute6_bin);
+  if (attribute7_bin && histogram->attribute7_bin) attribute7_bin->merge(histogram->attribute7_bin);
+  if (attribute8_bin && histogram->attribute8_bin) attribute8_bin->merge(histogram->attribute8_bin);
+  if (attribute9_bin && histogram->attribute9_bin) attribute9_bin->merge(histogram->attribute9_bin);
+  if (wavepacket_index_bin && histogram->wavepacket_index_bin) wavepacket_index_bin->merge(histogram->wavepacket_index_bin);
+  if (wavepacket_offset_bin && histogram->wavepacket_offset_bin) wavepacket_offset_bin->merge(histogram->wavepacket_offset_bin);
+  if (wavepacket_size_bin && histogram->wavepacket_size_bin) wavepacket_size_bin->merge(histogram->wavepacket_size_bin);
+  if (wavepacket_location_bin && histogram->wavepacket_location_bin) wavepacket_location_bin->merge(histogram->wavepacket_location_bin);
+  // averages bins
+  if (classification_bin_intensity && histogram->classification_bin_intensity) classification_bin_intensity->merge(histogram->classification_bin_intensity);
+  if (classification_bin_scan_angle && histogram->classification_bin_scan_angle) classification_bin_scan_angle->merge(histogram->classification_bin_scan_angle);
+  if (scan_angle_bin_z && histogram->scan_angle_bin_z) scan_angle_bin_z->merge(histogram->scan_angle_bin_z);
+  if (scan_angle_bin_number_of_returns && histogram->scan_angle_bin_number_of_returns) scan_angle_bin_number_of_returns->merge(histogram->scan_angle_bin_number_of_returns);
+  if (scan_angle_bin_intensity && histogram->scan_angle_bin_intensity) scan_angle_bin_intensity->merge(histogram->scan_angle_bin_intensity);
+  if (return_map_bin_intensity && histogram->return_map_bin_intensity) return_map_bin_intensity->merge(histogram->return_map_bin_intensity);
+}
+
 void LAShistogram::report(FILE* file) const
 {
   // counter bins
@@ -1657,6 +2046,47 @@ void LASoccupancyGrid::reset()
 #pragma warning(pop)
 }
 
+BOOL LASoccupancyGrid::merge(const LASoccupancyGrid* grid)
+{
+  if (!grid->active()) return TRUE;
+  if (active() ? (grid_spacing != grid->grid_spacing) : (-grid_spacing != grid->grid_spacing))
+  {
+    laserror("cannot merge occupancy grid with spacing %g into one with spacing %g", grid->grid_spacing, (active() ? grid_spacing : -grid_spacing));
+    return FALSE;
+  }
+  // visit the occupied cells of all four quadrants of the banded grid in their absolute positions
+  U32 y, w, b;
+  for (y = 0; y < grid->plus_plus_size; y++)
+  {
+    for (w = 0; w < grid->plus_plus_sizes[y]; w++)
+    {
+      if (grid->plus_plus[y][w]) for (b = 0; b < 32; b++) if (grid->plus_plus[y][w] & (1u << b)) add(grid->plus_ankers[y] + (I32)(32*w+b), grid->anker + (I32)y);
+    }
+  }
+  for (y = 0; y < grid->plus_minus_size; y++)
+  {
+    for (w = 0; w < grid->plus_minus_sizes[y]; w++)
+    {
+      if (grid->plus_minus[y][w]) for (b = 0; b < 32; b++) if (grid->plus_minus[y][w] & (1u << b)) add(grid->plus_ankers[y] - (I32)(32*w+b) - 1, grid->anker + (I32)y);
+    }
+  }
+  for (y = 0; y < grid->minus_plus_size; y++)
+  {
+    for (w = 0; w < grid->minus_plus_sizes[y]; w++)
+    {
+      if (grid->minus_plus[y][w]) for (b = 0; b < 32; b++) if (grid->minus_plus[y][w] & (1u << b)) add(grid->minus_ankers[y] + (I32)(32*w+b), grid->anker - (I32)y - 1);
+    }
+  }
+  for (y = 0; y < grid->minus_minus_size; y++)
+  {
+    for (w = 0; w < grid->minus_minus_sizes[y]; w++)
+    {
+      if (grid->minus_minus[y][w]) for (b = 0; b < 32; b++) if (grid->minus_minus[y][w] & (1u << b)) add(grid->minus_ankers[y] - (I32)(32*w+b) - 1, grid->anker - (I32)y - 1);
+    }
+  }
+  return TRUE;
+}
+
 BOOL LASoccupancyGrid::write_asc_grid(const CHAR* file_name) const
 {
   FILE* file = LASfopen(file_name, "w");
@@ -76,6 +76,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
         delete laswriterlas;
         return 0;
       }
+      if ((format == LAS_TOOLS_FORMAT_LAZ) && (compress_threads > 1)) laswriterlas->set_compress_threads(compress_threads);
       return laswriterlas;
     }
     else if (format == LAS_TOOLS_FORMAT_TXT)
@@ -142,6 +143,7 @@ LASwriter* LASwriteOpener::open(const LASheader* header)
         delete laswriterlas;
         return 0;
       }
+      if ((format == LAS_TOOLS_FORMAT_LAZ) && (compress_threads > 1)) laswriterlas->set_compress_threads(compress_threads);
       return laswriterlas;
     }
     else if (format == LAS_TOOLS_FORMAT_TXT)
@@ -231,6 +233,7 @@ void LASwriteOpener::usage() const
                        "  -odix _classified (specify file name appendix)\n" \
                        "  -ocut 2 (cut the last two characters from name)\n" \
                        "  -olas -olaz -otxt -obin -oqi (specify format)\n" \
+                       "  -compress_threads 4 (LAZ chunks in parallel)\n" \
                        "  -stdout (pipe to stdout)\n" \
                        "  -nil    (pipe to NULL)\n", DIRECTORY_SLASH, DIRECTORY_SLASH);
 }
@@ -371,6 +374,27 @@ BOOL LASwriteOpener::parse(int argc, char* argv[])
       set_chunk_size(atoi(argv[i+1]));
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
+    else if (strcmp(argv[i],"-compress_threads") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+        return FALSE;
+      }
+      I32 number;
+      if (sscanf(argv[i+1], "%d", &number) != 1)
+      {
+        laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i+1]);
+        return FALSE;
+      }
+      if (number <= 0)
+      {
+        laserror("'%s' needs 1 argument: number but %d is not valid.", argv[i], number);
+        return FALSE;
+      }
+      set_compress_threads((U32)number);
+      *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
+    }
     else if (strcmp(argv[i],"-oparse") == 0)
     {
       if ((i+1) >= argc)
@@ -788,6 +812,11 @@ void LASwriteOpener::set_chunk_size(U32 chunk_size)
   this->chunk_size = chunk_size;
 }
 
+void LASwriteOpener::set_compress_threads(U32 compress_threads)
+{
+  this->compress_threads = compress_threads;
+}
+
 void LASwriteOpener::make_numbered_file_name(const CHAR* file_name, I32 digits)
 {
   I32 len;
@@ -1240,6 +1269,7 @@ LASwriteOpener::LASwriteOpener()
   specified = FALSE;
   force = FALSE;
   chunk_size = LASZIP_CHUNK_SIZE_DEFAULT;
+  compress_threads = 1;
   use_stdout = FALSE;
   use_nil = FALSE;
 }
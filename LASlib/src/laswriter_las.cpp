@@ -890,6 +890,12 @@ BOOL LASwriterLAS::open(ByteStreamOut* stream, const LASheader* header, U32 comp
   return TRUE;
 }
 
+BOOL LASwriterLAS::set_compress_threads(const U32 num_threads)
+{
+  if (writer == 0) return FALSE;
+  return writer->set_threads(num_threads);
+}
+
 BOOL LASwriterLAS::write_point(const LASpoint* point)
 {
   p_count++;
@@ -1382,6 +1388,18 @@ I64 LASwriterLAS::tell()
   return stream->tell();
 }
 
+BOOL LASwriterLAS::sync()
+{
+  if (writer == 0) return FALSE;
+  return writer->sync();
+}
+
+BOOL LASwriterLAS::get_chunk_bytes(const U32 index, U32& bytes) const
+{
+  if (writer == 0) return FALSE;
+  return writer->get_chunk_bytes(index, bytes);
+}
+
 LASwriterLAS::LASwriterLAS()
 {
   file = 0;
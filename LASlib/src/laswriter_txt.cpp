@@ -32,11 +32,16 @@
 
 #include "lasmessage.hpp"
 
+#include <cmath>
 #include <stdlib.h>
 #include <string.h>
 
+// the formatted lines are written with one fwrite() once this many bytes have come together
+#define LAS_WRITER_TXT_BUFFER_SIZE (1 << 20)
+
 BOOL LASwriterTXT::refile(FILE* file)
 {
+  if (this->file && !flush()) return FALSE;
   this->file = file;
   return TRUE;
 }
@@ -256,47 +261,73 @@ BOOL LASwriterTXT::open(FILE* file, const LASheader* header, const CHAR* parse_s
     }
   }
 
-  return check_parse_string(this->parse_string);
+  if (!check_parse_string(this->parse_string))
+  {
+    return FALSE;
+  }
+
+  // no field of a line is longer than the 330 characters of a very large double with 15 decimals
+
+  line_size = 352 * strlen(this->parse_string) + 2;
+  if (buffer) free(buffer);
+  buffer = (CHAR*)malloc(LAS_WRITER_TXT_BUFFER_SIZE + line_size);
+  buffer_size = 0;
+  if (buffer == 0)
+  {
+    laserror("allocating %u bytes for text buffer", (U32)(LAS_WRITER_TXT_BUFFER_SIZE + line_size));
+    return FALSE;
+  }
+
+  return TRUE;
 }
 
-static void lidardouble2string(CHAR* string, double value)
+static CHAR* lidardouble2string(CHAR* string, double value)
 {
-  int len;
-  len = sprintf(string, "%.15f", value) - 1;
-  while (string[len] == '0') len--;
-  if (string[len] != '.') len++;
-  string[len] = '\0';
+  CHAR* end = dtoa_las(string, value, 15);
+  while (end[-1] == '0') end--;
+  if (end[-1] == '.') end--;
+  return end;
 }
 
-static void lidardouble2string(CHAR* string, double value, double precision)
+static CHAR* lidardouble2string(CHAR* string, double value, double precision)
 {
   if (precision == 0.1)
-    sprintf(string, "%.1f", value);
+    return dtoa_las(string, value, 1);
   else if (precision == 0.01)
-    sprintf(string, "%.2f", value);
+    return dtoa_las(string, value, 2);
   else if (precision == 0.001)
-    sprintf(string, "%.3f", value);
+    return dtoa_las(string, value, 3);
   else if (precision == 0.0001)
-    sprintf(string, "%.4f", value);
+    return dtoa_las(string, value, 4);
   else if (precision == 0.00001)
-    sprintf(string, "%.5f", value);
+    return dtoa_las(string, value, 5);
   else if (precision == 0.000001)
-    sprintf(string, "%.6f", value);
+    return dtoa_las(string, value, 6);
   else if (precision == 0.0000001)
-    sprintf(string, "%.7f", value);
+    return dtoa_las(string, value, 7);
   else if (precision == 0.00000001)
-    sprintf(string, "%.8f", value);
+    return dtoa_las(string, value, 8);
   else if (precision == 0.000000001)
-    sprintf(string, "%.9f", value);
+    return dtoa_las(string, value, 9);
   else
-    lidardouble2string(string, value);
+    return lidardouble2string(string, value);
+}
+
+// same as printf's "%g" but without the formatting overhead for the many values that are integral
+static CHAR* lidardouble2string_g(CHAR* string, double value)
+{
+  if ((value > -1000000.0) && (value < 1000000.0) && (value == (double)(I32)value) && ((value != 0.0) || !std::signbit(value)))
+  {
+    return itoa_las(string, (I32)value);
+  }
+  return string + snprintf(string, 32, "%g", value);
 }
 
-BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
+CHAR* LASwriterTXT::unparse_attribute(CHAR* out, const LASpoint* point, I32 index)
 {
   if (index >= header->number_attributes)
   {
-    return FALSE;
+    return out;
   }
   if (header->attributes[index].data_type == 1)
   {
@@ -305,11 +336,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      return itoa_las(out, (I32)value);
     }
   }
   else if (header->attributes[index].data_type == 2)
@@ -319,11 +350,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      return itoa_las(out, (I32)value);
     }
   }
   else if (header->attributes[index].data_type == 3)
@@ -333,11 +364,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      return itoa_las(out, (I32)value);
     }
   }
   else if (header->attributes[index].data_type == 4)
@@ -347,11 +378,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      return itoa_las(out, (I32)value);
     }
   }
   else if (header->attributes[index].data_type == 5)
@@ -361,11 +392,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", (I32)value);
+      return itoa_las(out, (I32)value);
     }
   }
   else if (header->attributes[index].data_type == 6)
@@ -375,11 +406,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%d", value);
+      return itoa_las(out, value);
     }
   }
   else if (header->attributes[index].data_type == 9)
@@ -389,11 +420,11 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%g", value);
+      return lidardouble2string_g(out, value);
     }
   }
   else if (header->attributes[index].data_type == 10)
@@ -403,161 +434,170 @@ BOOL LASwriterTXT::unparse_attribute(const LASpoint* point, I32 index)
     if (header->attributes[index].has_scale() || header->attributes[index].has_offset())
     {
       F64 temp_d = header->attributes[index].scale[0]*value + header->attributes[index].offset[0];
-      fprintf(file, "%g", temp_d);
+      return lidardouble2string_g(out, temp_d);
     }
     else
     {
-      fprintf(file, "%g", value);
+      return lidardouble2string_g(out, value);
     }
   }
   else
   {
     LASMessage(LAS_WARNING, "attribute %d not (yet) implemented.", index);
-    return FALSE;
   }
-  return TRUE;
+  return out;
 }
 
 BOOL LASwriterTXT::write_point(const LASpoint* point)
 {
   p_count++;
+  CHAR* out = buffer + buffer_size;
   int i = 0;
   while (true)
   {
     switch (parse_string[i])
     {
     case 'x': // the x coordinate
-      lidardouble2string(printstring, header->get_x(point->get_X()), header->x_scale_factor); fprintf(file, "%s", printstring);
+      out = lidardouble2string(out, header->get_x(point->get_X()), header->x_scale_factor);
       break;
     case 'y': // the y coordinate
-      lidardouble2string(printstring, header->get_y(point->get_Y()), header->y_scale_factor); fprintf(file, "%s", printstring);
+      out = lidardouble2string(out, header->get_y(point->get_Y()), header->y_scale_factor);
       break;
     case 'z': // the z coordinate
-      lidardouble2string(printstring, header->get_z(point->get_Z()), header->z_scale_factor); fprintf(file, "%s", printstring);
+      out = lidardouble2string(out, header->get_z(point->get_Z()), header->z_scale_factor);
       break;
     case 't': // the gps-time
-      fprintf(file, "%.6f", point->get_gps_time());
+      out = dtoa_las(out, point->get_gps_time(), 6);
       break;
     case 'i': // the intensity
       if (opts)
-        fprintf(file, "%d", -2048 + point->get_intensity());
+        out = itoa_las(out, -2048 + point->get_intensity());
       else if (optx)
       {
-        int len = snprintf(printstring, sizeof(printstring), "%.3f", 1.0f/4095.0f * point->get_intensity()) - 1;
-        while (printstring[len] == '0') len--;
-        if (printstring[len] != '.') len++;
-        printstring[len] = '\0';
-        fprintf(file, "%s", printstring);
+        out = dtoa_las(out, 1.0f/4095.0f * point->get_intensity(), 3);
+        while (out[-1] == '0') out--;
+        if (out[-1] == '.') out--;
       }
       else
-        fprintf(file, "%d", point->get_intensity());
+        out = itoa_las(out, point->get_intensity());
       break;
     case 'a': // the scan angle
-      fprintf(file, "%d", point->get_scan_angle_rank());
+      out = itoa_las(out, point->get_scan_angle_rank());
       break;
     case 'r': // the number of the return
-      fprintf(file, "%d", point->get_return_number());
+      out = itoa_las(out, point->get_return_number());
       break;
     case 'c': // the classification
-			if (header->point_data_format > 5)
-			{
-				if (point->get_extended_classification())
-				{
-      fprintf(file, "%d", point->get_extended_classification());
-				}
-				else
-				{
-					fprintf(file, "%d", point->get_classification());
-				}
-			}
-			else
-			{
-				fprintf(file, "%d", point->get_classification());
-			}
+      if ((header->point_data_format > 5) && point->get_extended_classification())
+        out = itoa_las(out, point->get_extended_classification());
+      else
+        out = itoa_las(out, point->get_classification());
       break;
     case 'u': // the user data
-      fprintf(file, "%d", point->get_user_data());
+      out = itoa_las(out, point->get_user_data());
       break;
     case 'n': // the number of returns of given pulse
-      fprintf(file, "%d", point->get_number_of_returns());
+      out = itoa_las(out, point->get_number_of_returns());
       break;
     case 'p': // the point source ID
-      fprintf(file, "%d", point->get_point_source_ID());
+      out = itoa_las(out, point->get_point_source_ID());
       break;
     case 'e': // the edge of flight line flag
-      fprintf(file, "%d", point->get_edge_of_flight_line());
+      out = itoa_las(out, point->get_edge_of_flight_line());
       break;
     case 'd': // the direction of scan flag
-      fprintf(file, "%d", point->get_scan_direction_flag());
+      out = itoa_las(out, point->get_scan_direction_flag());
       break;
     case 'h': // the withheld flag
-      fprintf(file, "%d", point->get_withheld_flag());
+      out = itoa_las(out, point->get_withheld_flag());
       break;
     case 'k': // the keypoint flag
-      fprintf(file, "%d", point->get_keypoint_flag());
+      out = itoa_las(out, point->get_keypoint_flag());
       break;
     case 'g': // the synthetic flag
-      fprintf(file, "%d", point->get_synthetic_flag());
+      out = itoa_las(out, point->get_synthetic_flag());
       break;
     case 'o': // the overlap flag
-      fprintf(file, "%d", point->get_extended_overlap_flag());
+      out = itoa_las(out, point->get_extended_overlap_flag());
       break;
     case 'l': // the scanner channel
-      fprintf(file, "%d", point->get_extended_scanner_channel());
+      out = itoa_las(out, point->get_extended_scanner_channel());
       break;
     case 'R': // the red channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_R());
+        out = dtoa_las(out, scale_rgb*point->get_R(), 2);
       else
-        fprintf(file, "%d", point->get_R());
+        out = itoa_las(out, point->get_R());
       break;
     case 'G': // the green channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_G());
+        out = dtoa_las(out, scale_rgb*point->get_G(), 2);
       else
-        fprintf(file, "%d", point->get_G());
+        out = itoa_las(out, point->get_G());
       break;
     case 'B': // the blue channel of the RGB field
       if (scale_rgb != 1.0f)
-        fprintf(file, "%.2f", scale_rgb*point->get_B());
+        out = dtoa_las(out, scale_rgb*point->get_B(), 2);
       else
-        fprintf(file, "%d", point->get_B());
+        out = itoa_las(out, point->get_B());
       break;
     case 'm': // the index of the point (count starts at 0)
-      fprintf(file, "%lld", p_count-1);
+      out = itoa_las(out, p_count-1);
       break;
     case 'M': // the index of the point (count starts at 1)
-      fprintf(file, "%lld", p_count);
+      out = itoa_las(out, p_count);
       break;
     case 'w': // the wavepacket descriptor index
-      fprintf(file, "%d", point->wavepacket.getIndex());
+      out = itoa_las(out, point->wavepacket.getIndex());
       break;
     case 'W': // all wavepacket attributes
-      fprintf(file, "%d%c%d%c%d%c%g%c%.15g%c%.15g%c%.15g", point->wavepacket.getIndex(), separator_sign, (U32)point->wavepacket.getOffset(), separator_sign, point->wavepacket.getSize(), separator_sign, point->wavepacket.getLocation(), separator_sign, point->wavepacket.getXt(), separator_sign, point->wavepacket.getYt(), separator_sign, point->wavepacket.getZt());
+      out += snprintf(out, 128, "%d%c%d%c%d%c%g%c%.15g%c%.15g%c%.15g", point->wavepacket.getIndex(), separator_sign, (U32)point->wavepacket.getOffset(), separator_sign, point->wavepacket.getSize(), separator_sign, point->wavepacket.getLocation(), separator_sign, point->wavepacket.getXt(), separator_sign, point->wavepacket.getYt(), separator_sign, point->wavepacket.getZt());
       break;
     case 'X': // the unscaled and unoffset integer X coordinate
-      fprintf(file, "%d", point->get_X());
+      out = itoa_las(out, point->get_X());
       break;
     case 'Y': // the unscaled and unoffset integer Y coordinate
-      fprintf(file, "%d", point->get_Y());
+      out = itoa_las(out, point->get_Y());
       break;
     case 'Z': // the unscaled and unoffset integer Z coordinate
-      fprintf(file, "%d", point->get_Z());
+      out = itoa_las(out, point->get_Z());
       break;
     default:
-      unparse_attribute(point, (I32)(parse_string[i]-'0'));
+      out = unparse_attribute(out, point, (I32)(parse_string[i]-'0'));
     }
     i++;
     if (parse_string[i])
     {
-      fprintf(file, "%c", separator_sign);
+      *out++ = separator_sign;
     }
     else
     {
-      fprintf(file, "\012");
+      *out++ = '\012';
       break;
     }
   }
+  buffer_size = out - buffer;
+  if (buffer_size >= LAS_WRITER_TXT_BUFFER_SIZE)
+  {
+    return flush();
+  }
+  return TRUE;
+}
+
+BOOL LASwriterTXT::flush()
+{
+  if (buffer_size == 0)
+  {
+    return TRUE;
+  }
+  size_t written = fwrite(buffer, 1, buffer_size, file);
+  if (written != buffer_size)
+  {
+    laserror("cannot write %u bytes of text. only %u written", (U32)buffer_size, (U32)written);
+    buffer_size = 0;
+    return FALSE;
+  }
+  buffer_size = 0;
   return TRUE;
 }
 
@@ -568,6 +608,8 @@ BOOL LASwriterTXT::update_header(const LASheader* header, BOOL use_inventory, BO
 
 I64 LASwriterTXT::close(BOOL update_header)
 {
+  if (file) flush();
+
   U32 bytes = (U32)ftell(file);
 
   if (file)
@@ -600,11 +642,15 @@ LASwriterTXT::LASwriterTXT()
   opts = FALSE;
   optx = FALSE;
   scale_rgb = 1.0f;
+  buffer = 0;
+  buffer_size = 0;
+  line_size = 0;
 }
 
 LASwriterTXT::~LASwriterTXT()
 {
   if (file) close();
+  if (buffer) free(buffer);
 }
 
 BOOL LASwriterTXT::check_parse_string(const CHAR* parse_string)
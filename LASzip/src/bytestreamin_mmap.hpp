@@ -0,0 +1,141 @@
+/*
+===============================================================================
+
+  FILE:  bytestreamin_mmap.hpp
+
+  CONTENTS:
+
+    Class for input streams that read a file mapped into memory. Reading and
+    seeking become plain pointer arithmetic on the pages of the file cache.
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created for memory-mapped reading of local LAS files
+
+===============================================================================
+*/
+#ifndef BYTE_STREAM_IN_MMAP_H
+#define BYTE_STREAM_IN_MMAP_H
+
+#include "bytestreamin_array.hpp"
+
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// the memory mapping of an open file
+
+class ByteStreamInMapping
+{
+public:
+  ByteStreamInMapping()
+  {
+    data = 0;
+    size = 0;
+#ifdef _WIN32
+    handle = NULL;
+#endif
+  };
+/* map the entire file (fails for empty files or when out of address space) */
+  BOOL map(FILE* file)
+  {
+    unmap();
+    if (file == 0) return FALSE;
+#ifdef _WIN32
+    HANDLE file_handle = (HANDLE)_get_osfhandle(_fileno(file));
+    if (file_handle == INVALID_HANDLE_VALUE) return FALSE;
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file_handle, &file_size) || (file_size.QuadPart <= 0)) return FALSE;
+    if ((sizeof(SIZE_T) < 8) && (file_size.QuadPart > (LONGLONG)U32_MAX)) return FALSE;
+    handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (handle == NULL) return FALSE;
+    data = (const U8*)MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+    if (data == 0)
+    {
+      CloseHandle(handle);
+      handle = NULL;
+      return FALSE;
+    }
+    size = (I64)file_size.QuadPart;
+#else
+    struct stat file_stat;
+    if ((fstat(fileno(file), &file_stat) != 0) || (file_stat.st_size <= 0)) return FALSE;
+    if ((sizeof(size_t) < 8) && ((I64)file_stat.st_size > (I64)U32_MAX)) return FALSE;
+    void* mapped = mmap(0, (size_t)file_stat.st_size, PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (mapped == MAP_FAILED) return FALSE;
+    data = (const U8*)mapped;
+    size = (I64)file_stat.st_size;
+#endif
+    return TRUE;
+  };
+  void unmap()
+  {
+    if (data)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(data);
+#else
+      munmap((void*)data, (size_t)size);
+#endif
+      data = 0;
+      size = 0;
+    }
+#ifdef _WIN32
+    if (handle)
+    {
+      CloseHandle(handle);
+      handle = NULL;
+    }
+#endif
+  };
+  inline const U8* get_data() const { return data; };
+  inline I64 get_size() const { return size; };
+  ~ByteStreamInMapping() { unmap(); };
+private:
+  const U8* data;
+  I64 size;
+#ifdef _WIN32
+  HANDLE handle;
+#endif
+};
+
+class ByteStreamInMapLE : public ByteStreamInArrayLE
+{
+public:
+/* map the file and read from the mapping                    */
+  BOOL open(FILE* file) { return (mapping.map(file) && init(mapping.get_data(), mapping.get_size())); };
+private:
+  ByteStreamInMapping mapping;
+};
+
+class ByteStreamInMapBE : public ByteStreamInArrayBE
+{
+public:
+/* map the file and read from the mapping                    */
+  BOOL open(FILE* file) { return (mapping.map(file) && init(mapping.get_data(), mapping.get_size())); };
+private:
+  ByteStreamInMapping mapping;
+};
+
+#endif
@@ -81,6 +81,22 @@ BOOL LASindex::add(const F64 x, const F64 y, const U32 p_index)
   return interval->add(p_index, cell);
 }
 
+LASinterval* LASindex::create_range() const
+{
+  return new LASinterval(interval->get_threshold());
+}
+
+BOOL LASindex::add(LASinterval* range, const F64 x, const F64 y, const U32 p_index) const
+{
+  I32 cell = spatial->get_cell_index(x, y);
+  return range->add(p_index, cell);
+}
+
+BOOL LASindex::add_range(LASinterval* range)
+{
+  return interval->append(range);
+}
+
 void LASindex::complete(U32 minimum_points, I32 maximum_intervals)
 {
   LASMessage(LAS_VERBOSE, "before complete %d %d", minimum_points, maximum_intervals);
@@ -27,6 +27,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- add ranges of points that were indexed in parallel with add_range()
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
      7 January 2017 -- add read(FILE* file) for Trimble LASzip DLL improvement
      2 April 2015 -- add seek_next(LASreadPoint* reader, I64 &p_count) for DLL
@@ -64,6 +65,12 @@ public:
   BOOL add(const F64 x, const F64 y, const U32 index);
   void complete(U32 minimum_points=100000, I32 maximum_intervals=-1);
 
+  // create spatial index in parallel: consecutive ranges of points are added to separate
+  // intervals (e.g. on other threads) that are then added in the order of their points
+  LASinterval* create_range() const;
+  BOOL add(LASinterval* range, const F64 x, const F64 y, const U32 index) const;
+  BOOL add_range(LASinterval* range);
+
   // read from file or write to file
   BOOL read(FILE* file);
   BOOL write(FILE* file) const;
@@ -40,8 +40,10 @@
 #include <string.h>
 #include <cassert>
 
+#include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 #include <unordered_map>
 
@@ -141,6 +143,77 @@ BOOL LASinterval::add(const U32 p_index, const I32 c_index)
   return FALSE;
 }
 
+BOOL LASinterval::append(LASinterval* range)
+{
+  my_cell_hash* range_cells = (my_cell_hash*)range->cells;
+  // take the cells in the order their first points were added to the range. this makes the hash
+  // of cells the same as when the points of the range are added one by one
+  std::vector< std::pair<U32, I32> > order;
+  order.reserve(range_cells->size());
+  my_cell_hash::iterator hash_element = range_cells->begin();
+  while (hash_element != range_cells->end())
+  {
+    order.push_back(std::pair<U32, I32>((*hash_element).second->start, (*hash_element).first));
+    hash_element++;
+  }
+  std::sort(order.begin(), order.end());
+  size_t i;
+  for (i = 0; i < order.size(); i++)
+  {
+    LASintervalStartCell* append_cell = (*range_cells)[order[i].second];
+    U32 number_appended = 0;
+    LASintervalCell* cell = append_cell;
+    while (cell)
+    {
+      number_appended++;
+      cell = cell->next;
+    }
+    hash_element = ((my_cell_hash*)cells)->find(order[i].second);
+    if (hash_element == ((my_cell_hash*)cells)->end())
+    {
+      ((my_cell_hash*)cells)->insert(my_cell_hash::value_type(order[i].second, append_cell));
+      number_intervals += number_appended;
+      continue;
+    }
+    LASintervalStartCell* start_cell = (*hash_element).second;
+    LASintervalCell* tail = (start_cell->last ? start_cell->last : start_cell);
+    if (append_cell->start <= tail->end)
+    {
+      laserror("(LASinterval): appended points must come after all others");
+      return FALSE;
+    }
+    U32 diff = append_cell->start - tail->end;
+    start_cell->full += append_cell->full;
+    if (diff > threshold)
+    {
+      // the first interval of the range stays separate
+      LASintervalCell* first = new LASintervalCell(append_cell);
+      first->next = append_cell->next;
+      tail->next = first;
+      start_cell->last = (append_cell->last ? append_cell->last : first);
+      start_cell->total += append_cell->total;
+      number_intervals += number_appended;
+    }
+    else
+    {
+      // the first interval of the range extends the last one
+      tail->end = append_cell->end;
+      tail->next = append_cell->next;
+      if (append_cell->last) start_cell->last = append_cell->last;
+      start_cell->total += diff + append_cell->total - 1;
+      number_intervals += number_appended - 1;
+    }
+    delete append_cell;
+  }
+  range_cells->clear();
+  range->number_intervals = 0;
+  range->last_index = I32_MIN;
+  range->last_cell = 0;
+  last_index = I32_MIN;
+  last_cell = 0;
+  return TRUE;
+}
+
 // get total number of cells
 U32 LASinterval::get_number_cells() const
 {
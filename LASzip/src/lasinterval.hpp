@@ -25,6 +25,7 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- append() the cells of a later range of points that was indexed separately
     20 October 2018 -- fixed rare bug in merge_intervals() when verbose is TRUE
     29 April 2011 -- created after cable outage during the royal wedding (-:
   
@@ -69,6 +70,11 @@ public:
   // add points and create cells with intervals
   BOOL add(const U32 p_index, const I32 c_index);
 
+  // append the cells of a range of later points that were added to another LASinterval (e.g.
+  // on another thread). the result is the same as if all points were added here. empties 'range'
+  BOOL append(LASinterval* range);
+  inline U32 get_threshold() const { return threshold; };
+
   // get total number of cells
   U32 get_number_cells() const;
 
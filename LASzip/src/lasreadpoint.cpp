@@ -37,11 +37,83 @@
 #include "lasreaditemcompressed_v2.hpp"
 #include "lasreaditemcompressed_v3.hpp"
 #include "lasreaditemcompressed_v4.hpp"
+#include "bytestreamin_array.hpp"
+#include "lasthreadpool.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+// one chunk that is (or was) decompressed by one of the worker threads
+
+class LASreadPointChunk
+{
+public:
+  U32 index;
+  U32 count;
+  std::vector<U8> bytes;
+  std::vector<U8> points;
+  std::future<I32> decoded;
+  I32 status;
+};
+
+// state of the multi-threaded decompression of chunks
+
+class LASreadPointThreaded
+{
+public:
+  LASreadPointThreaded(const U32 num_threads) : pool(num_threads)
+  {
+    current = 0;
+    current_point = 0;
+    next_chunk = 0;
+    stride = 0;
+  };
+
+  ~LASreadPointThreaded()
+  {
+    size_t i;
+    // wait for all chunks that are still being decompressed
+    while (pending.size())
+    {
+      if (pending.front()->decoded.valid()) pending.front()->decoded.wait();
+      delete pending.front();
+      pending.pop_front();
+    }
+    if (current) delete current;
+    for (i = 0; i < unused.size(); i++) delete unused[i];
+    for (i = 0; i < decoders.size(); i++) delete decoders[i];
+  };
+
+  LASreadPoint* get_decoder()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (decoders.size() == 0) return 0;
+    LASreadPoint* decoder = decoders.back();
+    decoders.pop_back();
+    return decoder;
+  };
+
+  void put_decoder(LASreadPoint* decoder)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    decoders.push_back(decoder);
+  };
+
+  LASthreadPool pool;
+  std::mutex mutex;
+  std::vector<LASreadPoint*> decoders;
+  std::deque<LASreadPointChunk*> pending;
+  std::vector<LASreadPointChunk*> unused;
+  LASreadPointChunk* current;
+  U32 current_point;
+  U32 next_chunk;
+  // layout of one point in the buffer of decompressed points
+  std::vector<U32> offsets;
+  std::vector<U32> sizes;
+  U32 stride;
+};
+
 LASreadPoint::LASreadPoint(U32 decompress_selective)
 {
   point_size = 0;
@@ -62,6 +134,11 @@ LASreadPoint::LASreadPoint(U32 decompress_selective)
   chunk_starts = 0;
   // used for selective decompression (new LAS 1.4 point types only)
   this->decompress_selective = decompress_selective;
+  // used for multi-threaded decompression
+  num_threads = 0;
+  num_points = 0;
+  threads_laszip = 0;
+  threaded = 0;
   // used for seeking
   point_start = 0;
   seek_point = 0;
@@ -294,11 +371,32 @@ BOOL LASreadPoint::setup(U32 num_items, const LASitem* items, const LASzip* lasz
     {
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
       number_chunks = U32_MAX;
+      // keep a copy of the items because worker threads set up their own decoders
+      if (threads_laszip) delete threads_laszip;
+      threads_laszip = new LASzip();
+      threads_laszip->compressor = laszip->compressor;
+      threads_laszip->coder = laszip->coder;
+      threads_laszip->chunk_size = laszip->chunk_size;
+      threads_laszip->num_items = (U16)num_items;
+      threads_laszip->items = new LASitem[num_items];
+      for (i = 0; i < num_readers; i++)
+      {
+        threads_laszip->items[i] = items[i];
+      }
     }
   }
   return TRUE;
 }
 
+BOOL LASreadPoint::set_threads(const U32 num_threads, const I64 num_points)
+{
+  // only chunked compression can be decompressed in parallel
+  if (threads_laszip == 0) return FALSE;
+  this->num_threads = num_threads;
+  this->num_points = num_points;
+  return TRUE;
+}
+
 BOOL LASreadPoint::init(ByteStreamIn* instream)
 {
   if (!instream) return FALSE;
@@ -329,6 +427,14 @@ BOOL LASreadPoint::seek(const U32 current, const U32 target)
 {
   if (!instream->isSeekable()) return FALSE;
   U32 delta = 0;
+  if (threaded)
+  {
+    // random access is better served by the single-threaded decompressor
+    done_threads();
+    num_threads = 0;
+    // make sure we start decompressing at the start of the target chunk
+    current_chunk = number_chunks;
+  }
   if (dec)
   {
     if (point_start == 0)
@@ -410,6 +516,18 @@ BOOL LASreadPoint::read(U8* const * point)
   U32 i;
   U32 context = 0;
 
+  if (threaded)
+  {
+    return read_threaded(point);
+  }
+  else if (num_threads > 1 && point_start == 0 && number_chunks == U32_MAX)
+  {
+    if (init_threads())
+    {
+      return read_threaded(point);
+    }
+  }
+
   try
   {
     if (dec)
@@ -538,6 +656,11 @@ BOOL LASreadPoint::read(U8* const * point)
 
 BOOL LASreadPoint::check_end()
 {
+  if (threaded)
+  {
+    // the integrity of each chunk was checked by the worker that decompressed it
+    return TRUE;
+  }
   if (readers == readers_compressed)
   {
     if (dec)
@@ -564,10 +687,317 @@ BOOL LASreadPoint::check_end()
 
 BOOL LASreadPoint::done()
 {
+  done_threads();
   instream = 0;
   return TRUE;
 }
 
+BOOL LASreadPoint::init_threads()
+{
+  // read the chunk table that tells us where each chunk starts
+
+  init_dec();
+  chunk_count = 0;
+
+  // without a complete chunk table the chunks must be decompressed one after the other
+
+  if (!instream->isSeekable() || (chunk_starts == 0) || (number_chunks == 0) || (number_chunks == U32_MAX) || (tabled_chunks != (number_chunks+1)) || (get_chunk_count(number_chunks-1) == 0))
+  {
+    num_threads = 0;
+    return FALSE;
+  }
+
+  threaded = new LASreadPointThreaded(num_threads);
+
+  // layout of the decompressed points is the same as that of the seek point
+
+  U32 i;
+  U32 offset = 0;
+  threaded->offsets.resize(num_readers);
+  threaded->sizes.resize(num_readers);
+  for (i = 0; i < num_readers; i++)
+  {
+    threaded->offsets[i] = offset;
+    if (threads_laszip->items[i].type == LASitem::POINT14)
+    {
+      // the POINT14 readers also set the LAS 1.4 fields and the GPS time
+      threaded->sizes[i] = sizeof(LAStempReadPoint10);
+    }
+    else
+    {
+      threaded->sizes[i] = threads_laszip->items[i].size;
+    }
+    if (layered_las14_compression)
+    {
+      // because combo LAS 1.0 - 1.4 point struct has padding
+      offset += (2*threads_laszip->items[i].size);
+    }
+    else
+    {
+      offset += threads_laszip->items[i].size;
+    }
+  }
+  threaded->stride = offset;
+  threaded->next_chunk = 0;
+
+  return TRUE;
+}
+
+void LASreadPoint::done_threads()
+{
+  if (threaded)
+  {
+    delete threaded;
+    threaded = 0;
+  }
+}
+
+U32 LASreadPoint::get_chunk_count(const U32 chunk) const
+{
+  if (chunk_totals)
+  {
+    return chunk_totals[chunk+1] - chunk_totals[chunk];
+  }
+  if ((chunk+1) < number_chunks)
+  {
+    return chunk_size;
+  }
+  // the last chunk holds the remaining points
+  I64 remaining = num_points - ((I64)chunk_size)*chunk;
+  if ((remaining <= 0) || (remaining > chunk_size))
+  {
+    return 0;
+  }
+  return (U32)remaining;
+}
+
+BOOL LASreadPoint::read_threaded(U8* const * point)
+{
+  U32 i;
+  LASreadPointThreaded* t = threaded;
+
+  if ((t->current == 0) || (t->current_point == t->current->count))
+  {
+    // recycle the buffers of the chunk we are done with
+
+    if (t->current)
+    {
+      t->unused.push_back(t->current);
+      t->current = 0;
+    }
+
+    // keep all threads busy by handing out more chunks than there are threads
+
+    while ((t->pending.size() < (2*t->pool.get_num_threads())) && (t->next_chunk < number_chunks))
+    {
+      LASreadPointChunk* chunk;
+      if (t->unused.size())
+      {
+        chunk = t->unused.back();
+        t->unused.pop_back();
+      }
+      else
+      {
+        chunk = new LASreadPointChunk();
+      }
+      chunk->index = t->next_chunk;
+      chunk->count = get_chunk_count(chunk->index);
+      chunk->status = 0;
+      t->next_chunk++;
+      t->pending.push_back(chunk);
+
+      // read the compressed bytes of the chunk here because the stream is not thread-safe
+
+      try
+      {
+        chunk->bytes.resize((size_t)(chunk_starts[chunk->index+1] - chunk_starts[chunk->index]));
+        if (instream->tell() != chunk_starts[chunk->index])
+        {
+          instream->seek(chunk_starts[chunk->index]);
+        }
+        instream->getBytes(chunk->bytes.data(), (U32)chunk->bytes.size());
+      }
+      catch (...)
+      {
+        chunk->status = EOF;
+        continue;
+      }
+
+      // the buffer for the decompressed points
+
+      if (chunk->points.size() < ((size_t)chunk->count * t->stride))
+      {
+        chunk->points.resize((size_t)chunk->count * t->stride);
+        if (layered_las14_compression)
+        {
+          // because extended_point_type must be set
+          chunk->points[22] = 1;
+        }
+      }
+
+      // decompress the chunk with the next available worker
+
+      chunk->decoded = t->pool.submit<I32>([this, t, chunk]() -> I32
+      {
+        LASreadPoint* decoder = t->get_decoder();
+        if (decoder == 0)
+        {
+          decoder = new LASreadPoint(decompress_selective);
+          if (!decoder->setup(threads_laszip->num_items, threads_laszip->items, threads_laszip))
+          {
+            delete decoder;
+            return 4711;
+          }
+        }
+        ByteStreamIn* stream;
+        if (IS_LITTLE_ENDIAN())
+          stream = new ByteStreamInArrayLE(chunk->bytes.data(), chunk->bytes.size());
+        else
+          stream = new ByteStreamInArrayBE(chunk->bytes.data(), chunk->bytes.size());
+        I32 status = decoder->read_chunk(stream, chunk->count, chunk->points.data(), t->offsets.data(), t->stride);
+        // check integrity
+        if ((status == 0) && (stream->tell() != (I64)chunk->bytes.size()))
+        {
+          status = 4711;
+        }
+        delete stream;
+        t->put_decoder(decoder);
+        return status;
+      });
+    }
+
+    // get the next chunk in order (and wait for it if necessary)
+
+    if (t->pending.size() == 0)
+    {
+      if (last_error == 0) last_error = new CHAR[128];
+      snprintf(last_error, 128, "end-of-file after last chunk with index %u", current_chunk);
+      return FALSE;
+    }
+    t->current = t->pending.front();
+    t->pending.pop_front();
+    if (t->current->decoded.valid())
+    {
+      t->current->status = t->current->decoded.get();
+    }
+    current_chunk = t->current->index;
+    if (t->current->status)
+    {
+      // create error string
+      if (last_error == 0) last_error = new CHAR[128];
+      // report error
+      if (t->current->status == EOF)
+      {
+        snprintf(last_error, 128, "end-of-file during chunk with index %u", current_chunk);
+      }
+      else
+      {
+        snprintf(last_error, 128, "chunk with index %u of %u is corrupt", current_chunk, tabled_chunks);
+      }
+      // ready for next LASreadPoint::read() to continue with next chunk
+      t->current_point = t->current->count;
+      return FALSE;
+    }
+    t->current_point = 0;
+  }
+
+  // copy the next decompressed point
+
+  const U8* decompressed = t->current->points.data() + (size_t)t->current_point * t->stride;
+  for (i = 0; i < num_readers; i++)
+  {
+    memcpy(point[i], decompressed + t->offsets[i], t->sizes[i]);
+  }
+  t->current_point++;
+
+  return TRUE;
+}
+
+I32 LASreadPoint::read_chunk(ByteStreamIn* instream, const U32 count, U8* points, const U32* offsets, const U32 stride)
+{
+  // decompresses an entire chunk that is held by its own stream into the buffer 'points'
+
+  U32 i,j;
+  U32 context = 0;
+  std::vector<U8*> point(num_readers);
+
+  try
+  {
+    // the first point of each chunk is stored raw
+
+    for (i = 0; i < num_readers; i++)
+    {
+      point[i] = points + offsets[i];
+      ((LASreadItemRaw*)(readers_raw[i]))->init(instream);
+      readers_raw[i]->read(point[i], context);
+    }
+    if (layered_las14_compression)
+    {
+      // for layered compression 'dec' only hands over the stream
+      dec->init(instream, FALSE);
+      // read how many points are in the chunk
+      U32 number;
+      instream->get32bitsLE((U8*)&number);
+      // read the sizes of all layers
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->chunk_sizes();
+      }
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
+      }
+    }
+    else
+    {
+      for (i = 0; i < num_readers; i++)
+      {
+        ((LASreadItemCompressed*)(readers_compressed[i]))->init(point[i], context);
+      }
+      dec->init(instream);
+    }
+
+    // all other points are compressed
+
+    for (j = 1; j < count; j++)
+    {
+      context = 0;
+      for (i = 0; i < num_readers; i++)
+      {
+        point[i] += stride;
+        readers_compressed[i]->read(point[i], context);
+      }
+    }
+    dec->done();
+  }
+  catch (I32 exception)
+  {
+    return (exception == EOF ? EOF : 4711);
+  }
+  catch (...)
+  {
+    return 4711;
+  }
+  return 0;
+}
+
+BOOL LASreadPoint::peek_chunk_table(ByteStreamIn* instream, const LASzip* laszip)
+{
+  if ((instream == 0) || (laszip == 0)) return FALSE;
+
+  // only chunked compression has a chunk table
+  if ((laszip->compressor == LASZIP_COMPRESSOR_NONE) || (laszip->compressor == LASZIP_COMPRESSOR_POINTWISE)) return FALSE;
+  if (laszip->coder != LASZIP_CODER_ARITHMETIC) return FALSE;
+
+  if (dec == 0) dec = new ArithmeticDecoder();
+  this->instream = instream;
+  chunk_size = (laszip->chunk_size ? laszip->chunk_size : U32_MAX);
+  number_chunks = U32_MAX;
+  tabled_chunks = 0;
+
+  return read_chunk_table();
+}
+
 BOOL LASreadPoint::init_dec()
 {
   // maybe read chunk table (only if chunking enabled)
@@ -799,6 +1229,9 @@ LASreadPoint::~LASreadPoint()
 {
   U32 i;
 
+  done_threads();
+  if (threads_laszip) delete threads_laszip;
+
   if (readers_raw)
   {
     for (i = 0; i < num_readers; i++)
@@ -24,6 +24,8 @@
   
   CHANGE HISTORY:
   
+    16 October 2026 -- read only the chunk table to report on the chunks of a LAZ file
+    16 October 2026 -- optional multi-threaded decompression of entire chunks
     23 September 2020 -- rare fix for bit-corrupted LAZ files where chunk table is zeroed
     28 August 2017 -- moving 'context' from global development hack to interface  
     18 July 2017 -- bug fix for spatial-indexed reading of native compressed LAS 1.4 
@@ -52,6 +54,7 @@
 
 class LASreadItem;
 class ArithmeticDecoder;
+class LASreadPointThreaded;
 
 class LASreadPoint
 {
@@ -62,12 +65,23 @@ public:
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
+  // optional for chunked LAZ: decompress chunks ahead of time with several threads
+  // (needs the total number of points to size the last chunk of fixed-size chunking)
+  BOOL set_threads(const U32 num_threads, const I64 num_points);
+
   BOOL init(ByteStreamIn* instream);
   BOOL seek(const U32 current, const U32 target);
   BOOL read(U8* const * point);
   BOOL check_end();
   BOOL done();
 
+  // only reads the chunk table of chunked LAZ without setting up the decompression of any points
+  // (the stream must be at the start of the points). used for reporting on the chunks of a file
+  BOOL peek_chunk_table(ByteStreamIn* instream, const LASzip* laszip);
+  inline U32 get_number_chunks() const { return (tabled_chunks ? tabled_chunks - 1 : 0); };
+  inline const I64* get_chunk_starts() const { return chunk_starts; };
+  inline const U32* get_chunk_totals() const { return chunk_totals; };
+
   inline const CHAR* error() const { return last_error; };
   inline const CHAR* warning() const { return last_warning; };
 
@@ -92,6 +106,16 @@ private:
   U32 search_chunk_table(const U32 index, const U32 lower, const U32 upper);
   // used for selective decompression (new LAS 1.4 point types only)
   U32 decompress_selective;
+  // used for multi-threaded decompression
+  U32 num_threads;
+  I64 num_points;
+  LASzip* threads_laszip;
+  LASreadPointThreaded* threaded;
+  BOOL init_threads();
+  void done_threads();
+  BOOL read_threaded(U8* const * point);
+  U32 get_chunk_count(const U32 chunk) const;
+  I32 read_chunk(ByteStreamIn* instream, const U32 count, U8* points, const U32* offsets, const U32 stride);
   // used for seeking
   I64 point_start;
   U32 point_size;
@@ -0,0 +1,126 @@
+/*
+===============================================================================
+
+  FILE:  lasthreadpool.hpp
+
+  CONTENTS:
+
+    A minimal pool of worker threads that run jobs handed to them in the
+    order they were submitted. Each submitted job returns a std::future so
+    that the caller can collect the results of parallel work in the order
+    it needs them (e.g. chunks of a LAZ file in their original order).
+
+  PROGRAMMERS:
+
+    info@rapidlasso.de  -  https://rapidlasso.de
+
+  COPYRIGHT:
+
+    (c) 2007-2026, rapidlasso GmbH - fast tools to catch reality
+
+    This is free software; you can redistribute and/or modify it under the
+    terms of the Apache Public License 2.0 published by the Apache Software
+    Foundation. See the COPYING file for more information.
+
+    This software is distributed WITHOUT ANY WARRANTY and without even the
+    implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+
+  CHANGE HISTORY:
+
+    16 October 2026 -- created for multi-threaded decompression of LAZ chunks
+
+===============================================================================
+*/
+#ifndef LAS_THREAD_POOL_HPP
+#define LAS_THREAD_POOL_HPP
+
+#include "mydefs.hpp"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class LASthreadPool
+{
+public:
+  LASthreadPool(const U32 num_threads)
+  {
+    stopping = FALSE;
+    U32 i;
+    for (i = 0; i < (num_threads ? num_threads : 1); i++)
+    {
+      threads.push_back(std::thread(&LASthreadPool::work, this));
+    }
+  };
+
+  ~LASthreadPool()
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stopping = TRUE;
+    }
+    condition.notify_all();
+    size_t i;
+    for (i = 0; i < threads.size(); i++)
+    {
+      threads[i].join();
+    }
+  };
+
+  inline U32 get_num_threads() const { return (U32)threads.size(); };
+
+  // hand a job to the next idle worker. the future delivers the result of
+  // the job (or re-throws whatever exception the job has thrown)
+  template <typename R>
+  std::future<R> submit(std::function<R()> job)
+  {
+    std::shared_ptr< std::packaged_task<R()> > task = std::make_shared< std::packaged_task<R()> >(job);
+    std::future<R> result = task->get_future();
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      jobs.push_back([task]() { (*task)(); });
+    }
+    condition.notify_one();
+    return result;
+  };
+
+  // number of threads that make sense on this machine
+  static U32 get_hardware_threads()
+  {
+    U32 n = (U32)std::thread::hardware_concurrency();
+    return (n ? n : 1);
+  };
+
+private:
+  void work()
+  {
+    while (true)
+    {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping && jobs.empty())
+        {
+          condition.wait(lock);
+        }
+        if (jobs.empty()) return;
+        job = jobs.front();
+        jobs.pop_front();
+      }
+      job();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  std::deque< std::function<void()> > jobs;
+  std::mutex mutex;
+  std::condition_variable condition;
+  BOOL stopping;
+};
+
+#endif
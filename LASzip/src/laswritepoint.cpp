@@ -37,11 +37,80 @@
 #include "laswriteitemcompressed_v2.hpp"
 #include "laswriteitemcompressed_v3.hpp"
 #include "laswriteitemcompressed_v4.hpp"
+#include "bytestreamout_array.hpp"
+#include "lasthreadpool.hpp"
 
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
 
+#include <chrono>
+
+// one chunk whose points are (or were) compressed by one of the worker threads
+
+class LASwritePointChunk
+{
+public:
+  U32 count;
+  std::vector<U8> points;
+  ByteStreamOutArray* bytes;
+  std::future<BOOL> compressed;
+};
+
+// state of the multi-threaded compression of chunks
+
+class LASwritePointThreaded
+{
+public:
+  LASwritePointThreaded(const U32 num_threads) : pool(num_threads)
+  {
+    current = 0;
+    stride = 0;
+  };
+
+  ~LASwritePointThreaded()
+  {
+    size_t i;
+    // wait for all chunks that are still being compressed
+    while (pending.size())
+    {
+      if (pending.front()->compressed.valid()) pending.front()->compressed.wait();
+      if (pending.front()->bytes) delete pending.front()->bytes;
+      delete pending.front();
+      pending.pop_front();
+    }
+    if (current) delete current;
+    for (i = 0; i < unused.size(); i++) delete unused[i];
+    for (i = 0; i < encoders.size(); i++) delete encoders[i];
+  };
+
+  LASwritePoint* get_encoder()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (encoders.size() == 0) return 0;
+    LASwritePoint* encoder = encoders.back();
+    encoders.pop_back();
+    return encoder;
+  };
+
+  void put_encoder(LASwritePoint* encoder)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    encoders.push_back(encoder);
+  };
+
+  LASthreadPool pool;
+  std::mutex mutex;
+  std::vector<LASwritePoint*> encoders;
+  std::deque<LASwritePointChunk*> pending;
+  std::vector<LASwritePointChunk*> unused;
+  LASwritePointChunk* current;
+  // layout of one point in the buffer of points to compress
+  std::vector<U32> offsets;
+  std::vector<U32> sizes;
+  U32 stride;
+};
+
 LASwritePoint::LASwritePoint()
 {
   outstream = 0;
@@ -60,6 +129,9 @@ LASwritePoint::LASwritePoint()
   chunk_bytes = 0;
   chunk_table_start_position = 0;
   chunk_start_position = 0;
+  // used for multi-threaded compression
+  threads_laszip = 0;
+  threaded = 0;
 }
 
 BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzip* laszip)
@@ -249,8 +321,63 @@ BOOL LASwritePoint::setup(const U32 num_items, const LASitem* items, const LASzi
       if (laszip->chunk_size) chunk_size = laszip->chunk_size;
       chunk_count = 0;
       number_chunks = U32_MAX;
+      // keep a copy of the items because worker threads set up their own encoders
+      if (threads_laszip) delete threads_laszip;
+      threads_laszip = new LASzip();
+      threads_laszip->compressor = laszip->compressor;
+      threads_laszip->coder = laszip->coder;
+      threads_laszip->chunk_size = laszip->chunk_size;
+      threads_laszip->num_items = (U16)num_items;
+      threads_laszip->items = new LASitem[num_items];
+      for (i = 0; i < num_writers; i++)
+      {
+        threads_laszip->items[i] = items[i];
+      }
+    }
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::set_threads(const U32 num_threads)
+{
+  // with variable chunking via chunk() a chunk is only written to the stream
+  // once it is compressed. use sync() and get_chunk_bytes() to learn where
+  if (threads_laszip == 0) return FALSE;
+  if (num_threads < 2) return FALSE;
+  if (threaded) return FALSE;
+
+  threaded = new LASwritePointThreaded(num_threads);
+
+  // layout of the buffered points is the same as in the decompressing threads
+
+  U32 i;
+  U32 offset = 0;
+  threaded->offsets.resize(num_writers);
+  threaded->sizes.resize(num_writers);
+  for (i = 0; i < num_writers; i++)
+  {
+    threaded->offsets[i] = offset;
+    if (threads_laszip->items[i].type == LASitem::POINT14)
+    {
+      // the POINT14 writers also use the LAS 1.4 fields and the GPS time
+      threaded->sizes[i] = sizeof(LAStempWritePoint10);
+    }
+    else
+    {
+      threaded->sizes[i] = threads_laszip->items[i].size;
+    }
+    if (layered_las14_compression)
+    {
+      // because combo LAS 1.0 - 1.4 point struct has padding
+      offset += (2*threads_laszip->items[i].size);
+    }
+    else
+    {
+      offset += threads_laszip->items[i].size;
     }
   }
+  threaded->stride = offset;
+
   return TRUE;
 }
 
@@ -295,6 +422,8 @@ BOOL LASwritePoint::init(ByteStreamOut* outstream)
 
 BOOL LASwritePoint::write(const U8 * const * point)
 {
+  if (threaded) return write_threaded(point);
+
   U32 i;
   U32 context = 0;
 
@@ -364,6 +493,15 @@ BOOL LASwritePoint::chunk()
   {
     return FALSE;
   }
+  if (threaded)
+  {
+    // hand the chunk to the next available worker (empty chunks are not supported)
+    if ((threaded->current == 0) || (threaded->current->count == 0))
+    {
+      return FALSE;
+    }
+    return submit_chunk();
+  }
   if (layered_las14_compression)
   {
     U32 i;
@@ -391,6 +529,8 @@ BOOL LASwritePoint::chunk()
 
 BOOL LASwritePoint::done()
 {
+  if (threaded) return done_threaded();
+
   if (writers == writers_compressed)
   {
     if (layered_las14_compression)
@@ -429,6 +569,226 @@ BOOL LASwritePoint::done()
   return TRUE;
 }
 
+BOOL LASwritePoint::write_threaded(const U8 * const * point)
+{
+  U32 i;
+  LASwritePointThreaded* t = threaded;
+
+  // start buffering a new chunk (recycling the buffers of an earlier one)
+
+  if (t->current == 0)
+  {
+    if (t->unused.size())
+    {
+      t->current = t->unused.back();
+      t->unused.pop_back();
+    }
+    else
+    {
+      t->current = new LASwritePointChunk();
+      t->current->bytes = 0;
+    }
+    t->current->count = 0;
+  }
+
+  // copy the point into the buffer of the chunk
+
+  size_t position = (size_t)t->current->count * t->stride;
+  if (t->current->points.size() < (position + t->stride))
+  {
+    t->current->points.resize(position + t->stride);
+  }
+  for (i = 0; i < num_writers; i++)
+  {
+    memcpy(t->current->points.data() + position + t->offsets[i], point[i], t->sizes[i]);
+  }
+  t->current->count++;
+
+  // once the chunk is full it gets compressed by the next available worker
+
+  if (t->current->count == chunk_size)
+  {
+    return submit_chunk();
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::submit_chunk()
+{
+  LASwritePointThreaded* t = threaded;
+  LASwritePointChunk* chunk = t->current;
+  t->current = 0;
+  t->pending.push_back(chunk);
+
+  chunk->compressed = t->pool.submit<BOOL>([this, t, chunk]() -> BOOL
+  {
+    LASwritePoint* encoder = t->get_encoder();
+    if (encoder == 0)
+    {
+      encoder = new LASwritePoint();
+      if (!encoder->setup(threads_laszip->num_items, threads_laszip->items, threads_laszip))
+      {
+        delete encoder;
+        return FALSE;
+      }
+    }
+    if (IS_LITTLE_ENDIAN())
+      chunk->bytes = new ByteStreamOutArrayLE(((I64)chunk->count * t->stride) / 4 + 4096);
+    else
+      chunk->bytes = new ByteStreamOutArrayBE(((I64)chunk->count * t->stride) / 4 + 4096);
+    BOOL success = encoder->write_chunk(chunk->bytes, chunk->count, chunk->points.data(), t->offsets.data(), t->stride);
+    t->put_encoder(encoder);
+    return success;
+  });
+
+  // write all chunks that are already compressed to the stream (in order)
+
+  while (t->pending.size() && (t->pending.front()->compressed.wait_for(std::chrono::seconds(0)) == std::future_status::ready))
+  {
+    if (!finish_chunk()) return FALSE;
+  }
+
+  // keep all threads busy but do not buffer more chunks than needed for that
+
+  while (t->pending.size() >= (2*t->pool.get_num_threads()))
+  {
+    if (!finish_chunk()) return FALSE;
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::finish_chunk()
+{
+  LASwritePointThreaded* t = threaded;
+  LASwritePointChunk* chunk = t->pending.front();
+  t->pending.pop_front();
+  t->unused.push_back(chunk);
+
+  // wait for the next chunk in order
+
+  BOOL success = chunk->compressed.get();
+  if (success)
+  {
+    success = outstream->putBytes(chunk->bytes->getData(), (U32)chunk->bytes->getSize());
+  }
+  delete chunk->bytes;
+  chunk->bytes = 0;
+  if (!success)
+  {
+    return FALSE;
+  }
+  chunk_count = chunk->count;
+  return add_chunk_to_table();
+}
+
+BOOL LASwritePoint::sync()
+{
+  if (threaded)
+  {
+    while (threaded->pending.size())
+    {
+      if (!finish_chunk()) return FALSE;
+    }
+  }
+  return TRUE;
+}
+
+BOOL LASwritePoint::get_chunk_bytes(const U32 index, U32& bytes) const
+{
+  if ((chunk_bytes == 0) || (number_chunks == U32_MAX) || (index >= number_chunks))
+  {
+    return FALSE;
+  }
+  bytes = chunk_bytes[index];
+  return TRUE;
+}
+
+BOOL LASwritePoint::done_threaded()
+{
+  BOOL success = TRUE;
+
+  // compress the last (partially filled) chunk
+
+  if (threaded->current && threaded->current->count)
+  {
+    success = submit_chunk();
+  }
+
+  // write all chunks that are still being compressed
+
+  while (success && threaded->pending.size())
+  {
+    success = finish_chunk();
+  }
+  delete threaded;
+  threaded = 0;
+  chunk_count = 0;
+
+  if (success && chunk_start_position)
+  {
+    return write_chunk_table();
+  }
+  return success;
+}
+
+BOOL LASwritePoint::write_chunk(ByteStreamOut* outstream, const U32 count, const U8* points, const U32* offsets, const U32 stride)
+{
+  // compresses an entire chunk from the buffer 'points' into its own stream
+
+  U32 i,j;
+  U32 context = 0;
+  std::vector<const U8*> point(num_writers);
+
+  // the first point of each chunk is stored raw
+
+  for (i = 0; i < num_writers; i++)
+  {
+    point[i] = points + offsets[i];
+    ((LASwriteItemRaw*)(writers_raw[i]))->init(outstream);
+    if (!writers_raw[i]->write(point[i], context))
+    {
+      return FALSE;
+    }
+    ((LASwriteItemCompressed*)(writers_compressed[i]))->init(point[i], context);
+  }
+  enc->init(outstream);
+
+  // all other points are compressed
+
+  for (j = 1; j < count; j++)
+  {
+    for (i = 0; i < num_writers; i++)
+    {
+      point[i] += stride;
+      if (!writers_compressed[i]->write(point[i], context))
+      {
+        return FALSE;
+      }
+    }
+  }
+
+  if (layered_las14_compression)
+  {
+    // write how many points are in the chunk
+    U32 number = count;
+    outstream->put32bitsLE((U8*)&number);
+    // write all layers 
+    for (i = 0; i < num_writers; i++)
+    {
+      ((LASwriteItemCompressed*)writers_compressed[i])->chunk_sizes();
+    }
+    for (i = 0; i < num_writers; i++)
+    {
+      ((LASwriteItemCompressed*)writers_compressed[i])->chunk_bytes();
+    }
+  }
+  else
+  {
+    enc->done();
+  }
+  return TRUE;
+}
+
 BOOL LASwritePoint::add_chunk_to_table()
 {
   if (number_chunks == alloced_chunks)
@@ -510,6 +870,9 @@ LASwritePoint::~LASwritePoint()
 {
   U32 i;
 
+  if (threaded) delete threaded;
+  if (threads_laszip) delete threads_laszip;
+
   if (writers_raw)
   {
     for (i = 0; i < num_writers; i++)
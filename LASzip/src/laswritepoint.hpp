@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- multi-threaded compression also of variable chunks with sync()
+    16 October 2026 -- optional multi-threaded compression of entire chunks
     21 February 2019 -- fix for writing 4294967295+ points uncompressed to LAS
     28 August 2017 -- moving 'context' from global development hack to interface  
     23 August 2016 -- layering of items for selective decompression in LAS 1.4 
@@ -48,6 +50,7 @@
 
 class LASwriteItem;
 class ArithmeticEncoder;
+class LASwritePointThreaded;
 
 class LASwritePoint
 {
@@ -58,11 +61,21 @@ public:
   // should only be called *once*
   BOOL setup(const U32 num_items, const LASitem* items, const LASzip* laszip=0);
 
+  // optional for LAZ with fixed-size chunks: compress chunks with several threads
+  // (must be called after setup() and before the first write())
+  BOOL set_threads(const U32 num_threads);
+
   BOOL init(ByteStreamOut* outstream);
   BOOL write(const U8 * const * point);
   BOOL chunk();
   BOOL done();
 
+  // with multi-threaded compression chunk() returns before the chunk is written to the
+  // stream. sync() waits until all chunks are written and get_chunk_bytes() reports the
+  // size of each chunk written so far
+  BOOL sync();
+  BOOL get_chunk_bytes(const U32 index, U32& bytes) const;
+
 private:
   ByteStreamOut* outstream;
   U32 num_writers;
@@ -82,6 +95,14 @@ private:
   I64 chunk_table_start_position;
   BOOL add_chunk_to_table();
   BOOL write_chunk_table();
+  // used for multi-threaded compression
+  LASzip* threads_laszip;
+  LASwritePointThreaded* threaded;
+  BOOL write_threaded(const U8 * const * point);
+  BOOL submit_chunk();
+  BOOL finish_chunk();
+  BOOL done_threaded();
+  BOOL write_chunk(ByteStreamOut* outstream, const U32 count, const U8* points, const U32* offsets, const U32 stride);
 };
 
 #endif
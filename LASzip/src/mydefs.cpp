@@ -33,6 +33,7 @@
 #include "lasmessage.hpp"
 #include "laszip_common.h"
 
+#include <cmath>
 #include <cstring>
 #include <filesystem>
 #include <stdarg.h>
@@ -75,6 +76,8 @@ bool wait_on_exit
     = false;
 bool print_log_stats = false;
 bool halt_on_error = true;
+thread_local bool defer_halt_on_error = false;
+thread_local bool deferred_halt = false;
 
 LAS_EXIT_CODE las_exit_code(bool error) {
   return (error ? LAS_EXIT_ERROR : LAS_EXIT_OK);
@@ -312,6 +315,186 @@ void* realloc_las(void* ptr, size_t size) {
   }
 }
 
+/// powers of ten that are exactly representable as a double
+static const double las_exact_powers_of_ten[23] = {
+  1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// Locale-free replacement for `strtod` for the plain decimal numbers of ASCII point clouds. When the at most 19
+/// significant digits fit into 53 bits and the exponent is at most 22 a single multiplication or division yields
+/// the correctly rounded result. All other numbers (e.g. with more digits, hex, inf or nan) are left to `strtod`.
+double strtod_las(const char* text, const char** end) {
+  const char* p = text;
+  bool negative = false;
+  if (*p == '-') {
+    negative = true;
+    p++;
+  } else if (*p == '+') {
+    p++;
+  }
+  unsigned long long mantissa = 0;
+  int significant = 0;
+  int exponent = 0;
+  bool digits = false;
+  while ((unsigned)(*p - '0') < 10) {
+    if (mantissa || (*p != '0')) {
+      if (significant == 19) break;
+      mantissa = 10 * mantissa + (unsigned)(*p - '0');
+      significant++;
+    }
+    digits = true;
+    p++;
+  }
+  if ((*p == '.') && (significant < 19)) {
+    p++;
+    while ((unsigned)(*p - '0') < 10) {
+      if (mantissa || (*p != '0')) {
+        if (significant == 19) break;
+        mantissa = 10 * mantissa + (unsigned)(*p - '0');
+        significant++;
+      }
+      exponent--;
+      digits = true;
+      p++;
+    }
+  }
+  if (digits && (significant < 19) && (*p != 'x') && (*p != 'X')) {
+    if ((*p == 'e') || (*p == 'E')) {
+      const char* q = p + 1;
+      bool negative_exponent = false;
+      if (*q == '-') {
+        negative_exponent = true;
+        q++;
+      } else if (*q == '+') {
+        q++;
+      }
+      if ((unsigned)(*q - '0') < 10) {
+        int e = 0;
+        while ((unsigned)(*q - '0') < 10) {
+          if (e < 10000) e = 10 * e + (*q - '0');
+          q++;
+        }
+        exponent += (negative_exponent ? -e : e);
+        p = q;
+      }
+    }
+    if (mantissa == 0) {
+      *end = p;
+      return (negative ? -0.0 : 0.0);
+    }
+    if ((mantissa < (1ull << 53)) && (exponent >= -22) && (exponent <= 22)) {
+      double value = (double)mantissa;
+      if (exponent < 0)
+        value /= las_exact_powers_of_ten[-exponent];
+      else
+        value *= las_exact_powers_of_ten[exponent];
+      *end = p;
+      return (negative ? -value : value);
+    }
+  }
+  char* e;
+  double value = strtod(text, &e);
+  *end = e;
+  return value;
+}
+
+/// Locale-free replacement for `strtol` that reads a decimal integer into 32 bits like `sscanf` with "%d".
+int strtoi_las(const char* text, const char** end) {
+  const char* p = text;
+  bool negative = false;
+  if (*p == '-') {
+    negative = true;
+    p++;
+  } else if (*p == '+') {
+    p++;
+  }
+  const char* digits = p;
+  int value = 0;
+  while (((unsigned)(*p - '0') < 10) && (p - digits < 9)) {
+    value = 10 * value + (*p - '0');
+    p++;
+  }
+  if ((p != digits) && ((unsigned)(*p - '0') >= 10)) {
+    *end = p;
+    return (negative ? -value : value);
+  }
+  char* e;
+  long long wide = strtoll(text, &e, 10);
+  *end = e;
+  return (int)wide;
+}
+
+/// two ASCII digits for each of the numbers from 0 to 99
+static const char las_digit_pairs[201] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+static char* utoa_las(char* text, unsigned long long value) {
+  char digits[20];
+  char* p = digits + 20;
+  while (value >= 100) {
+    unsigned pair = (unsigned)(value % 100);
+    value /= 100;
+    p -= 2;
+    memcpy(p, las_digit_pairs + 2 * pair, 2);
+  }
+  if (value >= 10) {
+    p -= 2;
+    memcpy(p, las_digit_pairs + 2 * value, 2);
+  } else {
+    *--p = (char)('0' + value);
+  }
+  size_t count = (size_t)(digits + 20 - p);
+  memcpy(text, p, count);
+  return text + count;
+}
+
+/// Locale-free replacement for `sprintf` with "%lld" that writes two digits at a time.
+char* itoa_las(char* text, long long value) {
+  if (value < 0) {
+    *text++ = '-';
+    return utoa_las(text, 0ull - (unsigned long long)value);
+  }
+  return utoa_las(text, (unsigned long long)value);
+}
+
+/// Locale-free replacement for `sprintf` with "%.*f" for the scaled coordinates of LiDAR points. The value multiplied
+/// by the power of ten is rounded to an integer whose digits are written with the point inserted. This is exactly what
+/// `sprintf` prints unless the product is too large or its fraction too close to one half for the rounding error of the
+/// multiplication to be ruled out. Those values (and inf or nan) are left to `sprintf`.
+char* dtoa_las(char* text, double value, int decimals) {
+  if ((decimals >= 0) && (decimals <= 15)) {
+    double magnitude = fabs(value) * las_exact_powers_of_ten[decimals];
+    if (magnitude < 1e15) {
+      double integral = floor(magnitude);
+      double fraction = magnitude - integral;
+      if (fabs(fraction - 0.5) > 1e-15 * magnitude + 1e-300) {
+        unsigned long long rounded = (unsigned long long)integral + (fraction > 0.5 ? 1 : 0);
+        if (std::signbit(value)) *text++ = '-';
+        if (decimals == 0) return utoa_las(text, rounded);
+        // at least one digit before the point
+        char digits[24];
+        char* end = utoa_las(digits, rounded);
+        int count = (int)(end - digits);
+        int leading = decimals + 1 - count;
+        if (leading > 0) {
+          memset(text, '0', leading);
+          memcpy(text + leading, digits, count);
+          count += leading;
+        } else {
+          memcpy(text, digits, count);
+        }
+        memmove(text + count - decimals + 1, text + count - decimals, decimals);
+        text[count - decimals] = '.';
+        return text + count + 1;
+      }
+    }
+  }
+  return text + snprintf(text, 330, "%.*f", decimals, value);
+}
+
 /// Wrapper for `sscanf` on other platforms than _MSC_VER and `sscanf_s` on Windows and ensures that the size is passed correctly for strings.
 int sscanf_las(const char* buffer, const char* format, ...) {
   va_list args;
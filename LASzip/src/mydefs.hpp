@@ -24,6 +24,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- locale-free itoa_las() and dtoa_las() for fast writing of ASCII points
+    16 October 2026 -- locale-free strtod_las() and strtoi_las() for fast parsing of ASCII points
     28 October 2015 -- adding DLL bindings via 'COMPILE_AS_DLL' and 'USE_AS_DLL'
     10 January 2011 -- licensing change for LGPL release and libLAS integration
     13 July 2005 -- created after returning with many mosquito bites from OBX
@@ -331,6 +333,10 @@ class pnt_cnt_error : public exception_file_loop {
 
 extern bool wait_on_exit;
 extern bool halt_on_error;
+// a thread that must not end the process (see LASpipeline) sets 'defer_halt_on_error'. an error then
+// only sets 'deferred_halt' and the thread that started it halts after joining it
+extern thread_local bool defer_halt_on_error;
+extern thread_local bool deferred_halt;
 extern bool print_log_stats;
 
 enum LAS_EXIT_CODE { LAS_EXIT_OK = 0, LAS_EXIT_ERROR, LAS_EXIT_WARNING };
@@ -355,7 +361,11 @@ template <typename... Args>
 void laserror(LAS_FORMAT_STRING(const char*) fmt, Args... args) {
   LASMessage(LAS_ERROR, fmt, args...);
   if (halt_on_error) {
-    byebye();
+    if (defer_halt_on_error) {
+      deferred_halt = true;
+    } else {
+      byebye();
+    }
   }
   return;
 };
@@ -366,7 +376,11 @@ void laserrorm(LAS_FORMAT_STRING(const char*) fmt, Args... args) {
   LASMessage(LAS_ERROR, fmt, args...);
   LASMessage(LAS_INFO, "\tcontact info@rapidlasso.de for support\n");
   if (halt_on_error) {
-    byebye();
+    if (defer_halt_on_error) {
+      deferred_halt = true;
+    } else {
+      byebye();
+    }
   }
   return;
 };
@@ -410,5 +424,14 @@ void* realloc_las(void* ptr, size_t size);
 int sscanf_las(const char* buffer, const char* format, ...);
 /// Wrapper for `strncpy` on other platforms than _MSC_VER and `strncpy_s` on Windows.
 int strncpy_las(char *dest, size_t destsz, const char *src, size_t count);
+/// Locale-free replacement for `strtod`. `end` is set behind the number or to `text` if there is none.
+double strtod_las(const char* text, const char** end);
+/// Locale-free replacement for `strtol` into 32 bits. `end` is set behind the number or to `text` if there is none.
+int strtoi_las(const char* text, const char** end);
+/// Writes the decimal digits of `value` to `text` without a terminating zero and returns the position behind the last digit.
+char* itoa_las(char* text, long long value);
+/// Writes `value` with `decimals` digits after the point exactly like `sprintf` with "%.*f" but without a terminating zero
+/// and returns the position behind the last digit. `text` needs room for 330 characters in the worst case.
+char* dtoa_las(char* text, double value, int decimals);
 
 #endif
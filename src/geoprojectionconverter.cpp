@@ -46,6 +46,7 @@
 #include "lasmessage.hpp"
 #include "lasutility.hpp"
 #include "proj_loader.h"
+#include "lasthreadpool.hpp"
 
 #if defined(_MSC_VER) && \
     (_MSC_FULL_VER >= 150000000)
@@ -821,14 +822,17 @@ static const short EPSG_EOV_HD72 = 23700;
 ProjParameters::ProjParameters()
     : arg_count(0),
       max_param(7),
+      proj_info_args(nullptr),
       valid_proj_info_params{"wkt", "js", "str", "epsg", "el", "datum", "cs"},
-      header_wkt_representation(nullptr),
-      proj_crs_infos(nullptr),
       proj_ctx(nullptr),
       proj_source_crs(nullptr),
       proj_target_crs(nullptr),
       proj_transform_crs(nullptr),
-      proj_info_args(nullptr)
+      proj_thread_count(0),
+      proj_thread_ctx(nullptr),
+      proj_thread_transform(nullptr),
+      header_wkt_representation(nullptr),
+      proj_crs_infos(nullptr)
 {
 }
 
@@ -838,6 +842,14 @@ ProjParameters::~ProjParameters()
   delete[] header_wkt_representation;
   delete[] proj_crs_infos;
 
+  // Free the copies of the transformation and their contexts
+  for (unsigned int i = 0; i < proj_thread_count; i++) {
+    proj_destroy(proj_thread_transform[i]);
+    proj_context_destroy(proj_thread_ctx[i]);
+  }
+  delete[] proj_thread_transform;
+  delete[] proj_thread_ctx;
+
   // Free the PROJ context
   if (proj_ctx)  {
     proj_context_destroy(proj_ctx);
@@ -7244,6 +7256,470 @@ bool GeoProjectionConverter::LLtoECEF(const double LatDegree, const double LongD
   return true;
 }
 
+/*
+  * The array versions of UTMtoLL(), LLtoUTM(), LCCtoLL(), LLtoLCC(), TMtoLL(),
+  * LLtoTM(), ECEFtoLL() and LLtoECEF() convert 'n' coordinates at once. They
+  * evaluate the same expressions in the same order as the functions above and
+  * therefore give bit-identical results. Only what depends on the ellipsoid
+  * and the projection alone is computed once per call and every sine, cosine
+  * or tangent that the per-point functions compute more than once is computed
+  * once per point. The lasexample_geoprojection program compares the
+  * per-point and the array paths of to_target().
+*/
+bool GeoProjectionConverter::UTMtoLL(const double* UTMEastingMeter, const double* UTMNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersUTM* utm) const
+{
+  const double k0 = 0.9996;
+  const double a = ellipsoid->equatorial_radius;
+  const double e2 = ellipsoid->eccentricity_squared;
+  const double ep2 = ellipsoid->eccentricity_prime_squared;
+  const double e1 = ellipsoid->eccentricity_e1;
+  const double mu_denominator = (a*(1-e2/4-3*e2*e2/64-5*e2*e2*e2/256));
+  const double phi2 = (3*e1/2-27*e1*e1*e1/32);
+  const double phi4 = (21*e1*e1/16-55*e1*e1*e1*e1/32);
+  const double phi6 = (151*e1*e1*e1/96);
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double x = UTMEastingMeter[i] - 500000.0; // remove 500,000 meter offset for longitude
+    double y = UTMNorthingMeter[i];
+
+    if (!utm->utm_northern_hemisphere)
+    {
+      y -= 10000000.0; //remove 10,000,000 meter offset used for southern hemisphere
+    }
+
+    double M = y / k0;
+    double mu = M/mu_denominator;
+
+    double phi1Rad = mu + phi2*sin(2*mu) + phi4*sin(4*mu) + phi6*sin(6*mu);
+
+    double sin_phi1 = sin(phi1Rad);
+    double cos_phi1 = cos(phi1Rad);
+    double tan_phi1 = tan(phi1Rad);
+    double N1 = a/sqrt(1-e2*sin_phi1*sin_phi1);
+    double T1 = tan_phi1*tan_phi1;
+    double C1 = ep2*cos_phi1*cos_phi1;
+    double R1 = a*(1-e2)/pow(1-e2*sin_phi1*sin_phi1, 1.5);
+    double D = x/(N1*k0);
+
+    double Latitude = phi1Rad - (N1*tan_phi1/R1)*(D*D/2-(5+3*T1+10*C1-4*C1*C1-9*ep2)*D*D*D*D/24
+                      + (61+90*T1+298*C1+45*T1*T1-252*ep2-3*C1*C1)*D*D*D*D*D*D/720);
+    LatDegree[i] = Latitude * rad2deg;
+
+    double Longitude = (D-(1+2*T1+C1)*D*D*D/6+(5-2*C1+28*T1-3*C1*C1+8*ep2+24*T1*T1)*D*D*D*D*D/120)/cos_phi1;
+    LongDegree[i] = Longitude * rad2deg + utm->utm_long_origin;
+  }
+  return true;
+}
+
+bool GeoProjectionConverter::LLtoUTM(const double* LatDegree, const double* LongDegree, double* UTMEastingMeter, double* UTMNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersUTM* utm) const
+{
+  const double k0 = 0.9996;
+  const double a = ellipsoid->equatorial_radius;
+  const double e2 = ellipsoid->eccentricity_squared;
+  const double ep2 = ellipsoid->eccentricity_prime_squared;
+  const double m0 = (1  - e2/4 - 3*e2*e2/64  - 5*e2*e2*e2/256);
+  const double m2 = (3*e2/8  + 3*e2*e2/32  + 45*e2*e2*e2/1024);
+  const double m4 = (15*e2*e2/256 + 45*e2*e2*e2/1024);
+  const double m6 = (35*e2*e2*e2/3072);
+  const double LongOriginRad = ((utm->utm_zone_number - 1)*6 - 180 + 3) * deg2rad;  // + 3 puts origin in middle of zone
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double Lat = LatDegree[i];
+    // Make sure the longitude is between -180.00 .. 179.9
+    double LongTemp = (LongDegree[i]+180)-int((LongDegree[i]+180)/360)*360-180; // -180.00 .. 179.9;
+    double LatRad = Lat*deg2rad;
+    double LongRad = LongTemp*deg2rad;
+
+    double sin_lat = sin(LatRad);
+    double cos_lat = cos(LatRad);
+    double tan_lat = tan(LatRad);
+    double N = a/sqrt(1-e2*sin_lat*sin_lat);
+    double T = tan_lat*tan_lat;
+    double C = ep2*cos_lat*cos_lat;
+    double A = cos_lat*(LongRad-LongOriginRad);
+
+    double M = a*(m0*LatRad - m2*sin(2*LatRad) + m4*sin(4*LatRad) - m6*sin(6*LatRad));
+
+    UTMEastingMeter[i] = (double)(k0*N*(A+(1-T+C)*A*A*A/6
+            + (5-18*T+T*T+72*C-58*ep2)*A*A*A*A*A/120)
+            + 500000.0);
+
+    UTMNorthingMeter[i] = (double)(k0*(M+N*tan_lat*(A*A/2+(5-T+9*C+4*C*C)*A*A*A*A/24
+           + (61-58*T+T*T+600*C-330*ep2)*A*A*A*A*A*A/720)));
+
+    if (Lat < 0)
+    {
+      UTMNorthingMeter[i] += 10000000.0; //10000000 meter offset for southern hemisphere
+    }
+  }
+  return true;
+}
+
+bool GeoProjectionConverter::LCCtoLL(const double* LCCEastingMeter, const double* LCCNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersLCC* lcc) const
+{
+  const double inverse_n = 1.0 / lcc->lcc_n;
+  const double half_es = ellipsoid->eccentricity / 2.0;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double dx = LCCEastingMeter[i] - lcc->lcc_false_easting_meter;
+    double dy = LCCNorthingMeter[i] - lcc->lcc_false_northing_meter;
+
+    double rho0_MINUS_dy = lcc->lcc_rho0 - dy;
+    double rho = sqrt(dx * dx + (rho0_MINUS_dy) * (rho0_MINUS_dy));
+
+    if (lcc->lcc_n < 0.0)
+    {
+      rho *= -1.0;
+      dx *= -1.0;
+      rho0_MINUS_dy *= -1.0;
+    }
+
+    if (rho != 0.0)
+    {
+      double theta = atan2(dx, rho0_MINUS_dy);
+      double t = pow(rho / (lcc->lcc_aF), inverse_n);
+      double PHI = PI_OVER_2 - 2.0 * atan(t);
+      double tempPHI = 0.0;
+      while (fabs(PHI - tempPHI) > 4.85e-10)
+      {
+        double es_sin = ellipsoid->eccentricity * sin(PHI);
+        tempPHI = PHI;
+        PHI = PI_OVER_2 - 2.0 * atan(t * pow((1.0 - es_sin) / (1.0 + es_sin), half_es));
+      }
+      double Latitude = PHI;
+      double Longitude = theta / lcc->lcc_n + lcc->lcc_long_meridian_radian;
+
+      if (fabs(Latitude) < 2.0e-7)  /* force tiny lat to 0 */
+        LatDegree[i] = 0.0;
+      else if (Latitude > PI_OVER_2) /* force distorted lat to 90, -90 degrees */
+        LatDegree[i] = 90.0;
+      else if (Latitude < -PI_OVER_2)
+        LatDegree[i] = -90.0;
+      else
+        LatDegree[i] = rad2deg*Latitude;
+
+      if (fabs(Longitude) < 2.0e-7)  /* force tiny long to 0 */
+        LongDegree[i] = 0.0;
+      else if (Longitude > PI) /* force distorted long to 180, -180 degrees */
+        LongDegree[i] = 180.0;
+      else if (Longitude < -PI)
+        LongDegree[i] = -180.0;
+      else
+        LongDegree[i] = rad2deg*Longitude;
+    }
+    else
+    {
+      if (lcc->lcc_n > 0.0)
+        LatDegree[i] = 90.0;
+      else
+        LatDegree[i] = -90.0;
+      LongDegree[i] = lcc->lcc_long_meridian_degree;
+    }
+  }
+  return true;
+}
+
+// like the per-point LLtoLCC() this leaves the outputs of points that can not be projected untouched
+bool GeoProjectionConverter::LLtoLCC(const double* LatDegree, const double* LongDegree, double* LCCEastingMeter, double* LCCNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersLCC* lcc) const
+{
+  const double half_es = ellipsoid->eccentricity/2;
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double rho = 0.0;
+    double Latitude = LatDegree[i]*deg2rad;
+    double Longitude = LongDegree[i]*deg2rad;
+
+    if (fabs(fabs(Latitude) - PI_OVER_2) > 1.0e-10)
+    {
+      double slat = sin(Latitude);
+      double es_sin = ellipsoid->eccentricity*slat;
+      double t = tan(PI_OVER_4 - Latitude / 2) / pow((1.0 - es_sin) / (1.0 + es_sin), half_es);
+      rho = lcc->lcc_aF * pow(t, lcc->lcc_n);
+    }
+    else
+    {
+      if ((Latitude * lcc->lcc_n) <= 0)
+      { // Point can not be projected
+        continue;
+      }
+    }
+
+    double dlam = Longitude - lcc->lcc_long_meridian_radian;
+
+    double theta = lcc->lcc_n * dlam;
+
+    LCCEastingMeter[i] = rho * sin(theta) + lcc->lcc_false_easting_meter;
+    LCCNorthingMeter[i] = lcc->lcc_rho0 - rho * cos(theta) + lcc->lcc_false_northing_meter;
+  }
+  return true;
+}
+
+bool GeoProjectionConverter::LLtoTM(const double* LatDegree, const double* LongDegree, double* TMEastingMeter, double* TMNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersTM* tm) const
+{
+  const double tmdo = SPHTMD(tm->tm_lat_origin_radian);  /* True Meridional distance for latitude of origin */
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double Latitude = LatDegree[i]*deg2rad;
+    double Longitude = LongDegree[i]*deg2rad;
+
+    if (Longitude > PI) Longitude -= TWO_PI;
+
+    double dlam = Longitude - tm->tm_long_meridian_radian;
+
+    if (dlam > PI)
+      dlam -= TWO_PI;
+    if (dlam < -PI)
+      dlam += TWO_PI;
+    if (fabs(dlam) < 2.e-10)
+      dlam = 0.0;
+
+    double s = sin(Latitude);
+    double c = cos(Latitude);
+    double c2 = c * c;
+    double c3 = c2 * c;
+    double c5 = c3 * c2;
+    double c7 = c5 * c2;
+    double t = tan(Latitude);
+    double tan2 = t * t;
+    double tan3 = tan2 * t;
+    double tan4 = tan3 * t;
+    double tan5 = tan4 * t;
+    double tan6 = tan5 * t;
+    double eta = ellipsoid->eccentricity_prime_squared * c2;
+    double eta2 = eta * eta;
+    double eta3 = eta2 * eta;
+    double eta4 = eta3 * eta;
+
+    /* radius of curvature in prime vertical */
+    double sn = SPHSN(Latitude);
+
+    /* True Meridianal Distances */
+    double tmd = SPHTMD(Latitude);
+
+    /* northing */
+    double t1 = (tmd - tmdo) * tm->tm_scale_factor;
+    double t2 = sn * s * c * tm->tm_scale_factor/ 2.e0;
+    double t3 = sn * s * c3 * tm->tm_scale_factor * (5.e0 - tan2 + 9.e0 * eta
+                                                      + 4.e0 * eta2) /24.e0;
+
+    double t4 = sn * s * c5 * tm->tm_scale_factor * (61.e0 - 58.e0 * tan2
+                                                      + tan4 + 270.e0 * eta - 330.e0 * tan2 * eta + 445.e0 * eta2
+                                                      + 324.e0 * eta3 -680.e0 * tan2 * eta2 + 88.e0 * eta4
+                                                      -600.e0 * tan2 * eta3 - 192.e0 * tan2 * eta4) / 720.e0;
+
+    double t5 = sn * s * c7 * tm->tm_scale_factor * (1385.e0 - 3111.e0 *
+                                                      tan2 + 543.e0 * tan4 - tan6) / 40320.e0;
+
+    TMNorthingMeter[i] = tm->tm_false_northing_meter + t1 + pow(dlam,2.e0) * t2 + pow(dlam,4.e0) * t3 + pow(dlam,6.e0) * t4 + pow(dlam,8.e0) * t5;
+
+    /* Easting */
+    double t6 = sn * c * tm->tm_scale_factor;
+    double t7 = sn * c3 * tm->tm_scale_factor * (1.e0 - tan2 + eta ) /6.e0;
+    double t8 = sn * c5 * tm->tm_scale_factor * (5.e0 - 18.e0 * tan2 + tan4
+                                                  + 14.e0 * eta - 58.e0 * tan2 * eta + 13.e0 * eta2 + 4.e0 * eta3
+                                                  - 64.e0 * tan2 * eta2 - 24.e0 * tan2 * eta3 )/ 120.e0;
+    double t9 = sn * c7 * tm->tm_scale_factor * ( 61.e0 - 479.e0 * tan2
+                                                   + 179.e0 * tan4 - tan6 ) /5040.e0;
+
+    TMEastingMeter[i] = tm->tm_false_easting_meter + dlam * t6 + pow(dlam,3.e0) * t7 + pow(dlam,5.e0) * t8 + pow(dlam,7.e0) * t9;
+  }
+  return true;
+}
+
+bool GeoProjectionConverter::TMtoLL(const double* TMEastingMeter, const double* TMNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersTM* tm) const
+{
+  const double tmdo = SPHTMD(tm->tm_lat_origin_radian);  /* True Meridional distance for latitude of origin */
+  const double sr0 = SPHSR(0.e0);                        /* Radius of Curvature in the meridian at the equator */
+  const double k2 = pow(tm->tm_scale_factor, 2);
+  const double k3 = pow(tm->tm_scale_factor, 3);
+  const double k4 = pow(tm->tm_scale_factor, 4);
+  const double k5 = pow(tm->tm_scale_factor, 5);
+  const double k6 = pow(tm->tm_scale_factor, 6);
+  const double k7 = pow(tm->tm_scale_factor, 7);
+  const double k8 = pow(tm->tm_scale_factor, 8);
+
+  for (size_t i = 0; i < n; i++)
+  {
+    /*  Origin  */
+    double tmd = tmdo + (TMNorthingMeter[i] - tm->tm_false_northing_meter) / tm->tm_scale_factor;
+
+    /* First Estimate */
+    double sr = sr0;
+    double ftphi = tmd/sr;
+    double t10;
+
+    for (int j = 0; j < 5 ; j++)
+    {
+      t10 = SPHTMD (ftphi);
+      sr = SPHSR(ftphi);
+      ftphi = ftphi + (tmd - t10) / sr;
+    }
+
+    /* Radius of Curvature in the meridian */
+    sr = SPHSR(ftphi);
+
+    /* Radius of Curvature in the prime vertical */
+    double sn = SPHSN(ftphi);
+    double sn3 = pow(sn,3);
+    double sn5 = pow(sn,5);
+    double sn7 = pow(sn,7);
+
+    /* Sine Cosine terms */
+    double c = cos(ftphi);
+
+    /* Tangent Value  */
+    double t = tan(ftphi);
+    double tan2 = t * t;
+    double tan4 = tan2 * tan2;
+    double tan6 = pow(t,6);
+    double eta = ellipsoid->eccentricity_prime_squared * pow(c,2);
+    double eta2 = eta * eta;
+    double eta3 = eta2 * eta;
+    double eta4 = eta3 * eta;
+    double de = TMEastingMeter[i] - tm->tm_false_easting_meter;
+    if (fabs(de) < 0.0001)
+      de = 0.0;
+
+    /* Latitude */
+    t10 = t / (2.e0 * sr * sn * k2);
+    double t11 = t * (5.e0  + 3.e0 * tan2 + eta - 4.e0 * pow(eta,2)
+                      - 9.e0 * tan2 * eta) / (24.e0 * sr * sn3
+                                              * k4);
+    double t12 = t * (61.e0 + 90.e0 * tan2 + 46.e0 * eta + 45.E0 * tan4
+                      - 252.e0 * tan2 * eta  - 3.e0 * eta2 + 100.e0
+                      * eta3 - 66.e0 * tan2 * eta2 - 90.e0 * tan4
+                      * eta + 88.e0 * eta4 + 225.e0 * tan4 * eta2
+                      + 84.e0 * tan2* eta3 - 192.e0 * tan2 * eta4)
+                 / ( 720.e0 * sr * sn5 * k6 );
+    double t13 = t * ( 1385.e0 + 3633.e0 * tan2 + 4095.e0 * tan4 + 1575.e0
+                       * tan6)/ (40320.e0 * sr * sn7 * k8);
+    double Latitude = ftphi - pow(de,2) * t10 + pow(de,4) * t11 - pow(de,6) * t12 + pow(de,8) * t13;
+
+    double t14 = 1.e0 / (sn * c * tm->tm_scale_factor);
+
+    double t15 = (1.e0 + 2.e0 * tan2 + eta) / (6.e0 * sn3 * c *
+                                               k3);
+
+    double t16 = (5.e0 + 6.e0 * eta + 28.e0 * tan2 - 3.e0 * eta2
+                  + 8.e0 * tan2 * eta + 24.e0 * tan4 - 4.e0
+                  * eta3 + 4.e0 * tan2 * eta2 + 24.e0
+                  * tan2 * eta3) / (120.e0 * sn5 * c
+                                    * k5);
+
+    double t17 = (61.e0 +  662.e0 * tan2 + 1320.e0 * tan4 + 720.e0
+                  * tan6) / (5040.e0 * sn7 * c
+                             * k7);
+
+    /* Difference in Longitude */
+    double dlam = de * t14 - pow(de,3) * t15 + pow(de,5) * t16 - pow(de,7) * t17;
+
+    /* Longitude */
+    double Longitude = tm->tm_long_meridian_radian + dlam;
+    while (Latitude > PI_OVER_2)
+    {
+      Latitude = PI - Latitude;
+      Longitude += PI;
+      if (Longitude > PI)
+        Longitude -= TWO_PI;
+    }
+
+    while (Latitude < -PI_OVER_2)
+    {
+      Latitude = - (Latitude + PI);
+      Longitude += PI;
+      if (Longitude > PI)
+        Longitude -= TWO_PI;
+    }
+    if (Longitude > TWO_PI)
+      Longitude -= TWO_PI;
+    if (Longitude < -PI)
+      Longitude += TWO_PI;
+
+    LatDegree[i] = rad2deg*Latitude;
+    LongDegree[i] = rad2deg*Longitude;
+  }
+  return true;
+}
+
+// the elevation may be read from and written to the same array because all inputs of a point are read before its outputs are written
+bool GeoProjectionConverter::ECEFtoLL(const double* ECEFMeterX, const double* ECEFMeterY, const double* ECEFMeterZ, double* LatDegree, double* LongDegree, double* ElevationMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid) const
+{
+  const double A = ellipsoid->equatorial_radius;
+  const double A2_MINUS_B2 = (A*A - ellipsoid->polar_radius*ellipsoid->polar_radius);
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double x = ECEFMeterX[i];
+    double y = ECEFMeterY[i];
+    double z = ECEFMeterZ[i];
+    double B = ellipsoid->polar_radius;
+
+    // the same solution of t^4 + 2*E*t^3 + 2*F*t - 1 = 0 as in the per-point ECEFtoLL()
+    if ( z < 0.0 )
+    {
+      B= -B;
+    }
+    double r = sqrt( x*x + y*y );
+    double e = ( B*z - A2_MINUS_B2 ) / ( A*r );
+    double f = ( B*z + A2_MINUS_B2 ) / ( A*r );
+    double p = (4.0 / 3.0) * (e*f + 1.0);
+    double q = 2.0 * (e*e - f*f);
+    double d = p*p*p + q*q;
+    double v;
+
+    if( d >= 0.0 ) {
+            v= pow( (sqrt( d ) - q), (1.0 / 3.0) )
+             - pow( (sqrt( d ) + q), (1.0 / 3.0) );
+    } else {
+            v= 2.0 * sqrt( -p )
+             * cos( acos( q/(p * sqrt( -p )) ) / 3.0 );
+    }
+    if( v*v < fabs(p) ) {
+            v= -(v*v*v + 2.0*q) / (3.0*p);
+    }
+    double g = (sqrt( e*e + v ) + e) / 2.0;
+    double t = sqrt( g*g  + (f - v*g)/(2.0*g - e) ) - g;
+
+    double Latitude = atan( (A*(1.0 - t*t)) / (2.0*B*t) );
+
+    ElevationMeter[i] = (r - A*t)*cos( Latitude ) + (z - B)*sin( Latitude );
+    LatDegree[i] = Latitude * rad2deg;
+    LongDegree[i] = atan2( y, x ) * rad2deg;
+  }
+  return true;
+}
+
+bool GeoProjectionConverter::LLtoECEF(const double* LatDegree, const double* LongDegree, const double* ElevationMeter, double* ECEFMeterX, double* ECEFMeterY, double* ECEFMeterZ, const size_t n, const GeoProjectionEllipsoid* ellipsoid) const
+{
+  const double A = ellipsoid->equatorial_radius;
+  const double flatfn = ellipsoid->eccentricity_squared;
+  const double FL = 1.0 / ellipsoid->inverse_flattening;
+  const double funsq = (1.0 - FL)*(1.0 - FL);
+
+  for (size_t i = 0; i < n; i++)
+  {
+    double lat_rad = deg2rad * LatDegree[i];
+    double lon_rad = deg2rad * LongDegree[i];
+    double elevation = ElevationMeter[i];
+    double sin_lat = sin(lat_rad);
+
+    double g1 = A / sqrt(1.0 - flatfn*sin_lat*sin_lat);
+    double g2 = g1*funsq + elevation;
+    g1 = g1 + elevation;
+
+    double g1_cos_lat = g1 * cos(lat_rad);
+    ECEFMeterX[i] = g1_cos_lat * cos(lon_rad);
+    ECEFMeterY[i] = g1_cos_lat * sin(lon_rad);
+    ECEFMeterZ[i] = g2 * sin_lat;
+  }
+  return true;
+}
+
 /*
   * The function AEACtoLL() converts Albers Equal Area Conic projection
   * (easting and northing) coordinates to Geodetic (latitude and longitude)
@@ -7667,6 +8143,9 @@ GeoProjectionConverter::GeoProjectionConverter()
   is_proj_request = false;
   disable_messages = false;
   source_header_epsg = 0;
+
+  proj_threads = 1;
+  proj_thread_pool = 0;
 }
 
 GeoProjectionConverter::~GeoProjectionConverter()
@@ -7676,6 +8155,7 @@ GeoProjectionConverter::~GeoProjectionConverter()
   delete ellipsoid;
   if (source_projection) delete source_projection;
   if (target_projection) delete target_projection;
+  if (proj_thread_pool) delete proj_thread_pool;
 }
 
 void GeoProjectionConverter::parse(int argc, char* argv[])
@@ -7995,6 +8475,15 @@ void GeoProjectionConverter::parse(int argc, char* argv[])
       *argv[i]='\0'; *argv[i+1]='\0'; i+=1;
     }
     //proj lib transformation
+    else if (strcmp(argv[i], "-proj_threads") == 0) {
+      unsigned int threads = 0;
+      if ((i + 1) >= argc || sscanf_las(argv[i + 1], "%u", &threads) != 1 || threads == 0)
+      {
+        laserror("'%s' needs 1 argument: number of threads", argv[i]);
+      }
+      set_proj_threads(threads);
+      *argv[i] = '\0'; *argv[i + 1] = '\0'; i += 1;
+    }
     else if (strcmp(argv[i], "-proj_epsg") == 0) {
       unsigned int source_code = 0;
       unsigned int target_code = 0;
@@ -9081,6 +9570,198 @@ bool GeoProjectionConverter::to_target(const double* point,  double &x, double &
   return false;
 }
 
+// transforms the x, y, z triples with one call into PROJ. like with proj_trans() the points that
+// fail are set to HUGE_VAL and the time is zero
+static void proj_trans_points(PJ* transform, double* points, size_t n)
+{
+  const size_t stride = 3 * sizeof(double);
+  double t = 0.0;
+  proj_trans_generic(transform, PJ_FWD, points, stride, n, points + 1, stride, n, points + 2, stride, n, &t, 0, 1);
+}
+
+// the projections that have array versions of their conversion routines
+
+static bool has_array_conversion(const int type)
+{
+  switch (type)
+  {
+  case GEO_PROJECTION_UTM:
+  case GEO_PROJECTION_LCC:
+  case GEO_PROJECTION_TM:
+  case GEO_PROJECTION_LONG_LAT:
+  case GEO_PROJECTION_LAT_LONG:
+  case GEO_PROJECTION_ECEF:
+    return true;
+  }
+  return false;
+}
+
+#define GEO_PROJECTION_BLOCK_SIZE 256
+
+bool GeoProjectionConverter::to_target(double* points, size_t n) const
+{
+  size_t i;
+  if (source_projection && target_projection)
+  {
+    if (!has_array_conversion(source_projection->type) || !has_array_conversion(target_projection->type))
+    {
+      for (i = 0; i < n; i++)
+      {
+        to_target(points + 3 * i);
+      }
+      return true;
+    }
+    // blocks of points go through the array versions of the conversions with bit-identical results to
+    // the per-point to_target() including how it treats the elevation
+    double x[GEO_PROJECTION_BLOCK_SIZE];
+    double y[GEO_PROJECTION_BLOCK_SIZE];
+    double z[GEO_PROJECTION_BLOCK_SIZE];
+    double latitude[GEO_PROJECTION_BLOCK_SIZE];
+    double longitude[GEO_PROJECTION_BLOCK_SIZE];
+    double elevation[GEO_PROJECTION_BLOCK_SIZE];
+    for (size_t start = 0; start < n; start += GEO_PROJECTION_BLOCK_SIZE)
+    {
+      double* block = points + 3 * start;
+      size_t count = (n - start < GEO_PROJECTION_BLOCK_SIZE ? n - start : GEO_PROJECTION_BLOCK_SIZE);
+      for (i = 0; i < count; i++)
+      {
+        x[i] = coordinates2meter * block[3 * i];
+        y[i] = coordinates2meter * block[3 * i + 1];
+        elevation[i] = block[3 * i + 2];
+      }
+
+      switch (source_projection->type)
+      {
+      case GEO_PROJECTION_UTM:
+        UTMtoLL(x, y, latitude, longitude, count, ellipsoid, (const GeoProjectionParametersUTM*)source_projection);
+        break;
+      case GEO_PROJECTION_LCC:
+        LCCtoLL(x, y, latitude, longitude, count, ellipsoid, (const GeoProjectionParametersLCC*)source_projection);
+        break;
+      case GEO_PROJECTION_TM:
+        TMtoLL(x, y, latitude, longitude, count, ellipsoid, (const GeoProjectionParametersTM*)source_projection);
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        for (i = 0; i < count; i++)
+        {
+          longitude[i] = block[3 * i];
+          latitude[i] = block[3 * i + 1];
+        }
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        for (i = 0; i < count; i++)
+        {
+          longitude[i] = block[3 * i + 1];
+          latitude[i] = block[3 * i];
+        }
+        break;
+      case GEO_PROJECTION_ECEF:
+        for (i = 0; i < count; i++)
+        {
+          z[i] = coordinates2meter * block[3 * i + 2];
+        }
+        ECEFtoLL(x, y, z, latitude, longitude, elevation, count, ellipsoid);
+        break;
+      }
+
+      switch (target_projection->type)
+      {
+      case GEO_PROJECTION_UTM:
+        if (((GeoProjectionParametersUTM*)target_projection)->utm_zone_number == -1) compute_utm_zone(latitude[0], longitude[0], (GeoProjectionParametersUTM*)target_projection);
+        LLtoUTM(latitude, longitude, x, y, count, ellipsoid, (const GeoProjectionParametersUTM*)target_projection);
+        break;
+      case GEO_PROJECTION_LCC:
+        // points that can not be projected keep their coordinates
+        for (i = 0; i < count; i++)
+        {
+          x[i] = block[3 * i];
+          y[i] = block[3 * i + 1];
+        }
+        LLtoLCC(latitude, longitude, x, y, count, ellipsoid, (const GeoProjectionParametersLCC*)target_projection);
+        break;
+      case GEO_PROJECTION_TM:
+        LLtoTM(latitude, longitude, x, y, count, ellipsoid, (const GeoProjectionParametersTM*)target_projection);
+        break;
+      case GEO_PROJECTION_LONG_LAT:
+        for (i = 0; i < count; i++)
+        {
+          block[3 * i] = longitude[i];
+          block[3 * i + 1] = latitude[i];
+        }
+        break;
+      case GEO_PROJECTION_LAT_LONG:
+        for (i = 0; i < count; i++)
+        {
+          block[3 * i] = latitude[i];
+          block[3 * i + 1] = longitude[i];
+        }
+        break;
+      case GEO_PROJECTION_ECEF:
+        LLtoECEF(latitude, longitude, elevation, x, y, elevation, count, ellipsoid);
+        for (i = 0; i < count; i++)
+        {
+          elevation[i] = meter2coordinates * elevation[i];
+        }
+        break;
+      }
+
+      if ((target_projection->type != GEO_PROJECTION_LONG_LAT) && (target_projection->type != GEO_PROJECTION_LAT_LONG))
+      {
+        for (i = 0; i < count; i++)
+        {
+          block[3 * i] = meter2coordinates * x[i];
+          block[3 * i + 1] = meter2coordinates * y[i];
+        }
+      }
+      for (i = 0; i < count; i++)
+      {
+        block[3 * i + 2] = meter2elevation * (elevation2meter * elevation[i] + elevation_offset_in_meter);
+      }
+    }
+    return true;
+  }
+  else if (projParameters.proj_target_crs)
+  {
+    if (!projParameters.proj_transform_crs)
+    {
+      return false;
+    }
+    if (!proj_trans_generic_ptr)
+    {
+      for (i = 0; i < n; i++)
+      {
+        do_proj_crs_transformation(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+      }
+      return true;
+    }
+    // each thread transforms one slice of at least 1024 points with its own copy of the transformation
+    size_t slices = (proj_thread_pool ? projParameters.proj_thread_count : 1);
+    if (slices > 1 + n / 1024) slices = 1 + n / 1024;
+    if (slices < 2)
+    {
+      proj_trans_points(projParameters.proj_transform_crs, points, n);
+      return true;
+    }
+    size_t slice = (n + slices - 1) / slices;
+    std::vector<std::future<void>> jobs;
+    for (i = 0; i < slices; i++)
+    {
+      size_t start = i * slice;
+      if (start >= n) break;
+      size_t count = (n - start < slice ? n - start : slice);
+      PJ* transform = projParameters.proj_thread_transform[i];
+      double* slice_points = points + 3 * start;
+      jobs.push_back(proj_thread_pool->submit<void>([transform, slice_points, count]() { proj_trans_points(transform, slice_points, count); }));
+    }
+    for (i = 0; i < jobs.size(); i++)
+    {
+      jobs[i].get();
+    }
+    return true;
+  }
+  return false;
+}
+
 bool GeoProjectionConverter::has_target_precision() const
 {
   return (target_precision ? true : false);
@@ -10150,7 +10831,54 @@ void GeoProjectionConverter::set_proj_crs_transform()
       }
     }
     LASMessage(LAS_VERY_VERBOSE, "the PROJ transformations object was successfully created");
+    set_proj_thread_transforms();
+  }
+}
+
+/// IMPORTANT: The Proj lib must be installed and loaded to use this functionality.
+/// sets the number of threads that transform batches of points
+void GeoProjectionConverter::set_proj_threads(unsigned int threads)
+{
+  proj_threads = (threads ? threads : 1);
+  set_proj_thread_transforms();
+}
+
+/// PROJ objects must not be shared between threads. so every thread gets its own context with its
+/// own copy of the transformation object
+void GeoProjectionConverter::set_proj_thread_transforms()
+{
+  unsigned int i;
+  for (i = 0; i < projParameters.proj_thread_count; i++) {
+    proj_destroy(projParameters.proj_thread_transform[i]);
+    proj_context_destroy(projParameters.proj_thread_ctx[i]);
+  }
+  delete[] projParameters.proj_thread_transform;
+  delete[] projParameters.proj_thread_ctx;
+  projParameters.proj_thread_transform = nullptr;
+  projParameters.proj_thread_ctx = nullptr;
+  projParameters.proj_thread_count = 0;
+  if (proj_thread_pool) {
+    delete proj_thread_pool;
+    proj_thread_pool = 0;
+  }
+
+  if ((proj_threads < 2) || !projParameters.proj_transform_crs) return;
+
+  if (!proj_clone_ptr || !proj_trans_generic_ptr) {
+    LASMessage(LAS_WARNING, "PROJ library cannot copy transformations. ignoring '-proj_threads %u' ...", proj_threads);
+    return;
+  }
+
+  projParameters.proj_thread_ctx = new PJ_CONTEXT*[proj_threads];
+  projParameters.proj_thread_transform = new PJ*[proj_threads];
+  for (i = 0; i < proj_threads; i++) {
+    projParameters.proj_thread_ctx[i] = proj_context_create();
+    projParameters.proj_thread_transform[i] = (projParameters.proj_thread_ctx[i] ? proj_clone(projParameters.proj_thread_ctx[i], projParameters.proj_transform_crs) : nullptr);
+    projParameters.proj_thread_count = i + 1;
+    if (!projParameters.proj_thread_transform[i]) laserror("Failed to copy the PROJ transformation for thread %u", i);
   }
+  proj_thread_pool = new LASthreadPool(proj_threads);
+  LASMessage(LAS_VERBOSE, "transforming batches of points with PROJ on %u threads", proj_threads);
 }
 
 /// IMPORTANT: The Proj lib must be installed and loaded to use this functionality.
@@ -10210,6 +10938,7 @@ void GeoProjectionConverter::set_proj_param_for_transformation_with_string(const
     if (type == PJ_TYPE_TRANSFORMATION || type == PJ_TYPE_CONVERSION || type == PJ_TYPE_CONCATENATED_OPERATION) {
       projParameters.proj_transform_crs = proj_crs;
       projParameters.proj_target_crs = proj_get_target_crs(projParameters.proj_ctx, projParameters.proj_transform_crs);
+      set_proj_thread_transforms();
 
       if (projParameters.proj_target_crs) {
         LASMessage(LAS_VERBOSE, "using PROJ transformation (piped) string '%s'", proj_source_string);
@@ -51,6 +51,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- array versions of the UTM, TM, LCC and ECEF conversions for batches of points
+    16 October 2026 -- to_target() for batches of points with proj_trans_generic() on several threads
      1 September 2024 -- integration of the PROJ Library for CRS transformations 
      1 November 2018 -- changes requested by Kirk Waters including GEO_GCS_NAD83_CORS96
      7 September 2018 -- introduced the LASCopyString macro to replace _strdup
@@ -73,6 +75,8 @@
 #include "proj_loader.h"
 #include <stdio.h>
 
+class LASthreadPool;
+
 struct GeoProjectionGeoKeys
 {
   unsigned short key_id;
@@ -293,6 +297,11 @@ class ProjParameters
   PJ* proj_source_crs;
   PJ* proj_target_crs;
   PJ* proj_transform_crs;
+
+  // one context and one copy of the transformation for each thread that transforms batches
+  unsigned int proj_thread_count;
+  PJ_CONTEXT** proj_thread_ctx;
+  PJ** proj_thread_transform;
   
   ProjParameters();
   ~ProjParameters();
@@ -451,6 +460,20 @@ public:
   bool OStoLL(const double OSEastingMeter, const double OSNorthingMeter, double& LatDegree,  double& LongDegree, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersOS* os) const;
   bool LLtoOS(const double LatDegree, const double LongDegree, double& OSEastingMeter,  double& OSNorthingMeter, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersOS* os) const;
 
+  // the same for 'n' coordinates stored in separate arrays (the outputs may be the inputs)
+
+  bool UTMtoLL(const double* UTMEastingMeter, const double* UTMNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersUTM* utm) const;
+  bool LLtoUTM(const double* LatDegree, const double* LongDegree, double* UTMEastingMeter, double* UTMNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersUTM* utm) const;
+
+  bool LCCtoLL(const double* LCCEastingMeter, const double* LCCNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersLCC* lcc) const;
+  bool LLtoLCC(const double* LatDegree, const double* LongDegree, double* LCCEastingMeter, double* LCCNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersLCC* lcc) const;
+
+  bool TMtoLL(const double* TMEastingMeter, const double* TMNorthingMeter, double* LatDegree, double* LongDegree, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersTM* tm) const;
+  bool LLtoTM(const double* LatDegree, const double* LongDegree, double* TMEastingMeter, double* TMNorthingMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid, const GeoProjectionParametersTM* tm) const;
+
+  bool ECEFtoLL(const double* ECEFMeterX, const double* ECEFMeterY, const double* ECEFMeterZ, double* LatDegree, double* LongDegree, double* ElevationMeter, const size_t n, const GeoProjectionEllipsoid* ellipsoid) const;
+  bool LLtoECEF(const double* LatDegree, const double* LongDegree, const double* ElevationMeter, double* ECEFMeterX, double* ECEFMeterY, double* ECEFMeterZ, const size_t n, const GeoProjectionEllipsoid* ellipsoid) const;
+
   GeoProjectionConverter();
   ~GeoProjectionConverter();
 
@@ -468,6 +491,10 @@ public:
   bool to_target(double* point) const;
   bool to_target(const double* point, double& x, double& y, double& elevation) const;
 
+  // the same for 'n' points stored as consecutive x, y, z triples
+
+  bool to_target(double* points, size_t n) const;
+
   bool has_target_precision() const;
   double get_target_precision() const;
   void set_target_precision(double target_precision);
@@ -489,6 +516,10 @@ public:
   void set_proj_crs_with_json(const char* json_filename, bool source = true);
   void set_proj_crs_with_wkt(const char* wkt_filename, bool source = true);
   void set_proj_crs_with_file_header_wkt(const char* wktContent, bool source = true);
+
+  // transform batches of points with PROJ on several threads
+  void set_proj_threads(unsigned int threads);
+  unsigned int get_proj_threads() const { return proj_threads; };
    
   // helps us to find the 'pcs.csv' file
   char* argv_zero;
@@ -554,5 +585,8 @@ private:
   void set_proj_param_for_transformation_with_json(const char* source_filename, const char* target_filename);
   void set_proj_param_for_transformation_with_wkt(const char* source_filename, const char* target_filename);
   bool do_proj_crs_transformation(double& x, double& y, double& elevation) const;
+  void set_proj_thread_transforms();
+  unsigned int proj_threads;
+  LASthreadPool* proj_thread_pool;
 };
 #pragma warning(pop)
\ No newline at end of file
@@ -33,6 +33,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- reproject the coordinates of batches of points with one call into the GeoProjectionConverter
     30 October 2020 -- fail / exit with error code when input file is corrupt
      9 September 2019 -- warn if modifying x or y coordinates for tiles with VLR
     30 November 2017 -- set OGC WKT with '-set_ogc_wkt "PROJCS[\"WGS84\",GEOGCS[\"GCS_ ..."
@@ -67,11 +68,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <cstdint> 
+#include <functional>
+#include <vector>
 
 #include "lastool.hpp"
 #include "lasreader.hpp"
 #include "laswriter.hpp"
 #include "lastransform.hpp"
+#include "laspipeline.hpp"
+#include "laspointbatch.hpp"
 #include "geoprojectionconverter.hpp"
 #include "bytestreamout_file.hpp"
 #include "bytestreamin_file.hpp"
@@ -107,6 +112,56 @@ static double taketime()
   return (double)(clock()) / CLOCKS_PER_SEC;
 }
 
+// reads the surviving points in batches, reprojects the coordinates of each batch with one call to the
+// GeoProjectionConverter and then hands the points one by one to 'process'
+static void read_reprojected_points(LASreader* lasreader, const GeoProjectionConverter& geoprojectionconverter, const LASquantizer* reproject_quantizer, const I64 stop, const bool clip_to_bounding_box, const std::function<void(LASpoint*)>& process)
+{
+  LASpointBatch batch;
+  if (!batch.init(&lasreader->point, LAS_POINT_BATCH_DEFAULT_SIZE, TRUE))
+  {
+    laserror("could not allocate batch of points for reprojection");
+  }
+  std::vector<F64> coordinates(3 * (size_t)batch.get_capacity());
+  U32 i;
+  BOOL more = TRUE;
+  while (more)
+  {
+    batch.clear();
+    while (!batch.is_full())
+    {
+      if (!lasreader->read_point() || (lasreader->p_count > stop))
+      {
+        more = FALSE;
+        break;
+      }
+      if (clip_to_bounding_box)
+      {
+        if (!lasreader->point.inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
+        {
+          continue;
+        }
+      }
+      batch.add(&lasreader->point);
+    }
+    for (i = 0; i < batch.count; i++)
+    {
+      coordinates[3 * i] = batch.quantizer->get_x(batch.X[i]);
+      coordinates[3 * i + 1] = batch.quantizer->get_y(batch.Y[i]);
+      coordinates[3 * i + 2] = batch.quantizer->get_z(batch.Z[i]);
+    }
+    geoprojectionconverter.to_target(coordinates.data(), batch.count);
+    for (i = 0; i < batch.count; i++)
+    {
+      batch.get_point(i, &lasreader->point);
+      lasreader->point.coordinates[0] = coordinates[3 * i];
+      lasreader->point.coordinates[1] = coordinates[3 * i + 1];
+      lasreader->point.coordinates[2] = coordinates[3 * i + 2];
+      lasreader->point.compute_XYZ(reproject_quantizer);
+      process(&lasreader->point);
+    }
+  }
+}
+
 static bool save_vlrs_to_file(const LASheader* header)
 {
   U32 i;
@@ -618,6 +673,7 @@ int main(int argc, char* argv[])
 {
   LasTool_las2las lastool;
   lastool.init(argc, argv, "las2las");
+  lastool.multi_core = true;
   int i;
   // fixed header changes
   int set_version_major = -1;
@@ -1117,8 +1173,7 @@ int main(int argc, char* argv[])
     }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
-      lasreadopener.add_file_name(argv[i]);
-      argv[i][0] = '\0';
+      lastool.add_input_name(&lasreadopener, i);
     }
     else
     {
@@ -1160,6 +1215,11 @@ int main(int argc, char* argv[])
   {
     las2las_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, 1, TRUE);
   }
+#else
+  if (lastool.cores > 1)
+  {
+    if (lastool.run_multi_core(&lasreadopener, &laswriteopener)) byebye();
+  }
 #endif
 
   // check input
@@ -2142,32 +2202,36 @@ int main(int argc, char* argv[])
           LASMessage(LAS_VERBOSE, "extra pass required: reading %lld points ...", lasreader->npoints);
           // maybe seek to start position
           if (subsequence_start) lasreader->seek(subsequence_start);
-          while (lasreader->read_point())
+          auto survey = [&](LASpoint* point)
           {
-            if (lasreader->p_count > subsequence_stop) break;
-        
-            if (clip_to_bounding_box)
-            {
-              if (!lasreader->point.inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
-              {
-                continue;
-              }
-            }
-        
-            if (reproject_quantizer)
-            {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
-            }
-            lasinventory.add(&lasreader->point);
+            lasinventory.add(point);
 
             if (doIntensityRangeGet)
             {
-              U16 ints = lasreader->point.get_intensity();
+              U16 ints = point->get_intensity();
               intensityMin = MIN2(ints, intensityMin);
               intensityMax = MAX2(ints, intensityMax);
             }
+          };
+          if (reproject_quantizer)
+          {
+            read_reprojected_points(lasreader, geoprojectionconverter, reproject_quantizer, subsequence_stop, clip_to_bounding_box, survey);
+          }
+          else
+          {
+            while (lasreader->read_point())
+            {
+              if (lasreader->p_count > subsequence_stop) break;
+
+              if (clip_to_bounding_box)
+              {
+                if (!lasreader->point.inside_box(lasreader->header.min_x, lasreader->header.min_y, lasreader->header.min_z, lasreader->header.max_x, lasreader->header.max_y, lasreader->header.max_z))
+                {
+                  continue;
+                }
+              }
+              survey(&lasreader->point);
+            }
           }
           lasreader->close();
 
@@ -2260,7 +2324,37 @@ int main(int argc, char* argv[])
 
         // loop over points
 
-        if (point) // full rewrite: point copy
+        if (lastool.pipeline && !clip_to_bounding_box && !reproject_quantizer)
+        {
+          LASpipeline laspipeline;
+          // without extra pass we need inventory of surviving points
+          laspipeline.run(lasreader, laswriter, !extra_pass, subsequence_stop, point);
+          if (point)
+          {
+            delete point;
+            point = 0;
+          }
+        }
+        else if (reproject_quantizer) // reprojection in batches
+        {
+          read_reprojected_points(lasreader, geoprojectionconverter, reproject_quantizer, subsequence_stop, clip_to_bounding_box, [&](LASpoint* reprojected)
+          {
+            if (point)
+            {
+              *point = *reprojected;
+              reprojected = point;
+            }
+            laswriter->write_point(reprojected);
+            // without extra pass we need inventory of surviving points
+            if (!extra_pass) laswriter->update_inventory(reprojected);
+          });
+          if (point)
+          {
+            delete point;
+            point = 0;
+          }
+        }
+        else if (point) // full rewrite: point copy
         {
           while (lasreader->read_point())
           {
@@ -2274,12 +2368,6 @@ int main(int argc, char* argv[])
               }
             }
 
-            if (reproject_quantizer)
-            {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
-            }
             *point = lasreader->point;
             laswriter->write_point(point);
             // without extra pass we need inventory of surviving points
@@ -2302,12 +2390,6 @@ int main(int argc, char* argv[])
               }
             }
 
-            if (reproject_quantizer)
-            {
-              lasreader->point.compute_coordinates();
-              geoprojectionconverter.to_target(lasreader->point.coordinates);
-              lasreader->point.compute_XYZ(reproject_quantizer);
-            }
             laswriter->write_point(&lasreader->point);
             // without extra pass we need inventory of surviving points
             if (!extra_pass) laswriter->update_inventory(&lasreader->point);
@@ -28,6 +28,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- lines are formatted without printf() and '-threads 4' converts batches of points in parallel
     19 September 2023 -- added support of custom extented -parse flags. Support of (hsl) and (hsv) flags
     18 September 2023 -- added -coldesc argument to add column description
      7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
@@ -53,16 +54,21 @@
 
 ===============================================================================
 */
+#include "laspointbatch.hpp"
 #include "lasreader.hpp"
+#include "lasthreadpool.hpp"
 #include "lastool.hpp"
 #include "laswaveform13reader.hpp"
 #include "laswriter.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 
+#include <cmath>
+#include <deque>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <vector>
 
 class LasTool_las2txt : public LasTool {
  private:
@@ -74,6 +80,7 @@ class LasTool_las2txt : public LasTool {
     fprintf(stderr, "las2txt -i flight1*.las flight2*.las -parse xyziarn\n");
     fprintf(stderr, "las2txt -i *.las -parse xyzrn -sep comma -verbose\n");
     fprintf(stderr, "las2txt -i lidar.las -parse xyztE -extra 99 -o ascii.txt\n");
+    fprintf(stderr, "las2txt -i huge.laz -parse xyzic -threads 4 -o huge.txt\n");
     fprintf(stderr, "las2txt -h\n");
     fprintf(stderr, "---------------------------------------------\n");
     fprintf(stderr, "The '-parse txyz' flag specifies how to format each\n");
@@ -116,85 +123,103 @@ static double taketime() {
   return (double)(clock()) / CLOCKS_PER_SEC;
 }
 
-static void lidardouble2string(CHAR* string, double value) {
-  int len;
-  len = sprintf(string, "%.15f", value) - 1;
-  while (string[len] == '0') len--;
-  if (string[len] != '.') len++;
-  string[len] = '\0';
+static CHAR* lidardouble2string(CHAR* string, double value) {
+  CHAR* end = dtoa_las(string, value, 15);
+  while (end[-1] == '0') end--;
+  if (end[-1] == '.') end--;
+  *end = '\0';
+  return end;
 }
 
-static void lidardouble2string(CHAR* string, double value, double precision) {
+static CHAR* lidardouble2string(CHAR* string, double value, double precision) {
+  I32 decimals;
   if (precision == 0.01)
-    sprintf(string, "%.2f", value);
+    decimals = 2;
   else if (precision == 0.001)
-    sprintf(string, "%.3f", value);
+    decimals = 3;
   else if (precision == 0.0001)
-    sprintf(string, "%.4f", value);
+    decimals = 4;
   else if (precision == 0.1)
-    sprintf(string, "%.1f", value);
+    decimals = 1;
   else if (precision == 0.00001)
-    sprintf(string, "%.5f", value);
+    decimals = 5;
   else if (precision == 0.000001)
-    sprintf(string, "%.6f", value);
+    decimals = 6;
   else if (precision == 0.0000001)
-    sprintf(string, "%.7f", value);
+    decimals = 7;
   else if (precision == 0.00000001)
-    sprintf(string, "%.8f", value);
+    decimals = 8;
   else if (precision == 0.000000001)
-    sprintf(string, "%.9f", value);
+    decimals = 9;
   else if (precision == 0.0025)
-    sprintf(string, "%.4f", value);
+    decimals = 4;
   else if (precision == 0.00025)
-    sprintf(string, "%.5f", value);
+    decimals = 5;
   else if (precision == 0.000025)
-    sprintf(string, "%.6f", value);
+    decimals = 6;
   else if (precision == 0.005)
-    sprintf(string, "%.3f", value);
+    decimals = 3;
   else if (precision == 0.0005)
-    sprintf(string, "%.4f", value);
+    decimals = 4;
   else if (precision == 0.00005)
-    sprintf(string, "%.5f", value);
+    decimals = 5;
   else if (precision == 0.0000000001)
-    sprintf(string, "%.10f", value);
+    decimals = 10;
   else if (precision == 0.00000000001)
-    sprintf(string, "%.11f", value);
+    decimals = 11;
   else if (precision == 0.000000000001)
-    sprintf(string, "%.12f", value);
+    decimals = 12;
   else if (precision == 0.0000000000001)
-    sprintf(string, "%.13f", value);
+    decimals = 13;
   else if (precision == 0.00000000000001)
-    sprintf(string, "%.14f", value);
+    decimals = 14;
   else if (precision == 0.000000000000001)
-    sprintf(string, "%.15f", value);
+    decimals = 15;
   else
-    lidardouble2string(string, value);
+    return lidardouble2string(string, value);
+  CHAR* end = dtoa_las(string, value, decimals);
+  *end = '\0';
+  return end;
 }
 
-static void output_waveform(FILE* file_out, CHAR separator_sign, LASwaveform13reader* laswaveform13reader) {
+// same as printf's "%g" but without the formatting overhead for the many values that are integral
+static CHAR* lidardouble2string_g(CHAR* string, double value) {
+  if ((value > -1000000.0) && (value < 1000000.0) && (value == (double)(I32)value) && ((value != 0.0) || !std::signbit(value))) {
+    return itoa_las(string, (I32)value);
+  }
+  return string + snprintf(string, 32, "%g", value);
+}
+
+static CHAR* output_waveform(CHAR* out, CHAR separator_sign, LASwaveform13reader* laswaveform13reader) {
   U32 i;
-  fprintf(file_out, "%d", laswaveform13reader->nbits);
-  fprintf(file_out, "%c%d", separator_sign, laswaveform13reader->nsamples);
+  out = itoa_las(out, (I32)laswaveform13reader->nbits);
+  *out++ = separator_sign;
+  out = itoa_las(out, (I32)laswaveform13reader->nsamples);
   if (laswaveform13reader->nbits == 8) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, laswaveform13reader->samples[i]);
+      *out++ = separator_sign;
+      out = itoa_las(out, laswaveform13reader->samples[i]);
     }
   } else if (laswaveform13reader->nbits == 16) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, ((U16*)laswaveform13reader->samples)[i]);
+      *out++ = separator_sign;
+      out = itoa_las(out, ((U16*)laswaveform13reader->samples)[i]);
     }
   } else if (laswaveform13reader->nbits == 32) {
     for (i = 0; i < laswaveform13reader->nsamples; i++) {
-      fprintf(file_out, "%c%d", separator_sign, ((I32*)laswaveform13reader->samples)[i]);
+      *out++ = separator_sign;
+      out = itoa_las(out, ((I32*)laswaveform13reader->samples)[i]);
     }
   }
+  return out;
 }
 
 static I32 attribute_starts[32];
 
-static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint* point, I32 index, CHAR* printstring) {
+// writes the attribute with the given index and returns the end of the text
+static CHAR* print_attribute(CHAR* out, const LASheader* header, const LASpoint* point, I32 index) {
   if (index >= header->number_attributes) {
-    return FALSE;
+    return out;
   }
   if (header->attributes[index].data_type == 1) {
     U8 value;
@@ -202,20 +227,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%d", (I32)value);
+        return itoa_las(out, (I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 2) {
@@ -224,20 +246,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%d", (I32)value);
+        return itoa_las(out, (I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 3) {
@@ -246,20 +265,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%d", (I32)value);
+        return itoa_las(out, (I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 4) {
@@ -268,20 +284,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%d", (I32)value);
+        return itoa_las(out, (I32)value);
       }
     }
   } else if (header->attributes[index].data_type == 5) {
@@ -290,20 +303,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%u", value);
+        return itoa_las(out, value);
       }
     }
   } else if (header->attributes[index].data_type == 6) {
@@ -312,20 +322,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%d", value);
+        return itoa_las(out, value);
       }
     }
   } else if (header->attributes[index].data_type == 7) {
@@ -334,23 +341,20 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * ((I64)value) + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * ((I64)value);
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + ((I64)value);
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
 #ifdef _WIN32
-        fprintf(file, "%I64u", value);
+        return out + snprintf(out, 32, "%I64u", value);
 #else
-        fprintf(file, "%llu", value);
+        return out + snprintf(out, 32, "%llu", value);
 #endif
       }
     }
@@ -360,20 +364,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%lld", value);
+        return itoa_las(out, value);
       }
     }
   } else if (header->attributes[index].data_type == 9) {
@@ -382,20 +383,17 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%g", value);
+        return lidardouble2string_g(out, value);
       }
     }
   } else if (header->attributes[index].data_type == 10) {
@@ -404,28 +402,24 @@ static BOOL print_attribute(FILE* file, const LASheader* header, const LASpoint*
     if (header->attributes[index].has_scale()) {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].scale[0] * value + header->attributes[index].offset[0];
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       } else {
         F64 temp_d = header->attributes[index].scale[0] * value;
-        lidardouble2string(printstring, temp_d, header->attributes[index].scale[0]);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d, header->attributes[index].scale[0]);
       }
     } else {
       if (header->attributes[index].has_offset()) {
         F64 temp_d = header->attributes[index].offset[0] + value;
-        lidardouble2string(printstring, temp_d);
-        fprintf(file, "%s", printstring);
+        return lidardouble2string(out, temp_d);
       } else {
-        fprintf(file, "%g", value);
+        return lidardouble2string_g(out, value);
       }
     }
   } else {
-    fprintf(file, "-");
+    *out++ = '-';
     LASMessage(LAS_WARNING, "data type %d of attribute %d not implemented.", header->attributes[index].data_type, index);
-    return FALSE;
   }
-  return TRUE;
+  return out;
 }
 
 enum extended_flags { HSV = -1, HSL = -2, HSV255 = -3, HSL255 = -4 };
@@ -448,6 +442,76 @@ static void parse_extended_flags(char* parse_string) {
   }
 }
 
+// the lines are collected in a large buffer that is written with one fwrite() once it holds this many bytes
+#define LAS2TXT_FLUSH_SIZE (1 << 20)
+
+// with '-threads' the points are converted in batches of this many points
+#define LAS2TXT_BATCH_SIZE 16384
+
+// a growing buffer of text lines
+class LAStxtBuffer {
+ public:
+  CHAR* data = 0;
+  size_t size = 0;
+  size_t capacity = 0;
+
+  // returns where to write the next (at most) 'bytes' characters
+  CHAR* reserve(const size_t bytes) {
+    if ((size + bytes) > capacity) {
+      size_t grown = (capacity ? 2 * capacity : LAS2TXT_FLUSH_SIZE);
+      while (grown < (size + bytes)) grown *= 2;
+      CHAR* grown_data = (CHAR*)realloc(data, grown);
+      if (grown_data == 0) {
+        laserror("allocating %llu bytes for text output", (U64)grown);
+      }
+      data = grown_data;
+      capacity = grown;
+    }
+    return data + size;
+  };
+  // keeps what was written up to 'end' and returns where to write the next (at most) 'bytes' characters
+  CHAR* extend(CHAR* end, const size_t bytes) {
+    size = end - data;
+    return reserve(bytes);
+  };
+  void commit(CHAR* end) { size = end - data; };
+  void flush(FILE* file) {
+    if (size && (fwrite(data, 1, size, file) != size)) {
+      LASMessage(LAS_WARNING, "could not write %llu bytes of text", (U64)size);
+    }
+    size = 0;
+  };
+  ~LAStxtBuffer() { free(data); };
+};
+
+// the values of the previous point that the differences in the parse string refer to
+struct LAStxtPrevious {
+  I32 XYZ[3] = {0, 0, 0};
+  U16 RGB[3] = {0, 0, 0};
+  F64 gps_time = 0;
+
+  void set(const LASpoint* point) {
+    XYZ[0] = point->get_X();
+    XYZ[1] = point->get_Y();
+    XYZ[2] = point->get_Z();
+    gps_time = point->gps_time;
+    RGB[0] = point->rgb[0];
+    RGB[1] = point->rgb[1];
+    RGB[2] = point->rgb[2];
+  };
+};
+
+// a batch of points that one of the '-threads' converts to text lines
+class LAStxtSlot {
+ public:
+  LASpointBatch batch;
+  std::vector<I64> p_counts;
+  LAStxtPrevious previous;  // the point before the first point of the batch
+  LASpoint point;
+  LAStxtBuffer text;
+  std::future<BOOL> formatted;
+};
+
 #ifdef COMPILE_WITH_GUI
 extern int las2txt_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
@@ -459,6 +523,7 @@ extern void las2txt_multi_core(int argc, char* argv[], LASreadOpener* lasreadope
 int main(int argc, char* argv[]) {
   LasTool_las2txt lastool;
   lastool.init(argc, argv, "las2txt");
+  lastool.multi_core = true;
   int i;
   bool diff = false;
   CHAR separator_sign = ' ';
@@ -472,6 +537,7 @@ int main(int argc, char* argv[]) {
   CHAR printstring[512];
   double start_time = 0.0;
   bool coldesc = false;
+  U32 threads = 1;
 
   LASreadOpener lasreadopener;
   LASwriteOpener laswriteopener;
@@ -574,9 +640,11 @@ int main(int argc, char* argv[]) {
       }
     } else if (strcmp(argv[i], "-coldesc") == 0) {
       coldesc = true;
+    } else if (strcmp(argv[i], "-threads") == 0) {
+      threads = lastool.parse_arg_threads(i);
+      i++;
     } else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0)) {
-      lasreadopener.add_file_name(argv[i]);
-      argv[i][0] = '\0';
+      lastool.add_input_name(&lasreadopener, i);
     } else {
       return false;
     }
@@ -606,6 +674,10 @@ int main(int argc, char* argv[]) {
   if (lastool.cpu64) {
     las2txt_multi_core(argc, argv, &lasreadopener, &laswriteopener, 1, TRUE);
   }
+#else
+  if (lastool.cores > 1) {
+    if (lastool.run_multi_core(&lasreadopener, &laswriteopener)) byebye();
+  }
 #endif
 
   // check input
@@ -1041,10 +1113,6 @@ int main(int argc, char* argv[]) {
       }
       i++;
     }
-    // in case diff is requested
-    int last_XYZ[3] = {0, 0, 0};
-    unsigned short last_RGB[4] = {0, 0, 0};
-    double last_GPSTIME = 0;
     // read and convert the points to ASCII
     LASMessage(LAS_VERBOSE, "processing %lld points with '%s'.", lasreader->npoints, parse_string);
     // print the column names in the first line
@@ -1195,199 +1263,224 @@ int main(int argc, char* argv[]) {
       }
     }
 
-    while (lasreader->read_point()) {
-      i = 0;
+    // converts one point to a line of text. with 'V' the waveforms are read from the *.wdp file so that
+    // only the points of this thread can be converted
+    size_t line_size = strlen(parse_string) * (352 + (extra_string ? strlen(extra_string) : 0)) + 2;
+    auto format_point = [&](LAStxtBuffer* text, const LASpoint* point, const I64 p_count, const LAStxtPrevious* previous) {
+      CHAR* out = text->reserve(line_size);
+      I32 i = 0;
+      I32 index;
       while (true) {
         switch (parse_string[i]) {
           case 'x':  // the x coordinate
-            lidardouble2string(printstring, lasreader->point.get_x(), lasreader->header.x_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            out = lidardouble2string(out, point->get_x(), header->x_scale_factor);
             break;
           case 'y':  // the y coordinate
-            lidardouble2string(printstring, lasreader->point.get_y(), lasreader->header.y_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            out = lidardouble2string(out, point->get_y(), header->y_scale_factor);
             break;
           case 'z':  // the z coordinate
-            lidardouble2string(printstring, lasreader->point.get_z(), lasreader->header.z_scale_factor);
-            fprintf(file_out, "%s", printstring);
+            out = lidardouble2string(out, point->get_z(), header->z_scale_factor);
             break;
           case 'X':  // the unscaled raw integer X coordinate
-            fprintf(file_out, "%d", lasreader->point.get_X());
+            out = itoa_las(out, point->get_X());
             break;
           case 'Y':  // the unscaled raw integer Y coordinate
-            fprintf(file_out, "%d", lasreader->point.get_Y());
+            out = itoa_las(out, point->get_Y());
             break;
           case 'Z':  // the unscaled raw integer Z coordinate
-            fprintf(file_out, "%d", lasreader->point.get_Z());
+            out = itoa_las(out, point->get_Z());
             break;
           case 't':  // the gps-time
-            fprintf(file_out, "%.6f", lasreader->point.get_gps_time());
+            out = dtoa_las(out, point->get_gps_time(), 6);
             break;
           case 'i':  // the intensity
             if (opts)
-              fprintf(file_out, "%d", -2048 + lasreader->point.get_intensity());
+              out = itoa_las(out, -2048 + point->get_intensity());
             else if (optx) {
-              int len;
-              len = sprintf(printstring, "%.3f", 1.0f / 4095.0f * lasreader->point.get_intensity()) - 1;
-              while (printstring[len] == '0') len--;
-              if (printstring[len] != '.') len++;
-              printstring[len] = '\0';
-              fprintf(file_out, "%s", printstring);
+              out = dtoa_las(out, 1.0f / 4095.0f * point->get_intensity(), 3);
+              while (out[-1] == '0') out--;
+              if (out[-1] == '.') out--;
             } else
-              fprintf(file_out, "%d", lasreader->point.get_intensity());
+              out = itoa_las(out, point->get_intensity());
             break;
           case 'a':  // the scan angle
-            fprintf(file_out, "%g", lasreader->point.get_scan_angle());
+            out = lidardouble2string_g(out, point->get_scan_angle());
             break;
           case 'r':  // the number of the return
             if (header->point_data_format > 5) {
-              fprintf(file_out, "%d", lasreader->point.get_extended_return_number());
+              out = itoa_las(out, point->get_extended_return_number());
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_return_number());
+              out = itoa_las(out, point->get_return_number());
             }
             break;
           case 'c':  // the classification
             if (header->point_data_format > 5) {
-              if (lasreader->point.get_extended_classification()) {
-                fprintf(file_out, "%d", lasreader->point.get_extended_classification());
+              if (point->get_extended_classification()) {
+                out = itoa_las(out, point->get_extended_classification());
               } else {
-                fprintf(file_out, "%d", lasreader->point.get_classification());
+                out = itoa_las(out, point->get_classification());
               }
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_classification());
+              out = itoa_las(out, point->get_classification());
             }
             break;
           case 'u':  // the user data
-            fprintf(file_out, "%d", lasreader->point.get_user_data());
+            out = itoa_las(out, point->get_user_data());
             break;
           case 'n':  // the number of returns of given pulse
             if (header->point_data_format > 5) {
-              fprintf(file_out, "%d", lasreader->point.get_extended_number_of_returns());
+              out = itoa_las(out, point->get_extended_number_of_returns());
             } else {
-              fprintf(file_out, "%d", lasreader->point.get_number_of_returns());
+              out = itoa_las(out, point->get_number_of_returns());
             }
             break;
           case 'p':  // the point source ID
-            fprintf(file_out, "%d", lasreader->point.get_point_source_ID());
+            out = itoa_las(out, point->get_point_source_ID());
             break;
           case 'e':  // the edge of flight line flag
-            fprintf(file_out, "%d", lasreader->point.get_edge_of_flight_line());
+            out = itoa_las(out, point->get_edge_of_flight_line());
             break;
           case 'd':  // the direction of scan flag
-            fprintf(file_out, "%d", lasreader->point.get_scan_direction_flag());
+            out = itoa_las(out, point->get_scan_direction_flag());
             break;
           case 'h':  // the withheld flag
-            fprintf(file_out, "%d", lasreader->point.get_withheld_flag());
+            out = itoa_las(out, point->get_withheld_flag());
             break;
           case 'k':  // the keypoint flag
-            fprintf(file_out, "%d", lasreader->point.get_keypoint_flag());
+            out = itoa_las(out, point->get_keypoint_flag());
             break;
           case 'g':  // the synthetic flag
-            fprintf(file_out, "%d", lasreader->point.get_synthetic_flag());
+            out = itoa_las(out, point->get_synthetic_flag());
             break;
           case 'o':  // the (extended) overlap flag
-            fprintf(file_out, "%d", lasreader->point.get_extended_overlap_flag());
+            out = itoa_las(out, point->get_extended_overlap_flag());
             break;
           case 'l':  // the (extended) scanner channel
-            fprintf(file_out, "%d", lasreader->point.get_extended_scanner_channel());
+            out = itoa_las(out, point->get_extended_scanner_channel());
             break;
           case 'R':  // the red channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[0]);
+            out = itoa_las(out, point->rgb[0]);
             break;
           case 'G':  // the green channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[1]);
+            out = itoa_las(out, point->rgb[1]);
             break;
           case 'B':  // the blue channel of the RGB field
-            fprintf(file_out, "%d", lasreader->point.rgb[2]);
+            out = itoa_las(out, point->rgb[2]);
             break;
           case 'I':  // the near-infrared channel of the RGBI field
-            fprintf(file_out, "%d", lasreader->point.rgb[3]);
+            out = itoa_las(out, point->rgb[3]);
             break;
           case 'm':  // the index of the point (count starts at 0)
-            fprintf(file_out, "%lld", lasreader->p_count - 1);
+            out = itoa_las(out, p_count - 1);
             break;
           case 'M':  // the index of the point  (count starts at 1)
-            fprintf(file_out, "%lld", lasreader->p_count);
+            out = itoa_las(out, p_count);
             break;
           case '_':  // the raw integer X difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_X() - last_XYZ[0]);
+            out = itoa_las(out, point->get_X() - previous->XYZ[0]);
             break;
           case '!':  // the raw integer Y difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_Y() - last_XYZ[1]);
+            out = itoa_las(out, point->get_Y() - previous->XYZ[1]);
             break;
           case '@':  // the raw integer Z difference to the last point
-            fprintf(file_out, "%d", lasreader->point.get_Z() - last_XYZ[2]);
+            out = itoa_las(out, point->get_Z() - previous->XYZ[2]);
             break;
           case '#':  // the gps-time difference to the last point
-            lidardouble2string(printstring, lasreader->point.gps_time - last_GPSTIME);
-            fprintf(file_out, "%s", printstring);
+            out = lidardouble2string(out, point->gps_time - previous->gps_time);
             break;
           case '$':  // the R difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[0] - last_RGB[0]);
+            out = itoa_las(out, point->rgb[0] - previous->RGB[0]);
             break;
           case '%':  // the G difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[1] - last_RGB[1]);
+            out = itoa_las(out, point->rgb[1] - previous->RGB[1]);
             break;
           case '^':  // the B difference to the last point
-            fprintf(file_out, "%d", lasreader->point.rgb[2] - last_RGB[2]);
+            out = itoa_las(out, point->rgb[2] - previous->RGB[2]);
             break;
           case '&':  // the byte-wise R difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[0] >> 8) - (last_RGB[0] >> 8), separator_sign,
-                (lasreader->point.rgb[0] & 255) - (last_RGB[0] & 255));
+            out = itoa_las(out, (point->rgb[0] >> 8) - (previous->RGB[0] >> 8));
+            *out++ = separator_sign;
+            out = itoa_las(out, (point->rgb[0] & 255) - (previous->RGB[0] & 255));
             break;
           case '*':  // the byte-wise G difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[1] >> 8) - (last_RGB[1] >> 8), separator_sign,
-                (lasreader->point.rgb[1] & 255) - (last_RGB[1] & 255));
+            out = itoa_las(out, (point->rgb[1] >> 8) - (previous->RGB[1] >> 8));
+            *out++ = separator_sign;
+            out = itoa_las(out, (point->rgb[1] & 255) - (previous->RGB[1] & 255));
             break;
           case '+':  // the byte-wise B difference to the last point
-            fprintf(
-                file_out, "%d%c%d", (lasreader->point.rgb[2] >> 8) - (last_RGB[2] >> 8), separator_sign,
-                (lasreader->point.rgb[2] & 255) - (last_RGB[2] & 255));
+            out = itoa_las(out, (point->rgb[2] >> 8) - (previous->RGB[2] >> 8));
+            *out++ = separator_sign;
+            out = itoa_las(out, (point->rgb[2] & 255) - (previous->RGB[2] & 255));
             break;
           case 'w':  // the wavepacket index
-            fprintf(file_out, "%d", lasreader->point.wavepacket.getIndex());
+            out = itoa_las(out, point->wavepacket.getIndex());
             break;
           case 'W':  // all wavepacket attributes
-            fprintf(
-                file_out, "%d%c%d%c%d%c%g%c%g%c%g%c%g", lasreader->point.wavepacket.getIndex(), separator_sign,
-                (U32)lasreader->point.wavepacket.getOffset(), separator_sign, lasreader->point.wavepacket.getSize(), separator_sign,
-                lasreader->point.wavepacket.getLocation(), separator_sign, lasreader->point.wavepacket.getXt(), separator_sign,
-                lasreader->point.wavepacket.getYt(), separator_sign, lasreader->point.wavepacket.getZt());
+            out = itoa_las(out, point->wavepacket.getIndex());
+            *out++ = separator_sign;
+            out = itoa_las(out, (I32)(U32)point->wavepacket.getOffset());
+            *out++ = separator_sign;
+            out = itoa_las(out, (I32)point->wavepacket.getSize());
+            *out++ = separator_sign;
+            out = lidardouble2string_g(out, point->wavepacket.getLocation());
+            *out++ = separator_sign;
+            out = lidardouble2string_g(out, point->wavepacket.getXt());
+            *out++ = separator_sign;
+            out = lidardouble2string_g(out, point->wavepacket.getYt());
+            *out++ = separator_sign;
+            out = lidardouble2string_g(out, point->wavepacket.getZt());
             break;
           case 'V':  // the waVeform
-            if (laswaveform13reader && laswaveform13reader->read_waveform(&lasreader->point)) {
-              output_waveform(file_out, separator_sign, laswaveform13reader);
+            if (laswaveform13reader && laswaveform13reader->read_waveform(point)) {
+              out = text->extend(out, line_size + 12 * ((size_t)laswaveform13reader->nsamples + 2));
+              out = output_waveform(out, separator_sign, laswaveform13reader);
             } else {
-              fprintf(file_out, "no_waveform");
+              memcpy(out, "no_waveform", 11);
+              out += 11;
             }
             break;
           case 'E':  // the extra string
-            fprintf(file_out, "%s", extra_string);
+            memcpy(out, extra_string, strlen(extra_string));
+            out += strlen(extra_string);
             break;
           case HSV255: {  // the HSV representation of RGB
             F32 hsv[3];
-            lasreader->point.get_hsv(hsv);
-            fprintf(file_out, "%d%c%d%c%d", (U16)(hsv[0] * 360), separator_sign, (U8)(hsv[1] * 100), separator_sign, (U8)(hsv[2] * 100));
+            point->get_hsv(hsv);
+            out = itoa_las(out, (U16)(hsv[0] * 360));
+            *out++ = separator_sign;
+            out = itoa_las(out, (U8)(hsv[1] * 100));
+            *out++ = separator_sign;
+            out = itoa_las(out, (U8)(hsv[2] * 100));
             break;
           }
           case HSV: {  // the HSV representation of RGB
             F32 hsv[3];
-            lasreader->point.get_hsv(hsv);
-            fprintf(file_out, "%.3f%c%.3f%c%.3f", hsv[0], separator_sign, hsv[1], separator_sign, hsv[2]);
+            point->get_hsv(hsv);
+            out = dtoa_las(out, hsv[0], 3);
+            *out++ = separator_sign;
+            out = dtoa_las(out, hsv[1], 3);
+            *out++ = separator_sign;
+            out = dtoa_las(out, hsv[2], 3);
             break;
           }
           case HSL255: {  // the HSL representation of RGB
             F32 hsl[3];
-            lasreader->point.get_hsl(hsl);
-            fprintf(file_out, "%d%c%d%c%d", (U16)(hsl[0] * 360), separator_sign, (U8)(hsl[1] * 100), separator_sign, (U8)(hsl[2] * 100));
+            point->get_hsl(hsl);
+            out = itoa_las(out, (U16)(hsl[0] * 360));
+            *out++ = separator_sign;
+            out = itoa_las(out, (U8)(hsl[1] * 100));
+            *out++ = separator_sign;
+            out = itoa_las(out, (U8)(hsl[2] * 100));
             break;
           }
           case HSL: {  // the HSL representation of RGB
             F32 hsl[3];
-            lasreader->point.get_hsl(hsl);
-            fprintf(file_out, "%.3f%c%.3f%c%.3f", hsl[0], separator_sign, hsl[1], separator_sign, hsl[2]);
+            point->get_hsl(hsl);
+            out = dtoa_las(out, hsl[0], 3);
+            *out++ = separator_sign;
+            out = dtoa_las(out, hsl[1], 3);
+            *out++ = separator_sign;
+            out = dtoa_las(out, hsl[2], 3);
             break;
           }
           case '0':  // the extra attributes
@@ -1400,7 +1493,7 @@ int main(int argc, char* argv[]) {
           case '7':  // the extra attributes
           case '8':  // the extra attributes
           case '9':  // the extra attributes
-            print_attribute(file_out, &lasreader->header, &lasreader->point, (I32)(parse_string[i] - '0'), printstring);
+            out = print_attribute(out, header, point, (I32)(parse_string[i] - '0'));
             break;
           default:
             index = 0;
@@ -1409,25 +1502,83 @@ int main(int argc, char* argv[]) {
               index = 10 * index + (parse_string[i] - '0');
               i++;
             }
-            print_attribute(file_out, &lasreader->header, &lasreader->point, index, printstring);
+            out = print_attribute(out, header, point, index);
         }
         i++;
         if (parse_string[i]) {
-          fprintf(file_out, "%c", separator_sign);
+          *out++ = separator_sign;
         } else {
-          fprintf(file_out, "\012");
+          *out++ = '\012';
           break;
         }
       }
-      if (diff) {
-        last_XYZ[0] = lasreader->point.get_X();
-        last_XYZ[1] = lasreader->point.get_Y();
-        last_XYZ[2] = lasreader->point.get_Z();
-        last_GPSTIME = lasreader->point.gps_time;
-        last_RGB[0] = lasreader->point.rgb[0];
-        last_RGB[1] = lasreader->point.rgb[1];
-        last_RGB[2] = lasreader->point.rgb[2];
+      text->commit(out);
+    };
+
+    if ((threads > 1) && (strchr(parse_string, 'V') == 0)) {
+      // this thread reads the points in batches, the pool converts them to text and this thread writes the
+      // text of the batches in the order they were read
+
+      LASthreadPool pool(threads);
+      std::vector<LAStxtSlot> slots(2 * threads);
+      std::vector<LAStxtSlot*> idle;
+      std::deque<LAStxtSlot*> formatting;
+      for (LAStxtSlot& slot : slots) {
+        if (!slot.batch.init(&lasreader->point, LAS2TXT_BATCH_SIZE, TRUE)) {
+          laserror("could not allocate point batches for '-threads %u'", threads);
+        }
+        slot.p_counts.resize(LAS2TXT_BATCH_SIZE);
+        slot.point.init(lasreader->point.quantizer, lasreader->point.num_items, lasreader->point.items, lasreader->point.attributer);
+        idle.push_back(&slot);
+      }
+      LAStxtPrevious previous;
+      BOOL more = TRUE;
+      while (more || formatting.size()) {
+        if (more && idle.size()) {
+          LAStxtSlot* slot = idle.back();
+          idle.pop_back();
+          slot->batch.clear();
+          slot->previous = previous;
+          while (!slot->batch.is_full()) {
+            if (!lasreader->read_point()) {
+              more = FALSE;
+              break;
+            }
+            slot->p_counts[slot->batch.count] = lasreader->p_count;
+            slot->batch.add(&lasreader->point);
+          }
+          if (slot->batch.count == 0) {
+            idle.push_back(slot);
+            continue;
+          }
+          if (diff) previous.set(&lasreader->point);
+          slot->formatted = pool.submit<BOOL>([&, slot]() -> BOOL {
+            LAStxtPrevious last = slot->previous;
+            for (U32 j = 0; j < slot->batch.count; j++) {
+              slot->batch.get_point(j, &slot->point);
+              format_point(&slot->text, &slot->point, slot->p_counts[j], &last);
+              if (diff) last.set(&slot->point);
+            }
+            return TRUE;
+          });
+          formatting.push_back(slot);
+        } else {
+          LAStxtSlot* slot = formatting.front();
+          formatting.pop_front();
+          slot->formatted.get();
+          slot->text.flush(file_out);
+          idle.push_back(slot);
+        }
+      }
+    } else {
+      LAStxtBuffer text;
+      LAStxtPrevious previous;
+      while (lasreader->read_point()) {
+        format_point(&text, &lasreader->point, lasreader->p_count, &previous);
+        if (diff) previous.set(&lasreader->point);
+        if (text.size >= LAS2TXT_FLUSH_SIZE) text.flush(file_out);
       }
+      text.flush(file_out);
     }
     LASMessage(
         LAS_VERBOSE, "converting %lld points of '%s' took %g sec.", lasreader->p_count, lasreadopener.get_file_name(), taketime() - start_time);
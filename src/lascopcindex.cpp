@@ -49,6 +49,9 @@
 
  CHANGE HISTORY:
 
+ 16 October 2026 -- voxel occupancy of the octants in a compact hash table with its memory reported under '-verbose'
+ 16 October 2026 -- '-ondisk' spills runs of points to one file within the memory budget '-max_memory 4000'
+ 16 October 2026 -- '-threads 4' checks, sorts (not with '-ondisk') and compresses finalized octants in parallel
  24 May 2023 -- created after planting vegetable in the garden
 
  ===============================================================================
@@ -57,12 +60,14 @@
 #include <errno.h>
 #include <stdlib.h>
 #include <time.h>
+#include <algorithm>
 #include <cmath>
 #include <memory>
 #include <stdexcept>
 #include <unordered_map>
 
 #include "lasreadpoint.hpp"
+#include "lasthreadpool.hpp"
 #include "lasreader.hpp"
 #include "laswriter.hpp"
 #include "lascopc.hpp"
@@ -74,13 +79,6 @@
 #define strcasecmp _stricmp
 #endif
 
-// Default: Linux 1024, Windows 512 may be increased to 2048 with MSVC, MacOS ??? (minus 3 for stdin, stderr, stdout)
-#ifdef _WIN32
-I32 MAX_FOPEN = 500;
-#else
-I32 MAX_FOPEN = 1000;
-#endif
-
 class LasTool_lascopcindex : public LasTool
 {
 private:
@@ -98,6 +96,8 @@ public:
     fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -root_light\n");
     fprintf(stderr, "lascopcindex tls.laz -tls\n");
     fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -ondisk -verbose\n");
+    fprintf(stderr, "lascopcindex -merged -i *.las -o out.copc.laz -max_memory 4000\n");
+    fprintf(stderr, "lascopcindex -i big.laz -o big.copc.laz -threads 4\n");
     fprintf(stderr, "lascopcindex -h\n");
   };
 };
@@ -245,6 +245,98 @@ struct VoxelRecord
   VoxelRecord(U16 buf, I32 pos) { bufid = buf; posid = pos; };
 };
 
+// The occupied voxels of an octant in an open-addressing hash table with linear probing. A voxel takes
+// 12 bytes in one flat array instead of a node of a std::unordered_map and its bucket.
+struct VoxelOccupancy
+{
+  VoxelOccupancy()
+  {
+    slots = 0;
+    capacity = 0;
+    count = 0;
+    shift = 32;
+  };
+  ~VoxelOccupancy() { free(slots); };
+  VoxelOccupancy(const VoxelOccupancy&) = delete;
+  VoxelOccupancy& operator=(const VoxelOccupancy&) = delete;
+
+  // Allocates room for n voxels
+  void reserve(const U32 n)
+  {
+    if (n == 0) return;
+    U32 bits = 4;
+    while ((bits < 31) && ((1u << bits) < 2 * n)) bits++;
+    if ((1u << bits) > capacity) rehash(bits);
+  };
+
+  // The record of a voxel or null if the voxel is empty
+  VoxelRecord* find(const I32 cell)
+  {
+    if (cell < 0 || count == 0) return 0;
+    U32 mask = capacity - 1;
+    for (U32 s = hash(cell); ; s = (s + 1) & mask)
+    {
+      if (slots[s].cell == cell) return &slots[s].record;
+      if (slots[s].cell < 0) return 0;
+    }
+  };
+
+  // Records a voxel unless it is already occupied
+  void insert(const I32 cell, const VoxelRecord& record)
+  {
+    if (cell < 0) return;
+    if (2 * (count + 1) > capacity) rehash(capacity ? shift_bits() + 1 : 4);
+    U32 mask = capacity - 1;
+    for (U32 s = hash(cell); ; s = (s + 1) & mask)
+    {
+      if (slots[s].cell == cell) return;
+      if (slots[s].cell < 0)
+      {
+        slots[s].cell = cell;
+        slots[s].record = record;
+        count++;
+        return;
+      }
+    }
+  };
+
+  U32 size() const { return count; };
+  U64 memory() const { return (U64)capacity * sizeof(Slot); };
+
+private:
+  struct Slot
+  {
+    I32 cell; // -1 when empty
+    VoxelRecord record;
+  };
+  Slot* slots;
+  U32 capacity;
+  U32 count;
+  U32 shift;
+
+  U32 shift_bits() const { return 32 - shift; };
+
+  // Fibonacci hashing spreads the voxels of neighbouring rows and layers over the table
+  inline U32 hash(const I32 cell) const { return ((U32)cell * 2654435769u) >> shift; };
+
+  void rehash(const U32 bits)
+  {
+    Slot* old_slots = slots;
+    U32 old_capacity = capacity;
+    capacity = 1u << bits;
+    shift = 32 - bits;
+    slots = (Slot*)malloc((size_t)capacity * sizeof(Slot));
+    if (slots == 0) throw std::runtime_error("Memory allocation failed.");
+    for (U32 s = 0; s < capacity; s++) slots[s].cell = -1;
+    count = 0;
+    for (U32 s = 0; s < old_capacity; s++)
+    {
+      if (old_slots[s].cell >= 0) insert(old_slots[s].cell, old_slots[s].record);
+    }
+    free(old_slots);
+  };
+};
+
 struct Octant
 {
   Octant() {
@@ -252,21 +344,21 @@ struct Octant
     point_count = 0;
     point_size = 0;
     point_capacity = 0;
+    next_point = 0;
   };
-  ~Octant() {};
+  virtual ~Octant() {};
 
-  void sort()
+  virtual void sort()
   {
     load();
     qsort((void*)point_buffer, point_count, point_size, compare_buffers);
   };
   I32 npoints() const { return point_count; };
 
+  // Returns the points one after the other once they were loaded or sorted
+  virtual const U8* next() { return point_buffer + (size_t)(next_point++) * point_size; };
+
   virtual void load() { return; };
-  virtual void open() { return; };
-  virtual void close(bool force) { return; };
-  virtual void reactivate() { return; }
-  virtual void desactivate() { return; }
   virtual void clean() = 0;
   virtual void swap(LASpoint* laspoint, const I32 pos) = 0;
   virtual void insert(const U8* buffer, const I32 cell, const U16 chunk) = 0;
@@ -276,18 +368,22 @@ struct Octant
   I32 point_count;
   I32 point_size;
   I32 point_capacity;
-  std::unordered_map<I32, VoxelRecord> occupancy;
+  I32 next_point;
+  VoxelOccupancy occupancy;
+
+  // Bytes of memory held by the points and the voxels
+  U64 memory() const { return (U64)point_capacity * point_size + occupancy.memory(); };
 };
 
 struct OctantInMemory : public Octant
 {
-  OctantInMemory(const U32 size)
+  OctantInMemory(const U32 size, const U32 voxels)
   {
     point_size = size;
     point_count = 0;
     point_capacity = 25000;
     point_buffer = (U8*)malloc(point_capacity * point_size);
-    occupancy.reserve(point_capacity);
+    occupancy.reserve(voxels);
   };
 
   // No copy constructor. We don't want any copy of dynamically allocated U8* point_buffer.
@@ -304,7 +400,7 @@ struct OctantInMemory : public Octant
     memcpy(point_buffer + point_count * point_size, buffer, point_size);
 
     // cell = -1 means that recording the location of the point is useless (save memory)
-    if (cell >= 0) occupancy.insert({ cell, VoxelRecord(chunk, point_count) });
+    if (cell >= 0) occupancy.insert(cell, VoxelRecord(chunk, point_count));
 
     point_count++;
   };
@@ -320,7 +416,7 @@ struct OctantInMemory : public Octant
     laspoint->copy_to(point_buffer + point_count * point_size);
 
     // cell = -1 means that recording the location of the point is useless (save memory)
-    if (cell >= 0) occupancy.insert({ cell, VoxelRecord(chunk, point_count) });
+    if (cell >= 0) occupancy.insert(cell, VoxelRecord(chunk, point_count));
 
     point_count++;
   };
@@ -343,44 +439,135 @@ struct OctantInMemory : public Octant
   };
 };
 
-struct OctantOnDisk : public Octant
+// Octants processed on disk keep their newest points in memory. When the points buffered by all of
+// them exceed the memory budget, each octant appends its buffered points to the spill file as a new
+// run. There is one spill file for the thread that builds the octree. A run is only modified in place
+// (by swaps and when it gets sorted) and is read back once its octant is finalized.
+struct SpillRun
 {
-  FILE* fp;
-  char* filename_points;
-  char* filename_octant;
-  static I32 num_connexions;
-  bool active;
+  I64 offset; // Position of the run in the spill file
+  I32 start;  // Index of its first point in the octant
+  I32 count;
+};
+
+struct OctantOnDisk;
 
-  OctantOnDisk(const EPTkey& key, const char* dir, const U32 size)
+struct SpillStore
+{
+  FILE* fp;
+  char* filename;
+  I64 size;
+  U64 budget;   // Bytes of points that may be buffered (half of the memory budget, the other half is for sorting)
+  U64 buffered; // Bytes of points currently buffered
+  U64 spilled;  // Bytes written to the spill file so far
+  std::vector<OctantOnDisk*> octants;
+
+  SpillStore(const char* dir, const U64 memory_budget)
   {
-    active = true;
+    size_t buffer_size = (strlen(dir) + 32) * sizeof(char);
+    filename = (char*)malloc(buffer_size);
+    if (filename == 0) throw std::runtime_error("Memory allocation failed.");
+    strcpy_las(filename, buffer_size, dir);
+    strcat_las(filename, buffer_size, "spill.bin");
 
-    point_size = size;
-    point_count = 0;
-    point_capacity = 0;
-    point_buffer = 0;
+    fp = LASfopen(filename, "w+b");
+    if (fp == 0)
+    {
+      laserror("cannot open file '%s': %s", filename, strerror(errno));
+      throw std::runtime_error("Unexpected I/O error.");
+    }
+    size = 0;
+    budget = memory_budget / 2;
+    buffered = 0;
+    spilled = 0;
+  };
 
-    fp = 0;
-    char suffix[32];
+  ~SpillStore()
+  {
+    if (fp) fclose(fp);
+    remove(filename);
+    free(filename);
+  };
 
-    size_t buffer_size = (strlen(dir) + 32) * sizeof(char);
-    filename_points = (char*)malloc(buffer_size);
-    if (filename_points != 0) {
-      strcpy_las(filename_points, buffer_size, dir);
-      snprintf(suffix, sizeof(suffix), "points-%d-%d-%d-%d.bin", key.x, key.y, key.z, key.d);
-      strcat_las(filename_points, buffer_size, suffix);
+  void seek(const I64 offset)
+  {
+#if defined _WIN32 && ! defined (__MINGW32__)
+    _fseeki64(fp, offset, SEEK_SET);
+#elif defined (__MINGW32__)
+    fseeko64(fp, (off64_t)offset, SEEK_SET);
+#else
+    fseeko(fp, (off_t)offset, SEEK_SET);
+#endif
+  };
+
+  void read(U8* buffer, const I64 offset, const I32 count, const I32 point_size)
+  {
+    seek(offset);
+    if (fread(buffer, point_size, count, fp) != (size_t)count)
+    {
+      laserror("cannot read %d points from '%s'", count, filename);
+      throw std::runtime_error("Unexpected I/O error.");
     }
-    filename_octant = (char*)malloc(buffer_size);
-    if (filename_octant != nullptr) {
-      strcpy_las(filename_octant, buffer_size, dir);
-      snprintf(suffix, sizeof(suffix), "octant-%d-%d-%d-%d.bin", key.x, key.y, key.z, key.d);
-      strcat_las(filename_octant, buffer_size, suffix);
+  };
+
+  void write(const U8* buffer, const I64 offset, const I32 count, const I32 point_size)
+  {
+    seek(offset);
+    if (fwrite(buffer, point_size, count, fp) != (size_t)count)
+    {
+      laserror("cannot write %d points to '%s': %s", count, filename, strerror(errno));
+      throw std::runtime_error("Unexpected I/O error.");
     }
+  };
 
-    open("w+b");
-    close();
+  I64 append(const U8* buffer, const I32 count, const I32 point_size)
+  {
+    I64 offset = size;
+    write(buffer, offset, count, point_size);
+    size += (I64)count * point_size;
+    spilled += (U64)count * point_size;
+    return offset;
+  };
+
+  void attach(OctantOnDisk* octant);
+  void detach(OctantOnDisk* octant);
+  void spill();
+};
+
+struct OctantOnDisk : public Octant
+{
+  SpillStore* store;
+  size_t store_index;
+  std::vector<SpillRun> runs;
+  I32 spilled_count; // Points before this index are in the runs, the others in the point_buffer
+  U8* point;         // One point for swapping and merging
+
+  // Octants too big to be sorted in memory have each of their runs sorted. The runs are merged when
+  // the points are read.
+  struct MergeCursor
+  {
+    U8* buffer;
+    I32 capacity;
+    I32 count;
+    I32 next;
+    I32 done;
+  };
+  std::vector<MergeCursor> cursors;
+  std::vector<size_t> heap;
+  U8* merge_buffer;
 
-    occupancy.reserve(25000);
+  OctantOnDisk(SpillStore* store, const U32 size, const U32 voxels)
+  {
+    this->store = store;
+    point_size = size;
+    point_count = 0;
+    point_capacity = 0;
+    point_buffer = 0;
+    spilled_count = 0;
+    point = (U8*)malloc(point_size);
+    merge_buffer = 0;
+    store->attach(this);
+    occupancy.reserve(voxels);
   };
 
   // No copy constructor. We don't want any copy of dynamically allocated U8* point_buffer.
@@ -388,187 +575,226 @@ struct OctantOnDisk : public Octant
 
   void insert(const U8* buffer, const I32 cell, const U16 chunk)
   {
-    reactivate("r+b");
-
-    fwrite(buffer, point_size, 1, fp);
+    memcpy(append(), buffer, point_size);
 
     // cell = -1 means that recording the location of the point is useless (save memory)
-    if (cell >= 0)
-      occupancy.insert({ cell, VoxelRecord(chunk, point_count) });
+    if (cell >= 0) occupancy.insert(cell, VoxelRecord(chunk, point_count));
 
     point_count++;
-
-    close();
+    if (store->buffered > store->budget) store->spill();
   };
 
   void insert(const LASpoint* laspoint, const I32 cell, const U16 chunk)
   {
-    reactivate("r+b");
-
-    U8* buffer = (U8*)malloc(point_size);
-    if (buffer != nullptr)
-    {
-      laspoint->copy_to(buffer);
-      fwrite(buffer, point_size, 1, fp);
-      free(buffer);
-    }
+    laspoint->copy_to(append());
 
     // cell = -1 means that recording the location of the point is useless (save memory)
-    if (cell >= 0)
-      occupancy.insert({ cell, VoxelRecord(chunk, point_count) });
+    if (cell >= 0) occupancy.insert(cell, VoxelRecord(chunk, point_count));
 
     point_count++;
-
-    close();
+    if (store->buffered > store->budget) store->spill();
   };
 
   void swap(LASpoint* laspoint, const I32 pos)
   {
-    reactivate("r+b");
-
-    U8* buffer1 = (U8*)malloc(point_size);
-    U8* buffer2 = (U8*)malloc(point_size);
-    if (buffer1 != nullptr && buffer2 != nullptr) 
+    if (pos >= spilled_count)
     {
-      fseek(fp, pos * point_size, SEEK_SET);
-      fread(buffer1, point_size, 1, fp);
-      laspoint->copy_to(buffer2);
-      laspoint->copy_from(buffer1);
-      fseek(fp, pos * point_size, SEEK_SET);
-      fwrite(buffer2, point_size, 1, fp);
-      fseek(fp, 0, SEEK_END);
-      free(buffer1);
-      free(buffer2);
+      U8* buffered = point_buffer + (size_t)(pos - spilled_count) * point_size;
+      memcpy(point, buffered, point_size);
+      laspoint->copy_to(buffered);
+      laspoint->copy_from(point);
     }
+    else
+    {
+      // The last run that starts at or before the point
+      auto run = std::upper_bound(runs.begin(), runs.end(), pos, [](const I32 p, const SpillRun& r) { return p < r.start; }) - 1;
+      I64 offset = run->offset + (I64)(pos - run->start) * point_size;
+      store->read(point, offset, 1, point_size);
+      laspoint->copy_to(point_buffer_spare());
+      store->write(point_buffer_spare(), offset, 1, point_size);
+      laspoint->copy_from(point);
+    }
+  };
 
-    close();
+  // Appends the buffered points as a new run to the spill file
+  void spill()
+  {
+    I32 num_buffered = point_count - spilled_count;
+    if (num_buffered == 0) return;
+    SpillRun run;
+    run.offset = store->append(point_buffer, num_buffered, point_size);
+    run.start = spilled_count;
+    run.count = num_buffered;
+    runs.push_back(run);
+    spilled_count = point_count;
+    store->buffered -= (U64)num_buffered * point_size;
+    free(point_buffer);
+    point_buffer = 0;
+    point_capacity = 0;
   };
 
-  void reactivate(const char* mode)
+  void load()
   {
-    if (!active)
+    // A loaded octant must not be spilled anymore: its point_buffer is read by the caller while
+    // other octants insert points and may trigger a spill
+    store->detach(this);
+    I32 num_buffered = point_count - spilled_count;
+    store->buffered -= (U64)num_buffered * point_size;
+
+    // Reads the runs back in front of the buffered points
+    if (!runs.empty())
     {
-      // read occupancy map from disk
-      I32 cell;
-      U16 buffid;
-      I32 posid;
-      FILE* f = LASfopen(filename_octant, "rb");
-      if (f == 0)
+      U8* buffer = (U8*)malloc((size_t)point_count * point_size);
+      if (buffer == 0) throw std::runtime_error("Memory allocation failed.");
+      for (const SpillRun& run : runs)
       {
-        laserror("cannot open file '%s': %s", filename_octant, strerror(errno));
-        throw std::runtime_error("Unexpected I/O error.");
+        store->read(buffer + (size_t)run.start * point_size, run.offset, run.count, point_size);
       }
-      while (fread(&cell, sizeof(I32), 1, f))
-      {
-        fread(&buffid, sizeof(U16), 1, f);
-        fread(&posid, sizeof(I32), 1, f);
-        occupancy[cell] = VoxelRecord(buffid, posid);
-      }
-      fclose(f);
-      remove(filename_octant);
+      if (num_buffered) memcpy(buffer + (size_t)spilled_count * point_size, point_buffer, (size_t)num_buffered * point_size);
+      free(point_buffer);
+      point_buffer = buffer;
+      point_capacity = point_count;
+      runs.clear();
     }
-
-    open(mode);
-    active = true;
+    spilled_count = point_count;
   };
 
-  void desactivate()
+  void sort()
   {
-    if (active)
+    // Octants that fit into the memory for sorting are sorted at once
+    if (runs.empty() || ((U64)point_count * point_size <= store->budget))
     {
-      // write occupancy map on disk
-      FILE* f = LASfopen(filename_octant, "wb");
-      if (f == 0)
-      {
-        laserror("cannot open file '%s': %s", filename_octant, strerror(errno));
-        throw std::runtime_error("Unexpected I/O error.");
-      }
-      for (const auto& e : occupancy)
-      {
-        fwrite(&e.first, sizeof(I32), 1, f);
-        fwrite(&e.second.bufid, sizeof(U16), 1, f);
-        fwrite(&e.second.posid, sizeof(I32), 1, f);
-      }
-      fclose(f);
-
-      // clear occupancy grid
-      occupancy.clear();
-      occupancy = std::unordered_map<I32, VoxelRecord>();
-
-      // close the file that stores the points
-      close(true);
-
-      active = false;
+      Octant::sort();
+      return;
     }
-  }
 
-  void load()
-  {
-    if (point_buffer) throw std::runtime_error("ERROR: internal error load() has been called twice. Please report.");
-
-    reactivate("r+b");
+    // Otherwise each run is sorted on its own (a run is never bigger than the memory for buffering).
+    // Points with the same GPS time, scanner channel and return number may be written in another
+    // order than with the single in-memory sort, but the content of the chunk is the same.
+    spill();
+    store->detach(this);
+    for (const SpillRun& run : runs)
+    {
+      U8* buffer = (U8*)malloc((size_t)run.count * point_size);
+      if (buffer == 0) throw std::runtime_error("Memory allocation failed.");
+      store->read(buffer, run.offset, run.count, point_size);
+      qsort((void*)buffer, run.count, point_size, compare_buffers);
+      store->write(buffer, run.offset, run.count, point_size);
+      free(buffer);
+    }
 
-    point_buffer = (U8*)malloc(point_count * point_size);
-    if (point_buffer != nullptr)
+    // and the runs are merged with a few thousand points of each one in memory
+    U64 capacity = store->budget / point_size / runs.size();
+    capacity = MAX2((U64)1, MIN2((U64)4096, capacity));
+    merge_buffer = (U8*)malloc((size_t)capacity * point_size * runs.size());
+    if (merge_buffer == 0) throw std::runtime_error("Memory allocation failed.");
+    cursors.resize(runs.size());
+    heap.clear();
+    for (size_t r = 0; r < runs.size(); r++)
     {
-      fseek(fp, 0, SEEK_SET);
-      fread(point_buffer, point_size, point_count, fp);
+      cursors[r].buffer = merge_buffer + (size_t)capacity * point_size * r;
+      cursors[r].capacity = (I32)capacity;
+      cursors[r].done = 0;
+      refill(r);
+      heap.push_back(r);
     }
+    std::make_heap(heap.begin(), heap.end(), [this](const size_t a, const size_t b) { return after(a, b); });
+  };
 
-    close();
+  const U8* next()
+  {
+    if (merge_buffer == 0) return Octant::next();
+
+    // The run with the next point in order
+    auto later = [this](const size_t a, const size_t b) { return after(a, b); };
+    std::pop_heap(heap.begin(), heap.end(), later);
+    size_t r = heap.back();
+    memcpy(point, cursors[r].buffer + (size_t)cursors[r].next * point_size, point_size);
+    cursors[r].next++;
+    if (cursors[r].next == cursors[r].count) refill(r);
+    if (cursors[r].count) std::push_heap(heap.begin(), heap.end(), later);
+    else heap.pop_back();
+    return point;
   };
 
   void clean()
   {
-    close(true);
+    store->buffered -= (U64)(point_count - spilled_count) * point_size;
+    store->detach(this);
+    if (point_buffer) free(point_buffer);
+    if (merge_buffer) free(merge_buffer);
+    if (spare) free(spare);
+    free(point);
+    point_buffer = 0;
+    merge_buffer = 0;
+    spare = 0;
+    point = 0;
+  };
 
-    if (filename_points)
-    {
-      remove(filename_points);
-      free(filename_points);
-    }
+private:
+  U8* spare = 0;
 
-    if (filename_octant)
-    {
-      free(filename_octant);
-    }
+  U8* point_buffer_spare()
+  {
+    if (spare == 0) spare = (U8*)malloc(point_size);
+    return spare;
+  };
 
-    if (point_buffer)
+  U8* append()
+  {
+    I32 num_buffered = point_count - spilled_count;
+    if (num_buffered == point_capacity)
     {
-      free(point_buffer);
+      point_capacity = (point_capacity ? 2 * point_capacity : 1024);
+      point_buffer = (U8*)realloc_las(point_buffer, (size_t)point_capacity * point_size);
+      if (point_buffer == 0) throw std::runtime_error("Memory allocation failed.");
     }
+    store->buffered += point_size;
+    return point_buffer + (size_t)num_buffered * point_size;
   };
 
-  void open(const char* mode)
+  // Reads the next points of run r
+  void refill(const size_t r)
   {
-    if (fp == 0)
-    {
-      fp = LASfopen(filename_points, mode);
-      if (fp == 0)
-      {
-        laserror("cannot open file '%s': %s", filename_points, strerror(errno));
-        throw std::runtime_error("Unexpected I/O error.");
-      }
-      fseek(fp, 0, SEEK_END);
-      num_connexions++;
-    }
-  }
+    MergeCursor& cursor = cursors[r];
+    cursor.count = MIN2(cursor.capacity, runs[r].count - cursor.done);
+    cursor.next = 0;
+    if (cursor.count) store->read(cursor.buffer, runs[r].offset + (I64)cursor.done * point_size, cursor.count, point_size);
+    cursor.done += cursor.count;
+  };
 
-  void close(bool force = false)
+  // Whether the next point of run a comes after the next point of run b. Equal points keep the order of the runs.
+  bool after(const size_t a, const size_t b) const
   {
-    if (fp)
-    {
-      if (force || num_connexions >= MAX_FOPEN)
-      {
-        fclose(fp);
-        fp = 0;
-        num_connexions--;
-      }
-    }
-  }
+    const U8* pa = cursors[a].buffer + (size_t)cursors[a].next * point_size;
+    const U8* pb = cursors[b].buffer + (size_t)cursors[b].next * point_size;
+    if (get_gps_time(pa) != get_gps_time(pb)) return get_gps_time(pa) > get_gps_time(pb);
+    if (get_scanner_channel(pa) != get_scanner_channel(pb)) return get_scanner_channel(pa) > get_scanner_channel(pb);
+    if (get_return_number(pa) != get_return_number(pb)) return get_return_number(pa) > get_return_number(pb);
+    return a > b;
+  };
 };
 
-I32 OctantOnDisk::num_connexions = 0;
+void SpillStore::attach(OctantOnDisk* octant)
+{
+  octant->store_index = octants.size();
+  octants.push_back(octant);
+}
+
+void SpillStore::detach(OctantOnDisk* octant)
+{
+  if (octant->store_index >= octants.size() || octants[octant->store_index] != octant) return;
+  octants[octant->store_index] = octants.back();
+  octants[octant->store_index]->store_index = octant->store_index;
+  octants.pop_back();
+  octant->store_index = (size_t)-1;
+}
+
+void SpillStore::spill()
+{
+  LASMessage(LAS_VERY_VERBOSE, "Spilling %.1f MB of points of %u octants to '%s'", buffered / 1048576.0, (U32)octants.size(), filename);
+  for (OctantOnDisk* octant : octants) octant->spill();
+}
 
 typedef std::unordered_map<EPTkey, std::unique_ptr<Octant>, EPTKeyHasher> Registry;
 
@@ -589,6 +815,7 @@ int main(int argc, char* argv[])
   BOOL unordered = FALSE;
   BOOL units = FALSE;
   U32  root_grid_size = 256;
+  U32  num_threads = 1;
 
   // Internal variables
   I32 i = 0;
@@ -602,7 +829,7 @@ int main(int argc, char* argv[])
   F32 proba_swap_event = 0.95F;
   I32 num_points_buffer = 1000000; // Approx 40 MB
   CHAR* tmpdir = 0;
-  I32 max_files_opened = (I32)(0.5 * MAX_FOPEN);
+  U32 max_memory = 1024; // MB for the points of the octants processed on disk
   const I32 limit_depth = 10;
   const std::array<EPTkey, 8> unordered_keys = EPTkey::root().get_children();
 
@@ -680,12 +907,6 @@ int main(int argc, char* argv[])
       root_grid_size = 128;
       max_points_per_octant = 1000000;
       unordered = TRUE;
-
-#ifdef _MSC_VER
-      _setmaxstdio(2000);
-      MAX_FOPEN = _getmaxstdio();
-      max_files_opened = (I32)(0.5 * MAX_FOPEN);
-#endif
     }
     else if (strcmp(argv[i], "-unordered") == 0)
     {
@@ -694,16 +915,28 @@ int main(int argc, char* argv[])
     else if (strcmp(argv[i], "-ondisk") == 0)
     {
       ondisk = TRUE;
-
-#ifdef _MSC_VER
-      if (_setmaxstdio(MAX_FOPEN) == -1)
+    }
+    else if (strcmp(argv[i], "-max_memory") == 0)
+    {
+      if ((i + 1) >= argc)
       {
-        LASMessage(LAS_WARNING, "the operating system cannot open %d files and is limited to %d", MAX_FOPEN, _getmaxstdio());
-        byebye();
+        laserror("'%s' needs 1 argument: megabytes", argv[i]);
       }
-      MAX_FOPEN = _getmaxstdio();
-      max_files_opened = (I32)(0.5 * MAX_FOPEN);
-#endif
+      if ((sscanf_las(argv[i + 1], "%u", &max_memory) != 1) || (max_memory == 0))
+      {
+        laserror("cannot understand argument '%s' for '%s'", argv[i + 1], argv[i]);
+      }
+      ondisk = TRUE;
+      i += 1;
+    }
+    else if (strcmp(argv[i], "-max_files") == 0)
+    {
+      if ((i + 1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: num", argv[i]);
+      }
+      LASMessage(LAS_WARNING, "'%s' is deprecated. the octants on disk share one spill file. ignoring '%s %s' ...", argv[i], argv[i], argv[i + 1]);
+      i += 1;
     }
     else if (strcmp(argv[i], "-m") == 0)
     {
@@ -729,19 +962,6 @@ int main(int argc, char* argv[])
         max_depth = -1;
       i += 1;
     }
-    else if (strcmp(argv[i], "-max_files") == 0) // For debugging
-    {
-      if ((i + 1) >= argc)
-      {
-        laserror("'%s' needs 1 argument: num", argv[i]);
-      }
-      if (sscanf_las(argv[i + 1], "%d", &MAX_FOPEN) != 1)
-      {
-        laserror("cannot understand argument '%s' for '%s'", argv[i + 1], argv[i]);
-      }
-      max_files_opened = (I32)(0.5 * MAX_FOPEN);
-      i += 1;
-    }
     else if (strcmp(argv[i], "-seed") == 0)
     {
       if ((i + 1) >= argc)
@@ -754,6 +974,11 @@ int main(int argc, char* argv[])
       }
       i += 1;
     }
+    else if (strcmp(argv[i], "-threads") == 0)
+    {
+      num_threads = lastool.parse_arg_threads(i);
+      i += 1;
+    }
     else if (strcmp(argv[i], "-tmpdir") == 0)
     {
       if ((i + 1) >= argc)
@@ -809,6 +1034,17 @@ int main(int argc, char* argv[])
     LASMessage(LAS_INFO, "LASreaderPipon is not supported for lascopcindex.");
   }
 
+  // The points are inserted into the octree in the order of one random stream, hence on one thread. The
+  // other threads decompress the input, check and sort the finalized octants and compress the chunks.
+  LASthreadPool* pool = 0;
+  if (num_threads > 1)
+  {
+    if (lasreadopener.get_decompress_threads() <= 1) lasreadopener.set_decompress_threads(num_threads);
+    if (laswriteopener.get_compress_threads() <= 1) laswriteopener.set_compress_threads(num_threads);
+    pool = new LASthreadPool(num_threads);
+    LASMessage(LAS_VERBOSE, "Using %u threads", num_threads);
+  }
+
   while (lasreadopener.active())
   {
     num_points = 0;
@@ -909,7 +1145,7 @@ int main(int argc, char* argv[])
     if (unordered || ondisk) num_points_buffer *= 2; // reduce swap events
 
     if (unordered) LASMessage(LAS_VERBOSE, "Memory optimization for spatially unordered file: enabled");
-    if (ondisk)    LASMessage(LAS_VERBOSE, "Processing points on disk: enabled");
+    if (ondisk)    LASMessage(LAS_VERBOSE, "Processing points on disk with %u MB of memory: enabled", max_memory);
 
     srand(seed);
 
@@ -1160,8 +1396,21 @@ int main(int argc, char* argv[])
       U8* buffer = (U8*)malloc(num_points_buffer * elem_size);
       U8* temp = (U8*)malloc(elem_size);
 
-      // EPT hierarchy
+      // EPT hierarchy. The offset and size of each chunk are only known once it was compressed.
       std::vector<LASvlr_copc_entry> entries;
+      std::vector<size_t> chunk_entries;
+      I64 first_chunk_offset = laswriter->tell();
+
+      // Octants that are finalized and will be written next
+      struct FinalizedOctant
+      {
+        EPTkey key;
+        std::unique_ptr<Octant> octant;
+        size_t entry;
+      };
+      std::vector<Registry::iterator> candidates;
+      std::vector<U8> finalized;
+      std::vector<FinalizedOctant> finalized_octants;
 
       // For -unordered optimization
       EPTkey current_unordered_key = unordered_keys[0];
@@ -1171,12 +1420,17 @@ int main(int argc, char* argv[])
       Registry registry;
       Registry::iterator it;
 
+      // Voxels reserved per octant: a sixteenth of one layer of its grid. Tables grow when needed.
+      U32 expected_voxels = (U32)(octree.get_gridsize() * octree.get_gridsize() / 16);
+      U64 peak_memory = 0;
+
       // Setup progress bar (*3 because updated at 3 strategic locations)
       progressbar.set_total((U64)num_points * 3);
       progressbar.set_display(progress);
 
       // tmpdir
       if (ondisk && tmpdir == 0) tmpdir = LASCopyString(laswriteopener.get_file_name_base());
+      SpillStore* spillstore = (ondisk ? new SpillStore(tmpdir, (U64)max_memory << 20) : 0);
 
       while (lasreader->read_point())
       {
@@ -1245,38 +1499,31 @@ int main(int argc, char* argv[])
               it = registry.find(key);
               if (it == registry.end())
               {
+                // Octants of the last level take all points and need no voxels
+                U32 voxels = (lvl == max_depth ? 0 : expected_voxels);
                 if (ondisk)
                 {
-                  it = registry.insert({ key, std::make_unique<OctantOnDisk>(key, tmpdir, elem_size) }).first;
-
-                  // If too many files are opened we desactivate the octants. They will be auto-reactivated when needed.
-                  // Innactive octants are automatically closed until they become active again. More than 500
-                  // files opened can arise for very large point-clouds but most are likely to be inactive.
-                  if (OctantOnDisk::num_connexions > max_files_opened)
-                  {
-                    LASMessage(LAS_VERBOSE, "File connexions limit reached (%d). Closing all files temporarily.", OctantOnDisk::num_connexions);
-                    for (auto& e : registry) e.second->desactivate();
-                  }
+                  it = registry.insert({ key, std::make_unique<OctantOnDisk>(spillstore, elem_size, voxels) }).first;
                 }
                 else
                 {
-                  it = registry.insert({ key, std::make_unique<OctantInMemory>(elem_size) }).first;
+                  it = registry.insert({ key, std::make_unique<OctantInMemory>(elem_size, voxels) }).first;
                 }
 
                 LASMessage(LAS_VERY_VERBOSE, "[%.0lf%%] Creation of octant %d-%d-%d-%d", progressbar.get_progress(), key.d, key.x, key.y, key.z);
               }
 
-              auto it2 = it->second->occupancy.find(cell);
-              accepted = (it2 == it->second->occupancy.end()) || (lvl == max_depth);
+              VoxelRecord* voxel = it->second->occupancy.find(cell);
+              accepted = (voxel == 0) || (lvl == max_depth);
 
               if (swap && !accepted)
               {
                 // bufid != id_buffer: save the heavy cost (on disk) of swapping.
                 // No need to swap two points from the same buffer: they are already shuffled.
-                if (it2->second.bufid != id_buffer && (((F32)rand() / (F32)RAND_MAX)) < swap_probabilities[lvl])
+                if (voxel->bufid != id_buffer && (((F32)rand() / (F32)RAND_MAX)) < swap_probabilities[lvl])
                 {
-                  it->second->swap(laspoint, it2->second.posid);
-                  it2->second.bufid = id_buffer;
+                  it->second->swap(laspoint, voxel->posid);
+                  voxel->bufid = id_buffer;
                 }
               }
 
@@ -1290,24 +1537,55 @@ int main(int argc, char* argv[])
             // We can potentially write some chunks in the .copc.laz and free up memory
             if (lasfinalizer.finalized)
             {
-              // Loop through all octants to find the ones that are finalized (could be optimized).
-              for (it = registry.begin(); it != registry.end();)
+              // Check all octants to find the ones that are finalized (could be optimized). The checks only
+              // read the finalizer and are split among the threads.
+              // The octants hold the most memory right before finalized ones are written and freed.
+              candidates.clear();
+              U64 memory = 0;
+              for (it = registry.begin(); it != registry.end(); it++)
               {
-                // Bounding box of the octant
-                F64 res = octree.get_size() / (static_cast<uint64_t>(1) << it->first.d);
-                F64 minx = res * it->first.x + octree.get_xmin();
-                F64 miny = res * it->first.y + octree.get_ymin();
-                F64 minz = res * it->first.z + octree.get_zmin();
-                F64 maxx = minx + res;
-                F64 maxy = miny + res;
-                F64 maxz = minz + res;
+                candidates.push_back(it);
+                memory += it->second->memory();
+              }
+              if (memory > peak_memory) peak_memory = memory;
+              finalized.assign(candidates.size(), 0);
 
-                // If the octant is not finalized we can't do anything yet
-                if (!lasfinalizer.is_finalized(minx, miny, minz, maxx, maxy, maxz))
+              auto check_finalized = [&](size_t start, size_t end) -> BOOL
+              {
+                for (size_t k = start; k < end; k++)
                 {
-                  it++;
-                  continue;
+                  // Bounding box of the octant
+                  const EPTkey& candidate = candidates[k]->first;
+                  F64 res = octree.get_size() / (static_cast<uint64_t>(1) << candidate.d);
+                  F64 minx = res * candidate.x + octree.get_xmin();
+                  F64 miny = res * candidate.y + octree.get_ymin();
+                  F64 minz = res * candidate.z + octree.get_zmin();
+                  finalized[k] = lasfinalizer.is_finalized(minx, miny, minz, minx + res, miny + res, minz + res);
                 }
+                return TRUE;
+              };
+
+              if (pool && candidates.size() >= 64)
+              {
+                std::vector<std::future<BOOL>> checks;
+                size_t step = (candidates.size() + pool->get_num_threads() - 1) / pool->get_num_threads();
+                for (size_t start = 0; start < candidates.size(); start += step)
+                {
+                  size_t end = MIN2(start + step, candidates.size());
+                  checks.push_back(pool->submit<BOOL>([&check_finalized, start, end]() { return check_finalized(start, end); }));
+                }
+                for (auto& check : checks) check.get();
+              }
+              else
+              {
+                check_finalized(0, candidates.size());
+              }
+
+              for (size_t c = 0; c < candidates.size(); c++)
+              {
+                // If the octant is not finalized we can't do anything yet
+                if (!finalized[c]) continue;
+                it = candidates[c];
 
                 // Check if the chunk is not too small. Otherwise, redistribute the points in the parent octant.
                 // There is no guarantee that parents still exist. They may have already been written and freed.
@@ -1345,7 +1623,7 @@ int main(int argc, char* argv[])
                         entries.push_back(entry);
                       }
 
-                      it = registry.erase(it);
+                      registry.erase(it);
                       moved = true;
                     }
                   }
@@ -1354,40 +1632,68 @@ int main(int argc, char* argv[])
                   if (moved) continue;
                 }
 
-                // The octant is finalized: we can write the chunk and free up the memory
+                // The octant is finalized: it leaves the octree and gets its place in the EPT hierarchy.
+                // Octants that are finalized later cannot move points into it anymore.
                 LASvlr_copc_entry entry;
                 entry.key.depth = it->first.d;
                 entry.key.x = it->first.x;
                 entry.key.y = it->first.y;
                 entry.key.z = it->first.z;
                 entry.point_count = it->second->npoints();
-                entry.offset = laswriter->tell();
+                entry.offset = 0;
+                entry.byte_size = 0;
+                entries.push_back(entry);
 
-                // The points *MUST* be sorted (to optimize compression)
-                if (sort) it->second->sort();
+                FinalizedOctant finalized_octant;
+                finalized_octant.key = it->first;
+                finalized_octant.octant = std::move(it->second);
+                finalized_octant.entry = entries.size() - 1;
+                finalized_octants.push_back(std::move(finalized_octant));
+                registry.erase(it);
+              }
 
-                // Write the chunk
-                for (I32 k = 0; k < it->second->npoints(); k++)
+              // The points *MUST* be sorted (to optimize compression). Octants on disk share the spill file
+              // and the memory budget and are sorted one after the other.
+              if (sort)
+              {
+                if (pool && !ondisk)
+                {
+                  std::vector<std::future<BOOL>> sorts;
+                  for (auto& finalized_octant : finalized_octants)
+                  {
+                    Octant* octant = finalized_octant.octant.get();
+                    sorts.push_back(pool->submit<BOOL>([octant]() { octant->sort(); return TRUE; }));
+                  }
+                  for (auto& sorted : sorts) sorted.get();
+                }
+                else
                 {
-                  laspoint->copy_from(it->second->point_buffer + k * elem_size);
+                  for (auto& finalized_octant : finalized_octants) finalized_octant.octant->sort();
+                }
+              }
+
+              // Write the chunks in order. With several threads they are compressed while we go on.
+              for (auto& finalized_octant : finalized_octants)
+              {
+                Octant* octant = finalized_octant.octant.get();
+                if (!sort) octant->load();
+                for (I32 k = 0; k < octant->npoints(); k++)
+                {
+                  laspoint->copy_from(octant->next());
                   laswriter->write_point(laspoint);
                   laswriter->update_inventory(laspoint);
 
                   progressbar++;
                   progressbar.print();
                 }
-                laswriter->chunk();
+                if (laswriter->chunk()) chunk_entries.push_back(finalized_octant.entry);
 
-                LASMessage(LAS_VERY_VERBOSE, "[%.0lf%%] Octant %d-%d-%d-%d written in COPC file", progressbar.get_progress(), it->first.d, it->first.x, it->first.y, it->first.z);
-
-                // Record the VLR entry
-                entry.byte_size = (I32)(laswriter->tell() - entry.offset);
-                entries.push_back(entry);
+                LASMessage(LAS_VERY_VERBOSE, "[%.0lf%%] Octant %d-%d-%d-%d written in COPC file", progressbar.get_progress(), finalized_octant.key.d, finalized_octant.key.x, finalized_octant.key.y, finalized_octant.key.z);
 
                 // We will never see this octant again. Goodbye.
-                it->second->clean();
-                it = registry.erase(it);
+                octant->clean();
               }
+              finalized_octants.clear();
             }
 
             progressbar++;
@@ -1400,26 +1706,46 @@ int main(int argc, char* argv[])
           if (get_message_log_level() >= LAS_VERBOSE)
           {
             F32 million = (F32)((U64)num_points_buffer * id_buffer / 1000000.0);
-            fprintf(stderr, "[%.0lf%%] Processed %.1f million points | LAZ chunks written: %u", progressbar.get_progress(), million, (U32)entries.size());
-            if (ondisk) fprintf(stderr, " | Files opened: %d/%d", OctantOnDisk::num_connexions, (I32)registry.size());
-            fprintf(stderr, "\n");
-          }
-
-          if (ondisk)
-          {
-            // If too many files are opened we desactivate the octants. They will be auto-reactivated when needed.
-            // Innactive octants are automatically closed until they become active again. More than 500
-            // files opened can arise for very large point-clouds but most are likely to be inactive.
-            if (OctantOnDisk::num_connexions > max_files_opened)
+            U64 memory = 0;
+            U64 voxel_memory = 0;
+            for (const auto& e : registry)
             {
-              LASMessage(LAS_VERBOSE, "File connexions limit reached (%d). Closing all files temporarily.", OctantOnDisk::num_connexions);
-              for (auto& e : registry) e.second->desactivate();
+              memory += e.second->memory();
+              voxel_memory += e.second->occupancy.memory();
             }
+            if (memory > peak_memory) peak_memory = memory;
+            fprintf(stderr, "[%.0lf%%] Processed %.1f million points | LAZ chunks written: %u", progressbar.get_progress(), million, (U32)entries.size());
+            fprintf(stderr, " | Octants: %u using %.0f MB (%.0f MB voxels, %.0f KB each, peak %.0f MB)", (U32)registry.size(), memory / 1048576.0, voxel_memory / 1048576.0, (registry.size() ? memory / 1024.0 / registry.size() : 0.0), peak_memory / 1048576.0);
+            if (ondisk) fprintf(stderr, " | Buffered: %.0f MB | Spilled: %.0f MB", spillstore->buffered / 1048576.0, spillstore->spilled / 1048576.0);
+            fprintf(stderr, "\n");
           }
         }
       }
 
       progressbar.done();
+      if (spillstore)
+      {
+        LASMessage(LAS_VERBOSE, "Spilled %.1f MB of points to disk", spillstore->spilled / 1048576.0);
+        delete spillstore;
+      }
+
+      // All chunks are written one after the other. Their sizes give their offsets.
+      if (!laswriter->sync())
+      {
+        laserror("could not write all LAZ chunks");
+      }
+      I64 chunk_offset = first_chunk_offset;
+      for (size_t c = 0; c < chunk_entries.size(); c++)
+      {
+        U32 chunk_bytes = 0;
+        if (!laswriter->get_chunk_bytes((U32)c, chunk_bytes))
+        {
+          laserror("could not locate LAZ chunk %u", (U32)c);
+        }
+        entries[chunk_entries[c]].offset = chunk_offset;
+        entries[chunk_entries[c]].byte_size = (I32)chunk_bytes;
+        chunk_offset += chunk_bytes;
+      }
 
       // Construct the EPT hierarchy eVLR
       LASvlr_copc_entry* hierarchy = new LASvlr_copc_entry[entries.size()];
@@ -1457,6 +1783,7 @@ int main(int argc, char* argv[])
         LASMessage(LAS_VERBOSE, "Highest number of points in a chunk: %u", highest_num_points);
         LASMessage(LAS_VERBOSE, "Lowest number of points in a chunk: %u", lowest_num_points);
         LASMessage(LAS_VERBOSE, "Number of chunks with less than %u points: %u", min_points_per_octant, num_chunks_few_points);
+        LASMessage(LAS_VERBOSE, "Peak memory of the octants: %.0f MB", peak_memory / 1048576.0);
         LASMessage(LAS_VERBOSE, "Pass 2 took %u sec.\n", (U32)(t5 - t4));
         LASMessage(LAS_VERBOSE, "Total time: %u sec.", (U32)(t5 - t0));
       }
@@ -1473,6 +1800,7 @@ int main(int argc, char* argv[])
       laswriteopener.set_file_name(0);
     }
   }
+  if (pool) delete pool;
   byebye();
   return 0;
 }
@@ -26,6 +26,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- new options '-threads 4', '-stop_after 100' and '-summary' compare chunks in parallel
     4 November 2019 -- new option '-idir' takes two input directories and compares
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     13 July 2017 -- added missing checks for LAS 1.4 EVLR size and payloads
@@ -43,11 +44,14 @@
 
 #include "lasreader.hpp"
 #include "laswriter.hpp"
+#include "lasthreadpool.hpp"
 
 #include <time.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
+#include <vector>
 #include "lastool.hpp"
 
 class LasTool_lasdiff : public LasTool
@@ -63,6 +67,7 @@ public:
     fprintf(stderr, "lasdiff lidar1.txt lidar2.txt -iparse xyzti\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz\n");
     fprintf(stderr, "lasdiff lidar1.las lidar1.laz -random_seeks\n");
+    fprintf(stderr, "lasdiff original.laz recompressed.laz -threads 8 -stop_after 100 -summary\n");
     fprintf(stderr, "lasdiff -i lidar1.las -i lidar2.las -o diff.las\n");
     fprintf(stderr, "lasdiff -wildcards folder1 folder2\n");
     fprintf(stderr, "lasdiff -h\n");
@@ -442,346 +447,555 @@ static int check_header(LASreader* lasreader1, LASreader* lasreader2)
 };
 
 static int shutup = 5;
+static int stop_after = 0;
+static bool summary = false;
+static U32 threads = 0;
+static bool stopped_early = false;
 static int different_scaled_offset_coordinates;
+static double max_diff_x;
+static double max_diff_y;
+static double max_diff_z;
 
-static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks)
+// compares the current points of both readers field by field and reports the first few differences
+static bool check_point(LASreader* lasreader1, LASreader* lasreader2, int different_points)
 {
-  int seeking = random_seeks;
-
-  int different_points = 0;
+  bool difference = false;
   double diff;
-  double max_diff_x = 0.0;
-  double max_diff_y = 0.0;
-  double max_diff_z = 0.0;
-
-  different_scaled_offset_coordinates = 0;
 
-  while (true)
+  if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
   {
-    bool difference = false;
-    if (seeking)
+    if (scaled_offset_difference)
     {
-      if (lasreader1->p_count%100000 == 25000)
+      if (lasreader1->get_x() != lasreader2->get_x())
       {
-        I64 s = (rand()*rand())%lasreader1->npoints;
-        fprintf(stderr, "at p_count %u seeking to %u\n", (U32)lasreader1->p_count, (U32)s);
-        lasreader1->seek(s);
-        lasreader2->seek(s);
-        seeking--;
+        diff = lasreader1->get_x() - lasreader2->get_x();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff_x) max_diff_x = diff;
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
+        different_scaled_offset_coordinates++;
       }
-    }
-    if (lasreader1->read_point())
-    {
-      if (lasreader2->read_point())
+      if (lasreader1->get_y() != lasreader2->get_y())
+      {
+        diff = lasreader1->get_y() - lasreader2->get_y();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff_y) max_diff_y = diff;
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
+        different_scaled_offset_coordinates++;
+      }
+      if (lasreader1->get_z() != lasreader2->get_z())
       {
-        if (memcmp((const void*)&(lasreader1->point), (const void*)&(lasreader2->point), 20))
+        diff = lasreader1->get_z() - lasreader2->get_z();
+        if (diff < 0) diff = -diff;
+        if (diff > max_diff_z)
         {
-          if (scaled_offset_difference)
-          {
-            if (lasreader1->get_x() != lasreader2->get_x())
-            {
-              diff = lasreader1->get_x() - lasreader2->get_x();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_x) max_diff_x = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  x: %d %d scaled offset x %g %g\n", lasreader1->point.get_X(), lasreader2->point.get_X(), lasreader1->get_x(), lasreader2->get_x());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_y() != lasreader2->get_y())
-            {
-              diff = lasreader1->get_y() - lasreader2->get_y();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_y) max_diff_y = diff;
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  y: %d %d scaled offset y %g %g\n", lasreader1->point.get_Y(), lasreader2->point.get_Y(), lasreader1->get_y(), lasreader2->get_y());
-              different_scaled_offset_coordinates++;
-            }
-            if (lasreader1->get_z() != lasreader2->get_z())
-            {
-              diff = lasreader1->get_z() - lasreader2->get_z();
-              if (diff < 0) diff = -diff;
-              if (diff > max_diff_z)
-              {
-                max_diff_z = diff;
-                if (max_diff_z > 0.001)
-                {
-                  max_diff_z = diff;
-                }
-              }
-              if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
-              different_scaled_offset_coordinates++;
-            }
-          }
-          else
-          {
-            if (lasreader1->point.get_X() != lasreader2->point.get_X())
-            {
-              if (different_points < shutup) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
-              difference = true;
-            }
-            if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
-            {
-              if (different_points < shutup) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
-              difference = true;
-            }
-            if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
-            {
-              if (different_points < shutup) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
-              difference = true;
-            }
-          }
-          if (lasreader1->point.intensity != lasreader2->point.intensity)
-          {
-            if (different_points < shutup) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
-            difference = true;
-          }
-          if (lasreader1->point.return_number != lasreader2->point.return_number)
-          {
-            if (different_points < shutup) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
-            difference = true;
-          }
-          if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
+          max_diff_z = diff;
+          if (max_diff_z > 0.001)
           {
-            if (different_points < shutup) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
-            difference = true;
+            max_diff_z = diff;
           }
-          if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
-          {
-            if (different_points < shutup) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
-            difference = true;
-          }
-          if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
-          {
-            if (different_points < shutup) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
-            difference = true;
-          }
-          if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
-          {
-            if (different_points < shutup) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
-            difference = true;
-          }
-          if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
-            difference = true;
-          }
-          if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
-          {
-            if (different_points < shutup) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
-            difference = true;
-          }
-          if (lasreader1->point.scan_angle_rank != lasreader2->point.scan_angle_rank)
-          {
-            if (different_points < shutup) fprintf(stderr, "  scan_angle_rank: %d %d\n", lasreader1->point.scan_angle_rank, lasreader2->point.scan_angle_rank);
-            difference = true;
-          }
-          if (lasreader1->point.user_data != lasreader2->point.user_data)
-          {
-            if (different_points < shutup) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
-            difference = true;
-          }
-          if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
-          {
-            if (different_points < shutup) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
-            difference = true;
-          }
-          if (difference) if (different_points < shutup) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints);
         }
-        if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
+        if (different_scaled_offset_coordinates < 9) fprintf(stderr, "  z: %d %d scaled offset z %g %g\n", lasreader1->point.get_Z(), lasreader2->point.get_Z(), lasreader1->get_z(), lasreader2->get_z());
+        different_scaled_offset_coordinates++;
+      }
+    }
+    else
+    {
+      if (lasreader1->point.get_X() != lasreader2->point.get_X())
+      {
+        if (different_points < shutup) fprintf(stderr, "  x: %d %d\n", lasreader1->point.get_X(), lasreader2->point.get_X());
+        difference = true;
+      }
+      if (lasreader1->point.get_Y() != lasreader2->point.get_Y())
+      {
+        if (different_points < shutup) fprintf(stderr, "  y: %d %d\n", lasreader1->point.get_Y(), lasreader2->point.get_Y());
+        difference = true;
+      }
+      if (lasreader1->point.get_Z() != lasreader2->point.get_Z())
+      {
+        if (different_points < shutup) fprintf(stderr, "  z: %d %d\n", lasreader1->point.get_Z(), lasreader2->point.get_Z());
+        difference = true;
+      }
+    }
+    if (lasreader1->point.intensity != lasreader2->point.intensity)
+    {
+      if (different_points < shutup) fprintf(stderr, "  intensity: %d %d\n", lasreader1->point.intensity, lasreader2->point.intensity);
+      difference = true;
+    }
+    if (lasreader1->point.return_number != lasreader2->point.return_number)
+    {
+      if (different_points < shutup) fprintf(stderr, "  return_number: %d %d\n", lasreader1->point.return_number, lasreader2->point.return_number);
+      difference = true;
+    }
+    if (lasreader1->point.number_of_returns != lasreader2->point.number_of_returns)
+    {
+      if (different_points < shutup) fprintf(stderr, "  number_of_returns: %d %d\n", lasreader1->point.number_of_returns, lasreader2->point.number_of_returns);
+      difference = true;
+    }
+    if (lasreader1->point.scan_direction_flag != lasreader2->point.scan_direction_flag)
+    {
+      if (different_points < shutup) fprintf(stderr, "  scan_direction_flag: %d %d\n", lasreader1->point.scan_direction_flag, lasreader2->point.scan_direction_flag);
+      difference = true;
+    }
+    if (lasreader1->point.edge_of_flight_line != lasreader2->point.edge_of_flight_line)
+    {
+      if (different_points < shutup) fprintf(stderr, "  edge_of_flight_line: %d %d\n", lasreader1->point.edge_of_flight_line, lasreader2->point.edge_of_flight_line);
+      difference = true;
+    }
+    if (lasreader1->point.get_classification() != lasreader2->point.get_classification())
+    {
+      if (different_points < shutup) fprintf(stderr, "  classification: %d %d\n", lasreader1->point.get_classification(), lasreader2->point.get_classification());
+      difference = true;
+    }
+    if (lasreader1->point.get_synthetic_flag() != lasreader2->point.get_synthetic_flag())
+    {
+      if (different_points < shutup) fprintf(stderr, "  synthetic_flag: %d %d\n", lasreader1->point.get_synthetic_flag(), lasreader2->point.get_synthetic_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_keypoint_flag() != lasreader2->point.get_keypoint_flag())
+    {
+      if (different_points < shutup) fprintf(stderr, "  keypoint_flag: %d %d\n", lasreader1->point.get_keypoint_flag(), lasreader2->point.get_keypoint_flag());
+      difference = true;
+    }
+    if (lasreader1->point.get_withheld_flag() != lasreader2->point.get_withheld_flag())
+    {
+      if (different_points < shutup) fprintf(stderr, "  withheld_flag: %d %d\n", lasreader1->point.get_withheld_flag(), lasreader2->point.get_withheld_flag());
+      difference = true;
+    }
+    if (lasreader1->point.scan_angle_rank != lasreader2->point.scan_angle_rank)
+    {
+      if (different_points < shutup) fprintf(stderr, "  scan_angle_rank: %d %d\n", lasreader1->point.scan_angle_rank, lasreader2->point.scan_angle_rank);
+      difference = true;
+    }
+    if (lasreader1->point.user_data != lasreader2->point.user_data)
+    {
+      if (different_points < shutup) fprintf(stderr, "  user_data: %d %d\n", lasreader1->point.user_data, lasreader2->point.user_data);
+      difference = true;
+    }
+    if (lasreader1->point.point_source_ID != lasreader2->point.point_source_ID)
+    {
+      if (different_points < shutup) fprintf(stderr, "  point_source_ID: %d %d\n", lasreader1->point.point_source_ID, lasreader2->point.point_source_ID);
+      difference = true;
+    }
+    if (difference) if (different_points < shutup) fprintf(stderr, "point %u of %u is different\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints);
+  }
+  if (lasreader1->point.have_gps_time || lasreader2->point.have_gps_time)
+  {
+    if (lasreader1->point.gps_time != lasreader2->point.gps_time)
+    {
+      if (different_points < shutup) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
+      difference = true;
+    }
+  }
+  if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
+  {
+    if (lasreader1->point.have_nir || lasreader2->point.have_nir)
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
+      {
+        if (different_points < shutup) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
+        difference = true;
+      }
+    }
+    else
+    {
+      if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
+      {
+        if (different_points < shutup) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
+        difference = true;
+      }
+    }
+  }
+  if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
+  {
+    if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
+    {
+      if (different_points < shutup) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
+    {
+      if (different_points < shutup)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
         {
-          if (lasreader1->point.gps_time != lasreader2->point.gps_time)
-          {
-            if (different_points < shutup) fprintf(stderr, "gps time of point %u of %u is different: %f != %f\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.gps_time, lasreader2->point.gps_time);
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
         }
-        if (lasreader1->point.have_rgb || lasreader2->point.have_rgb)
+        else if (lasreader1->point.extra_bytes_number == 2)
         {
-          if (lasreader1->point.have_nir || lasreader2->point.have_nir)
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[4])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGBI of point %u of %u is different: (%d %d %d %d) != (%d %d %d %d)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader1->point.rgb[3], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2], lasreader2->point.rgb[3]);
-              difference = true;
-            }
-          }
-          else
-          {
-            if (memcmp((const void*)&(lasreader1->point.rgb), (const void*)&(lasreader2->point.rgb), sizeof(short[3])))
-            {
-              if (different_points < shutup) fprintf(stderr, "RGB of point %u of %u is different: (%d %d %d) != (%d %d %d)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.rgb[0], lasreader1->point.rgb[1], lasreader1->point.rgb[2], lasreader2->point.rgb[0], lasreader2->point.rgb[1], lasreader2->point.rgb[2]);
-              difference = true;
-            }
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
         }
-        if (lasreader1->point.have_wavepacket || lasreader2->point.have_wavepacket)
+        else if (lasreader1->point.extra_bytes_number == 3)
         {
-          if (memcmp((const void*)&(lasreader1->point.wavepacket), (const void*)&(lasreader2->point.wavepacket), sizeof(LASwavepacket)))
-          {
-            if (different_points < shutup) fprintf(stderr, "wavepacket of point %u of %u is different: (%d %d %d %g %g %g %g) != (%d %d %d %g %g %g %g)\n", (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.wavepacket.getIndex(), (I32)lasreader1->point.wavepacket.getOffset(), lasreader1->point.wavepacket.getSize(), lasreader1->point.wavepacket.getLocation(), lasreader1->point.wavepacket.getXt(), lasreader1->point.wavepacket.getYt(), lasreader1->point.wavepacket.getZt(), lasreader2->point.wavepacket.getIndex(), (I32)lasreader2->point.wavepacket.getOffset(), lasreader2->point.wavepacket.getSize(), lasreader2->point.wavepacket.getLocation(), lasreader2->point.wavepacket.getXt(), lasreader2->point.wavepacket.getYt(), lasreader2->point.wavepacket.getZt());
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
         }
-        if (lasreader1->point.extra_bytes_number)
+        else if (lasreader1->point.extra_bytes_number == 4)
         {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader1->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 8)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 9)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 10)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 11)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 12)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 13)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 14)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 15)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 16)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 17)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
-              }
-            }
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
         }
-        else if (lasreader2->point.extra_bytes_number)
+        else if (lasreader1->point.extra_bytes_number == 5)
         {
-          if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
-          {
-            if (different_points < shutup)
-            {
-              if (lasreader1->point.extra_bytes_number == 1)
-              {
-                fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 2)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 3)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 4)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 5)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 6)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
-              }
-              else if (lasreader1->point.extra_bytes_number == 7)
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
-              }
-              else
-              {
-                fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
-              }
-            }
-            difference = true;
-          }
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
         }
-        if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
+        else if (lasreader1->point.extra_bytes_number == 6)
         {
-          if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scan_angle: %d %d (point index %u)\n", lasreader1->point.extended_scan_angle, lasreader2->point.extended_scan_angle, (U32)(lasreader1->p_count-1));
-            difference = true;
-          }
-          if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
-          {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
-            difference = true;
-          }
-          if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 7)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 8)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 9)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 10)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 11)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 12)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 13)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 14)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 15)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 16)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 17)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ... != %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d %d ...\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader1->point.extra_bytes[8], lasreader1->point.extra_bytes[9], lasreader1->point.extra_bytes[10], lasreader1->point.extra_bytes[11], lasreader1->point.extra_bytes[12], lasreader1->point.extra_bytes[13], lasreader1->point.extra_bytes[14], lasreader1->point.extra_bytes[15], lasreader1->point.extra_bytes[16], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7], lasreader2->point.extra_bytes[8], lasreader2->point.extra_bytes[9], lasreader2->point.extra_bytes[10], lasreader2->point.extra_bytes[11], lasreader2->point.extra_bytes[12], lasreader2->point.extra_bytes[13], lasreader2->point.extra_bytes[14], lasreader2->point.extra_bytes[15], lasreader2->point.extra_bytes[16]);
+        }
+      }
+      difference = true;
+    }
+  }
+  else if (lasreader2->point.extra_bytes_number)
+  {
+    if (memcmp((const void*)lasreader1->point.extra_bytes, (const void*)lasreader2->point.extra_bytes, lasreader2->point.extra_bytes_number))
+    {
+      if (different_points < shutup)
+      {
+        if (lasreader1->point.extra_bytes_number == 1)
+        {
+          fprintf(stderr, "%d extra_byte of point %u of %u are different: %d != %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader2->point.extra_bytes[0]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 2)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d != %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 3)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d != %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 4)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d != %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 5)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d != %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 6)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d != %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5]);
+        }
+        else if (lasreader1->point.extra_bytes_number == 7)
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d != %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6]);
+        }
+        else
+        {
+          fprintf(stderr, "%d extra_bytes of point %u of %u are different: %d %d %d %d %d %d %d %d != %d %d %d %d %d %d %d %d\n", lasreader1->point.extra_bytes_number,  (U32)lasreader1->p_count, (U32)lasreader1->npoints, lasreader1->point.extra_bytes[0], lasreader1->point.extra_bytes[1], lasreader1->point.extra_bytes[2], lasreader1->point.extra_bytes[3], lasreader1->point.extra_bytes[4], lasreader1->point.extra_bytes[5], lasreader1->point.extra_bytes[6], lasreader1->point.extra_bytes[7], lasreader2->point.extra_bytes[0], lasreader2->point.extra_bytes[1], lasreader2->point.extra_bytes[2], lasreader2->point.extra_bytes[3], lasreader2->point.extra_bytes[4], lasreader2->point.extra_bytes[5], lasreader2->point.extra_bytes[6], lasreader2->point.extra_bytes[7]);
+        }
+      }
+      difference = true;
+    }
+  }
+  if (lasreader1->point.extended_point_type || lasreader2->point.extended_point_type )
+  {
+    if (lasreader1->point.extended_scan_angle != lasreader2->point.extended_scan_angle)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_scan_angle: %d %d (point index %u)\n", lasreader1->point.extended_scan_angle, lasreader2->point.extended_scan_angle, (U32)(lasreader1->p_count-1));
+      difference = true;
+    }
+    if (lasreader1->point.extended_scanner_channel != lasreader2->point.extended_scanner_channel)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_scanner_channel: %d %d\n", lasreader1->point.extended_scanner_channel, lasreader2->point.extended_scanner_channel);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification_flags != lasreader2->point.extended_classification_flags)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_classification_flags: %d %d\n", lasreader1->point.extended_classification_flags, lasreader2->point.extended_classification_flags);
+      difference = true;
+    }
+    if (lasreader1->point.extended_classification != lasreader2->point.extended_classification)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
+      difference = true;
+    }
+    if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
+      difference = true;
+    }
+    if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
+    {
+      if (different_points < shutup) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
+      difference = true;
+    }
+  }
+
+  return difference;
+};
+
+// the chunks of points that one thread compares with '-threads'
+struct LASdiffRange
+{
+  LASreader* lasreader1 = 0;
+  LASreader* lasreader2 = 0;
+  I64 start = 0;
+  I64 end = 0;
+  std::vector<I64> different_chunks; // the first point of each chunk whose raw points differ
+  std::atomic<I64> different_points{0}; // the points with different raw points found so far
+};
+
+// compares the decoded raw points chunk by chunk on several threads and only compares field by field
+// inside the chunks that are different. returns -1 when the files cannot be compared this way
+
+static int check_chunks(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2)
+{
+  // needs two LAS or LAZ files with the same number and type of points that are read in file order
+
+  if ((lasreader1->get_format() != LAS_TOOLS_FORMAT_LAS) && (lasreader1->get_format() != LAS_TOOLS_FORMAT_LAZ)) return -1;
+  if ((lasreader2->get_format() != LAS_TOOLS_FORMAT_LAS) && (lasreader2->get_format() != LAS_TOOLS_FORMAT_LAZ)) return -1;
+  if (scaled_offset_difference || (lasreader1->npoints != lasreader2->npoints) || (lasreader1->npoints == 0)) return -1;
+  if ((lasreader1->header.point_data_format != lasreader2->header.point_data_format) || (lasreader1->point.total_point_size != lasreader2->point.total_point_size)) return -1;
+  if (lasreader1->get_copcindex() || lasreader2->get_copcindex() || lasreader1->get_filter() || lasreader2->get_filter()) return -1;
+  if (lasreader1->get_transform() || lasreader2->get_transform() || lasreader1->get_inside() || lasreader2->get_inside()) return -1;
+  if ((lasreader1->opener == 0) || (lasreader2->opener == 0)) return -1;
+
+  // the chunks of the first file (or blocks of as many points for LAS and variable chunking)
+
+  I64 chunk_size = ((lasreader1->header.laszip && (lasreader1->header.laszip->chunk_size != U32_MAX)) ? lasreader1->header.laszip->chunk_size : LASZIP_CHUNK_SIZE_DEFAULT);
+  I64 number_chunks = (lasreader1->npoints + chunk_size - 1) / chunk_size;
+  U32 number_ranges = (number_chunks < threads ? (U32)number_chunks : threads);
+
+  // the first range uses the given readers and the others their own
+
+  std::vector<LASdiffRange*> ranges;
+  bool failed = false;
+  U32 r;
+  for (r = 0; r < number_ranges; r++)
+  {
+    LASdiffRange* range = new LASdiffRange;
+    ranges.push_back(range);
+    range->start = (number_chunks * r / number_ranges) * chunk_size;
+    range->end = (r + 1 == number_ranges ? lasreader1->npoints : (number_chunks * (r + 1) / number_ranges) * chunk_size);
+    range->lasreader1 = (r == 0 ? lasreader1 : lasreader1->opener->open(file_name1, FALSE));
+    range->lasreader2 = (r == 0 ? lasreader2 : lasreader2->opener->open(file_name2, FALSE));
+    if ((range->lasreader1 == 0) || (range->lasreader2 == 0) || (range->start && (!range->lasreader1->seek(range->start) || !range->lasreader2->seek(range->start))))
+    {
+      failed = true;
+      break;
+    }
+  }
+
+  if (!failed)
+  {
+    LASthreadPool pool(number_ranges);
+    std::vector<std::future<BOOL>> compared;
+    for (r = 0; r < number_ranges; r++)
+    {
+      LASdiffRange* range = ranges[r];
+      compared.push_back(pool.submit<BOOL>([&, range, r]() -> BOOL
+      {
+        size_t size = range->lasreader1->point.total_point_size;
+        std::vector<U8> points1((size_t)chunk_size * size);
+        std::vector<U8> points2((size_t)chunk_size * size);
+        I64 start, n;
+        for (start = range->start; start < range->end; start += chunk_size)
+        {
+          // stop once enough differences were found before this chunk. only the differences of this
+          // and the earlier ranges count, so that the same points are reported as when comparing serially
+          if (stop_after)
           {
-            if (different_points < shutup) fprintf(stderr, "  extended_classification: %d %d\n", lasreader1->point.extended_classification, lasreader2->point.extended_classification);
-            difference = true;
+            I64 before = range->different_points.load();
+            for (U32 q = 0; q < r; q++) before += ranges[q]->different_points.load();
+            if (before >= stop_after) break;
           }
-          if (lasreader1->point.extended_return_number != lasreader2->point.extended_return_number)
+          I64 count = ((range->end - start) < chunk_size ? (range->end - start) : chunk_size);
+          for (n = 0; n < count; n++)
           {
-            if (different_points < shutup) fprintf(stderr, "  extended_return_number: %d %d\n", lasreader1->point.extended_return_number, lasreader2->point.extended_return_number);
-            difference = true;
+            if (!range->lasreader1->read_point() || !range->lasreader2->read_point()) return FALSE;
+            range->lasreader1->point.copy_to(&points1[(size_t)n * size]);
+            range->lasreader2->point.copy_to(&points2[(size_t)n * size]);
           }
-          if (lasreader1->point.extended_number_of_returns != lasreader2->point.extended_number_of_returns)
+          if (memcmp(points1.data(), points2.data(), (size_t)count * size))
           {
-            if (different_points < shutup) fprintf(stderr, "  extended_number_of_returns: %d %d\n", lasreader1->point.extended_number_of_returns, lasreader2->point.extended_number_of_returns);
-            difference = true;
+            I64 different = 0;
+            for (n = 0; n < count; n++)
+            {
+              if (memcmp(&points1[(size_t)n * size], &points2[(size_t)n * size], size)) different++;
+            }
+            range->different_chunks.push_back(start);
+            range->different_points += different;
           }
         }
+        return TRUE;
+      }));
+    }
+    for (r = 0; r < number_ranges; r++)
+    {
+      if (!compared[r].get()) failed = true;
+    }
+  }
+
+  std::vector<I64> different_chunks;
+  for (r = 0; r < ranges.size(); r++)
+  {
+    different_chunks.insert(different_chunks.end(), ranges[r]->different_chunks.begin(), ranges[r]->different_chunks.end());
+    if (r)
+    {
+      if (ranges[r]->lasreader1) { ranges[r]->lasreader1->close(); delete ranges[r]->lasreader1; }
+      if (ranges[r]->lasreader2) { ranges[r]->lasreader2->close(); delete ranges[r]->lasreader2; }
+    }
+    delete ranges[r];
+  }
+
+  if (failed)
+  {
+    LASMessage(LAS_VERBOSE, "cannot compare '%s' and '%s' chunk by chunk. comparing point by point ...", file_name1, file_name2);
+    if (!lasreader1->seek(0) || !lasreader2->seek(0))
+    {
+      laserror("cannot seek back to the first point");
+    }
+    return -1;
+  }
+
+  // compare the points of the chunks that differ field by field
+
+  int different_points = 0;
+  bool stopped = false;
+  size_t c;
+  for (c = 0; (c < different_chunks.size()) && !stopped; c++)
+  {
+    I64 start = different_chunks[c];
+    I64 count = ((lasreader1->npoints - start) < chunk_size ? (lasreader1->npoints - start) : chunk_size);
+    int different_in_chunk = 0;
+    if (!lasreader1->seek(start) || !lasreader2->seek(start))
+    {
+      laserror("cannot seek to point %lld", start);
+    }
+    I64 n;
+    for (n = 0; (n < count) && lasreader1->read_point() && lasreader2->read_point(); n++)
+    {
+      if (check_point(lasreader1, lasreader2, different_points))
+      {
+        different_points++;
+        different_in_chunk++;
+        if (different_points == shutup) fprintf(stderr, "already %d points are different ... shutting up.\n", shutup);
+        if (stop_after && (different_points >= stop_after))
+        {
+          stopped = true;
+          break;
+        }
+      }
+    }
+    if (summary && different_in_chunk) fprintf(stderr, "points %lld to %lld: %d different\n", start, start + count - 1, different_in_chunk);
+  }
+
+  // both files have been read entirely unless stopped early
+
+  if (stopped)
+  {
+    stopped_early = true;
+    fprintf(stderr, "stopped after %d different points.\n", different_points);
+  }
+  else
+  {
+    lasreader1->p_count = lasreader1->npoints;
+    lasreader2->p_count = lasreader2->npoints;
+  }
+  LASMessage(LAS_VERBOSE, "compared %lld chunks of %lld points on %u threads. %u chunks have different raw points.", number_chunks, chunk_size, number_ranges, (U32)different_chunks.size());
+
+  if (different_points)
+  {
+    fprintf(stderr, "%u points are different.\n", different_points);
+  }
+  else
+  {
+    fprintf(stderr, "raw points are identical.\n");
+  }
+
+  return different_points;
+};
+
+static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHAR* file_name2, LASreader* lasreader2, LASwriter* laswriter, I32 random_seeks)
+{
+  int seeking = random_seeks;
+
+  int different_points = 0;
+
+  different_scaled_offset_coordinates = 0;
+  stopped_early = false;
+  max_diff_x = 0.0;
+  max_diff_y = 0.0;
+  max_diff_z = 0.0;
+
+  // maybe compare chunk by chunk on several threads
+
+  if (threads && !laswriter && !random_seeks)
+  {
+    different_points = check_chunks(file_name1, lasreader1, file_name2, lasreader2);
+    if (different_points >= 0) return different_points;
+    different_points = 0;
+  }
+
+  while (true)
+  {
+    bool difference = false;
+    if (seeking)
+    {
+      if (lasreader1->p_count%100000 == 25000)
+      {
+        I64 s = (rand()*rand())%lasreader1->npoints;
+        fprintf(stderr, "at p_count %u seeking to %u\n", (U32)lasreader1->p_count, (U32)s);
+        lasreader1->seek(s);
+        lasreader2->seek(s);
+        seeking--;
+      }
+    }
+    if (lasreader1->read_point())
+    {
+      if (lasreader2->read_point())
+      {
+        difference = check_point(lasreader1, lasreader2, different_points);
       }
       else
       {
@@ -807,6 +1021,12 @@ static int check_points(const CHAR* file_name1, LASreader* lasreader1, const CHA
     {
       different_points++;
       if (different_points == shutup) fprintf(stderr, "already %d points are different ... shutting up.\n", shutup);
+      if (stop_after && (different_points >= stop_after))
+      {
+        stopped_early = true;
+        fprintf(stderr, "stopped after %d different points.\n", different_points);
+        break;
+      }
     }
     if (laswriter)
     {
@@ -913,6 +1133,28 @@ int main(int argc, char *argv[])
       i++;
       shutup = atoi(argv[i]);;
     }
+    else if (strcmp(argv[i],"-threads") == 0)
+    {
+      threads = lastool.parse_arg_threads(i);
+      i++;
+    }
+    else if (strcmp(argv[i],"-stop_after") == 0)
+    {
+      if ((i+1) >= argc)
+      {
+        laserror("'%s' needs 1 argument: number", argv[i]);
+      }
+      if (sscanf_las(argv[i+1], "%d", &stop_after) != 1)
+      {
+        laserror("cannot understand argument '%s' for '%s'", argv[i+1], argv[i]);
+      }
+      i++;
+    }
+    else if (strcmp(argv[i],"-summary") == 0)
+    {
+      summary = true;
+      shutup = 0;
+    }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
       lasreadopener.add_file_name(argv[i]);
@@ -999,7 +1241,11 @@ int main(int argc, char *argv[])
 
       if (!different_header && !different_points && !different_scaled_offset_coordinates) fprintf(stderr, "files are identical. ");
 
-      if (lasreader1->p_count == lasreader2->p_count)
+      if (stopped_early)
+      {
+        LASMessage(LAS_INFO, "stopped early after comparing %lld of %lld points. took %g secs.", lasreader1->p_count, lasreader1->npoints, taketime()-start_time);
+      }
+      else if (lasreader1->p_count == lasreader2->p_count)
       {
         LASMessage(LAS_INFO, "both have %lld points. took %g secs.", lasreader1->p_count, taketime()-start_time);
       }
@@ -1118,7 +1364,11 @@ int main(int argc, char *argv[])
 
       if (!different_header && !different_points && !different_scaled_offset_coordinates) fprintf(stderr, "files are identical. ");
 
-      if (lasreader1->p_count == lasreader2->p_count)
+      if (stopped_early)
+      {
+        LASMessage(LAS_INFO, "stopped early after comparing %lld of %lld points. took %g secs.", lasreader1->p_count, lasreader1->npoints, taketime()-start_time);
+      }
+      else if (lasreader1->p_count == lasreader2->p_count)
       {
         LASMessage(LAS_INFO, "both have %lld points. took %g secs.", lasreader1->p_count, taketime()-start_time);
       }
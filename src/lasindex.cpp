@@ -43,7 +43,7 @@
 
   CHANGE HISTORY:
 
-
+    16 October 2026 -- '-threads 4' indexes ranges of points in parallel with an identical LAX
     22 March 2022 -- Add -o parameter for user defined output file
      1 May 2017 -- 2nd example for selective decompression for new LAS 1.4 points
     17 May 2011 -- enabling batch processing with wildcards or multiple file names
@@ -57,10 +57,16 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <deque>
+#include <vector>
+
 #include "lasreader.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 #include "lasindex.hpp"
+#include "lasinterval.hpp"
 #include "lasquadtree.hpp"
+#include "laspointbatch.hpp"
+#include "lasthreadpool.hpp"
 #include "lasmessage.hpp"
 #include "lastool.hpp"
 
@@ -75,6 +81,7 @@ public:
     fprintf(stderr, "lasindex *.las\n");
     fprintf(stderr, "lasindex flight1*.las flight2*.las -verbose\n");
     fprintf(stderr, "lasindex lidar.las -tile_size 2 -maximum -50\n");
+    fprintf(stderr, "lasindex huge.laz -threads 4\n");
     fprintf(stderr, "lasindex -h\n");
   };
 };
@@ -96,9 +103,11 @@ int main(int argc, char *argv[])
 {
   LasTool_lasindex lastool;
   lastool.init(argc, argv, "lasindex");
+  lastool.multi_core = true;
   int i;
   F32 tile_size = 0.0f;
   U32 threshold = 1000;
+  U32 threads = 1;
   U32 minimum_points = 100000;
   I32 maximum_intervals = -20;
   BOOL meta = FALSE;
@@ -169,6 +178,11 @@ int main(int argc, char *argv[])
       i++;
       threshold = atoi(argv[i]);
     }
+    else if (strcmp(argv[i],"-threads") == 0)
+    {
+      threads = lastool.parse_arg_threads(i);
+      i++;
+    }
     else if (strcmp(argv[i],"-meta") == 0)
     {
       meta = TRUE;
@@ -231,6 +245,11 @@ int main(int argc, char *argv[])
   {
     lasindex_multi_core(argc, argv, &lasreadopener, 1, TRUE);
   }
+#else
+  if (lastool.cores > 1)
+  {
+    if (lastool.run_multi_core(&lasreadopener)) byebye();
+  }
 #endif
 
   // check input
@@ -382,7 +401,48 @@ int main(int argc, char *argv[])
 
     LASindex lasindex;
     lasindex.prepare(lasquadtree, threshold);
-    while (lasreader->read_point()) lasindex.add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(lasreader->p_count-1));
+    if ((threads > 1) && (lasreader->get_filter() == 0) && (lasreader->get_transform() == 0))
+    {
+      // each batch of points is indexed on its own by the next available thread and the batches
+      // are added in order. without filter the index of a point is its position in the batches
+      LASthreadPool pool(threads);
+      LASpointBatch batch;
+      batch.init(&lasreader->point);
+      const LASquantizer* quantizer = lasreader->point.quantizer;
+      std::deque< std::pair<LASinterval*, std::future<BOOL> > > ranges;
+      U32 p_index = 0;
+      U32 n;
+      while ((n = lasreader->read_points(batch)) > 0)
+      {
+        std::shared_ptr< std::vector<I32> > X = std::make_shared< std::vector<I32> >(batch.X, batch.X + n);
+        std::shared_ptr< std::vector<I32> > Y = std::make_shared< std::vector<I32> >(batch.Y, batch.Y + n);
+        LASinterval* range = lasindex.create_range();
+        ranges.push_back(std::make_pair(range, pool.submit<BOOL>([&lasindex, range, quantizer, X, Y, p_index, n]() -> BOOL
+        {
+          for (U32 j = 0; j < n; j++) lasindex.add(range, quantizer->get_x((*X)[j]), quantizer->get_y((*Y)[j]), p_index + j);
+          return TRUE;
+        })));
+        p_index += n;
+        while (ranges.size() >= 2*threads)
+        {
+          ranges.front().second.get();
+          lasindex.add_range(ranges.front().first);
+          delete ranges.front().first;
+          ranges.pop_front();
+        }
+      }
+      while (ranges.size())
+      {
+        ranges.front().second.get();
+        lasindex.add_range(ranges.front().first);
+        delete ranges.front().first;
+        ranges.pop_front();
+      }
+    }
+    else
+    {
+      while (lasreader->read_point()) lasindex.add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(lasreader->p_count-1));
+    }
 
     // delete the reader
 
@@ -30,6 +30,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- new option '-metadata' only reads header, VLRs, EVLRs and chunk table and streams '-json'
+    16 October 2026 -- new option '-threads 4' gathers the point statistics of a file in parallel
     10 June 2021 -- new option '-delete_empty' for deleting LAS files with zero points
     11 November 2020 -- new option '-set_vlr_record_id 2 4711'
     11 November 2020 -- new option '-set_vlr_user_id 1 "hello martin"'
@@ -60,6 +62,7 @@
 #include "lasindex.hpp"
 #include "lasquadtree.hpp"
 #include "lasreader.hpp"
+#include "lasthreadpool.hpp"
 #include "lasutility.hpp"
 #include "lasvlrpayload.hpp"
 #include "laswriter.hpp"
@@ -69,6 +72,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+
+#include <vector>
 #ifdef _WIN32
 #include <windows.h>
 #endif
@@ -189,6 +194,24 @@ static bool valid_resolution(F64 coordinate, F64 offset, F64 scale_factor) {
   return false;
 }
 
+// the point statistics that one thread gathers with '-threads' for its range of the points of a file
+struct LASinfoRange {
+  LASreader* lasreader = 0;
+  I64 count = 0;
+  LASsummary lassummary;
+  LAShistogram lashistogram;
+  LASoccupancyGrid* lasoccupancygrid = 0;
+  I64 num_first_returns = 0;
+  I64 num_intermediate_returns = 0;
+  I64 num_last_returns = 0;
+  I64 num_single_returns = 0;
+  I64 num_all_returns = 0;
+  I64 outside_bounding_box = 0;
+  ~LASinfoRange() {
+    if (lasoccupancygrid) delete lasoccupancygrid;
+  }
+};
+
 #ifdef COMPILE_WITH_GUI
 extern void lasinfo_gui(int argc, char* argv[], LASreadOpener* lasreadopener);
 #endif
@@ -218,6 +241,7 @@ class LasTool_lasinfo : public LasTool {
     bool no_min_max = false;
     bool no_warnings = false;
     bool check_points = true;
+    bool metadata_only = false;
     bool compute_density = false;
     bool gps_week = false;
     bool check_outside = true;
@@ -273,9 +297,10 @@ class LasTool_lasinfo : public LasTool {
     I64 subsequence_start = 0;
     I64 subsequence_stop = I64_MAX;
     U32 progress = 0;
+    U32 threads = 1;
     // rename
     CHAR* base_name = 0;
-    JsonObject json_main;
+    FILE* json_stream = 0;
 
     LAShistogram lashistogram;
     LASreadOpener lasreadopener;
@@ -331,6 +356,9 @@ class LasTool_lasinfo : public LasTool {
         no_warnings = true;
       } else if (strcmp(argv[i], "-nc") == 0 || strcmp(argv[i], "-no_check") == 0) {
         check_points = false;
+      } else if (strcmp(argv[i], "-metadata") == 0) {
+        metadata_only = true;
+        check_points = false;
       } else if (strcmp(argv[i], "-cd") == 0 || strcmp(argv[i], "-compute_density") == 0) {
         compute_density = true;
       } else if (strcmp(argv[i], "-gw") == 0 || strcmp(argv[i], "-gps_week") == 0) {
@@ -730,9 +758,11 @@ class LasTool_lasinfo : public LasTool {
           laserror("'%s' needs 1 argument: every but '%u' is no valid number", argv[i], progress);
         }
         i++;
+      } else if (strcmp(argv[i], "-threads") == 0) {
+        threads = parse_arg_threads(i);
+        i++;
       } else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0)) {
-        lasreadopener.add_file_name(argv[i]);
-        argv[i][0] = '\0';
+        add_input_name(&lasreadopener, i);
       } else {
         return false;
       }
@@ -760,6 +790,10 @@ class LasTool_lasinfo : public LasTool {
     if (cpu64) {
       lasinfo_multi_core(argc, argv, &lasreadopener, &lashistogram, &laswriteopener, 1, TRUE);
     }
+#else
+    if (cores > 1) {
+      if (run_multi_core(&lasreadopener, &laswriteopener)) byebye();
+    }
 #endif
 
     // check input
@@ -810,6 +844,15 @@ class LasTool_lasinfo : public LasTool {
 
     lasreadopener.set_decompress_selective(decompress_selective);
 
+    // only open LAS/LAZ files for their header, VLRs, EVLRs and chunk table without preparing to read points
+
+    if (metadata_only) {
+      if (edit_header || repair_bb || repair_counters || delete_empty || base_name) {
+        laserror("cannot edit, repair, delete or rename files when only reading their metadata");
+      }
+      lasreadopener.set_metadata_only(TRUE);
+    }
+
     // possibly loop over multiple input files
     while (lasreadopener.active()) {
       LASreader* lasreader = nullptr;
@@ -1295,7 +1338,7 @@ class LasTool_lasinfo : public LasTool {
         }
       }
 
-      if (laswriteopener.get_file_name()) {
+      if (laswriteopener.get_file_name() && !(json_out && json_stream)) {
         // make sure we do not corrupt the input file
         if (lasreadopener.get_file_name() && (strcmp(lasreadopener.get_file_name(), laswriteopener.get_file_name()) == 0)) {
           laserror("input and output file name for '%s' are identical", lasreadopener.get_file_name());
@@ -6628,7 +6671,7 @@ class LasTool_lasinfo : public LasTool {
         }
       }
 
-      if (file_out && !no_variable_header) {
+      if (file_out && !no_variable_header && !metadata_only) {
         const LASindex* index = lasreader->get_index();
         if (index) {
           if (json_out) {
@@ -6682,6 +6725,27 @@ class LasTool_lasinfo : public LasTool {
             }
           }
           if (!json_out) fprintf(file_out, "\012");
+          const LASchunkStatistics* chunk_statistics = lasreader->get_chunk_statistics();
+          if (chunk_statistics) {
+            if (json_out) {
+              JsonObject json_chunk_table;
+              json_chunk_table["number_of_chunks"] = chunk_statistics->number_chunks;
+              json_chunk_table["variable_size"] = (chunk_statistics->variable_size != FALSE);
+              json_chunk_table["start_of_chunks"] = chunk_statistics->start_of_chunks;
+              json_chunk_table["start_of_chunk_table"] = chunk_statistics->start_of_chunk_table;
+              json_chunk_table["points_per_chunk"]["min"] = chunk_statistics->min_points;
+              json_chunk_table["points_per_chunk"]["max"] = chunk_statistics->max_points;
+              json_chunk_table["bytes_per_chunk"]["min"] = chunk_statistics->min_bytes;
+              json_chunk_table["bytes_per_chunk"]["max"] = chunk_statistics->max_bytes;
+              json_sub_main["laszip_compression"]["chunk_table"] = json_chunk_table;
+            } else {
+              fprintf(
+                  file_out, "chunk table lists %u %s chunks with %lld to %lld points and %lld to %lld bytes from %lld to %lld\012",
+                  chunk_statistics->number_chunks, (chunk_statistics->variable_size ? "variable" : "fixed"), chunk_statistics->min_points,
+                  chunk_statistics->max_points, chunk_statistics->min_bytes, chunk_statistics->max_bytes, chunk_statistics->start_of_chunks,
+                  chunk_statistics->start_of_chunk_table);
+            }
+          }
         }
         if (lasheader->vlr_lastiling) {
           LASquadtree lasquadtree;
@@ -6772,18 +6836,120 @@ class LasTool_lasinfo : public LasTool {
         I64 num_all_returns = 0;
         I64 outside_bounding_box = 0;
         LASoccupancyGrid* lasoccupancygrid = 0;
+        F32 grid_spacing = (horizontal_units > 9001 ? 6.0f : 2.0f);
 
         if (compute_density) {
-          lasoccupancygrid = new LASoccupancyGrid(horizontal_units > 9001 ? 6.0f : 2.0f);
+          lasoccupancygrid = new LASoccupancyGrid(grid_spacing);
         }
 
         if (file_out && !no_min_max && !json_out) fprintf(file_out, "reporting minimum and maximum for all LAS point record entries ...\012");
 
-        // maybe seek to start position
+        // maybe split the points into chunk-aligned ranges that are read by their own readers. this
+        // needs a LAS or LAZ file whose points are all used and no output or progress for single points
+
+        std::vector<LASinfoRange*> ranges;
+
+        if ((threads > 1) && !progress && !(check_outside && report_outside) && !lasreadopener.is_piped() && !lasreadopener.is_merged() &&
+            !lasreadopener.is_buffered() && ((lasreader->get_format() == LAS_TOOLS_FORMAT_LAS) || (lasreader->get_format() == LAS_TOOLS_FORMAT_LAZ)) &&
+            !lasreader->get_filter() && !lasreader->get_transform() && !lasreader->get_ignore() && !lasreader->get_inside() &&
+            !lasreader->header.vlr_copc_entries) {
+          I64 stop = (subsequence_stop < lasreader->npoints ? subsequence_stop : lasreader->npoints);
+          I64 chunk_size = ((lasreader->header.laszip && (lasreader->header.laszip->chunk_size != U32_MAX)) ? lasreader->header.laszip->chunk_size : 1);
+          I64 start = subsequence_start;
+          BOOL failed = FALSE;
+          for (U32 r = 1; (r <= threads) && (start < stop); r++) {
+            I64 end = (r == threads ? stop : ((subsequence_start + (stop - subsequence_start) * r / threads) / chunk_size) * chunk_size);
+            if (end <= start) continue;
+            LASinfoRange* range = new LASinfoRange;
+            ranges.push_back(range);
+            range->lasreader = (ranges.size() == 1 ? lasreader : lasreadopener.open(lasreadopener.get_file_name(), FALSE));
+            range->count = end - start;
+            if ((range->lasreader == 0) || (start && !range->lasreader->seek(start))) {
+              failed = TRUE;
+              break;
+            }
+            start = end;
+          }
+          if (failed || (ranges.size() < 2)) {
+            LASMessage(LAS_VERBOSE, "cannot split points into ranges. ignoring '-threads %u' ...", threads);
+            for (size_t r = 0; r < ranges.size(); r++) {
+              if (ranges[r]->lasreader && (ranges[r]->lasreader != lasreader)) {
+                ranges[r]->lasreader->close();
+                delete ranges[r]->lasreader;
+              }
+              delete ranges[r];
+            }
+            ranges.clear();
+          }
+        }
 
-        if (subsequence_start) lasreader->seek(subsequence_start);
+        BOOL in_parallel = (ranges.size() != 0);
+
+        if (in_parallel) {
+          // each range is summarized by the next available thread and the partial results are merged in order.
+          // all ranges count the fluff against the low digits of the very first point so the merged counts are
+          // exactly those of one pass
+
+          LASreader* first_reader = lasreadopener.open(lasreadopener.get_file_name(), FALSE);
+          if (first_reader && (!subsequence_start || first_reader->seek(subsequence_start)) && first_reader->read_point()) {
+            for (size_t r = 0; r < ranges.size(); r++) ranges[r]->lassummary.set_fluff_reference(&first_reader->point);
+          }
+          if (first_reader) {
+            first_reader->close();
+            delete first_reader;
+          }
+
+          LASthreadPool pool(threads);
+          std::vector<std::future<BOOL>> summarized;
+          for (size_t r = 0; r < ranges.size(); r++) {
+            LASinfoRange* range = ranges[r];
+            if (lashistogram.active()) range->lashistogram.setup(&lashistogram);
+            if (lasoccupancygrid) range->lasoccupancygrid = new LASoccupancyGrid(grid_spacing);
+            summarized.push_back(pool.submit<BOOL>([&, range]() -> BOOL {
+              LASpoint* point = &range->lasreader->point;
+              for (I64 n = 0; (n < range->count) && range->lasreader->read_point(); n++) {
+                if (check_outside) {
+                  if (!point->inside_bounding_box(enlarged_min_x, enlarged_min_y, enlarged_min_z, enlarged_max_x, enlarged_max_y, enlarged_max_z)) {
+                    range->outside_bounding_box++;
+                  }
+                }
+                range->lassummary.add(point);
+                if (range->lasoccupancygrid) range->lasoccupancygrid->add(point);
+                if (point->is_first()) range->num_first_returns++;
+                if (point->is_intermediate()) range->num_intermediate_returns++;
+                if (point->is_last()) range->num_last_returns++;
+                if (point->is_single()) range->num_single_returns++;
+                range->num_all_returns++;
+                if (range->lashistogram.active()) range->lashistogram.add(point);
+              }
+              return TRUE;
+            }));
+          }
+          for (size_t r = 0; r < ranges.size(); r++) {
+            LASinfoRange* range = ranges[r];
+            summarized[r].get();
+            lassummary.merge(&range->lassummary, lasreader->point.attributer);
+            if (lasoccupancygrid) lasoccupancygrid->merge(range->lasoccupancygrid);
+            if (lashistogram.active()) lashistogram.merge(&range->lashistogram);
+            num_first_returns += range->num_first_returns;
+            num_intermediate_returns += range->num_intermediate_returns;
+            num_last_returns += range->num_last_returns;
+            num_single_returns += range->num_single_returns;
+            num_all_returns += range->num_all_returns;
+            outside_bounding_box += range->outside_bounding_box;
+            if (range->lasreader != lasreader) {
+              range->lasreader->close();
+              delete range->lasreader;
+            }
+            delete range;
+          }
+          ranges.clear();
+        } else if (subsequence_start) {
+          // maybe seek to start position
+          lasreader->seek(subsequence_start);
+        }
 
-        while (lasreader->read_point()) {
+        while (!in_parallel && lasreader->read_point()) {
           if (lasreader->p_count > subsequence_stop) break;
 
           if (check_outside) {
@@ -8229,7 +8395,26 @@ class LasTool_lasinfo : public LasTool {
         if (json_out && !json_bounding_box.is_null()) json_sub_main["bounding_box"] = json_bounding_box;
       }
 
-      if (file_out && json_out) json_main["lasinfo"].push_back(json_sub_main);
+      // the JSON report of each file is written right away so that the reports of many files are never all in memory
+      if (file_out && json_out) {
+        if (json_stream != file_out) {
+          fprintf(file_out, "{\n  \"lasinfo\": [\n");
+          json_stream = file_out;
+        } else {
+          fprintf(file_out, ",\n");
+        }
+        std::string json_string = json_sub_main.dump(2);
+        // indented like an entry of the 'lasinfo' array while the lines are written in one pass
+        const char* line = json_string.c_str();
+        const char* end_of_line;
+        fputs("    ", file_out);
+        while ((end_of_line = strchr(line, '\n')) != 0) {
+          fwrite(line, 1, end_of_line + 1 - line, file_out);
+          fputs("    ", file_out);
+          line = end_of_line + 1;
+        }
+        fputs(line, file_out);
+      }
 
       if (file_out && (file_out != stdout) && (file_out != stderr) && !json_out) fclose(file_out);
       if (!json_out) laswriteopener.set_file_name(0);
@@ -8238,11 +8423,10 @@ class LasTool_lasinfo : public LasTool {
       if (file) fclose(file);
     }
     // When creating the JSON file, it must only be closed at the very end, otherwise an invalid json will result if there are several input files
-    if (file_out && json_out) {
-      std::string json_string = json_main.dump(2);
-      fprintf(file_out, "%s", json_string.c_str());
+    if (json_stream) {
+      fprintf(json_stream, "\n  ]\n}");
 
-      if (file_out && (file_out != stdout) && (file_out != stderr)) fclose(file_out);
+      if ((json_stream != stdout) && (json_stream != stderr)) fclose(json_stream);
       laswriteopener.set_file_name(0);
     }
 
@@ -8266,6 +8450,8 @@ class LasTool_lasinfo : public LasTool {
     fprintf(stderr, "lasinfo -nv -nc -stdout -i lidar.las\n");
     fprintf(stderr, "lasinfo -nv -nc -stdout -i *.laz -single | grep version\n");
     fprintf(stderr, "lasinfo -i *.laz -subseq 100000 100100 -histo user_data 8\n");
+    fprintf(stderr, "lasinfo -i huge.laz -cd -histo z 1 -threads 4\n");
+    fprintf(stderr, "lasinfo -i *.laz -metadata -json -stdout\n");
     fprintf(stderr, "lasinfo -i *.las -repair\n");
     fprintf(stderr, "lasinfo -i *.laz -repair_bb -set_file_creation 8 2007\n");
     fprintf(stderr, "lasinfo -i *.las -repair_counters -set_version 1.2\n");
@@ -8276,5 +8462,6 @@ class LasTool_lasinfo : public LasTool {
 int main(int argc, char* argv[]) {
   LasTool_lasinfo lastool;
   lastool.init(argc, argv, "lasinfo");
+  lastool.multi_core = true;
   lastool.run();
 }
@@ -44,6 +44,7 @@
 
 #include "lasreader.hpp"
 #include "laswriter.hpp"
+#include "laspipeline.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
 
@@ -305,10 +306,18 @@ int main(int argc, char *argv[])
       laserror("could not open laswriter");
     }
     // loop over the points
-    while (lasreader->read_point())
+    if (lastool.pipeline)
     {
-      laswriter->write_point(&lasreader->point);
-      laswriter->update_inventory(&lasreader->point);
+      LASpipeline laspipeline;
+      laspipeline.run(lasreader, laswriter);
+    }
+    else
+    {
+      while (lasreader->read_point())
+      {
+        laswriter->write_point(&lasreader->point);
+        laswriter->update_inventory(&lasreader->point);
+      }
     }
     // close the writer
     laswriter->update_header(&lasreader->header, TRUE);
@@ -44,6 +44,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- streams all points in bounded memory and recommends scale factors and offsets
      1 May 2017 -- 3rd example for selective decompression for new LAS 1.4 points
     30 November 2010 -- created spotting few paper cups at Starbuck's Offenbach
 
@@ -55,18 +56,23 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+
 #include "lasreader.hpp"
 #include "laszip_decompress_selective_v3.hpp"
 #include "laswriter.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lastool.hpp"
 
-static void quicksort_for_shorts(short* a, int i, int j)
+static void quicksort_for_doubles(double* a, int i, int j)
 {
   int in_i = i;
   int in_j = j;
-  short key = a[(i+j)/2];
-  short w;
+  double key = a[(i+j)/2];
+  double w;
   do
   {
     while ( a[i] < key ) i++;
@@ -83,60 +89,195 @@ static void quicksort_for_shorts(short* a, int i, int j)
     i--;
     j++;
   }
-  if (j>in_i) quicksort_for_shorts(a, in_i, j);
-  if (i<in_j) quicksort_for_shorts(a, i, in_j);
+  if (j>in_i) quicksort_for_doubles(a, in_i, j);
+  if (i<in_j) quicksort_for_doubles(a, i, in_j);
+}
+
+// the bitmap of distinct raw integers covers at most this many values at a time (32 MB per coordinate).
+// coordinates spread over a wider range are analyzed in several passes over the points
+
+#define LAS_PRECISION_WINDOW (1 << 28)
+
+static void lidardouble2string(char* string, double value)
+{
+  int len;
+  len = sprintf(string, "%.15f", value) - 1;
+  while (string[len] == '0') len--;
+  if (string[len] != '.') len++;
+  string[len] = '\0';
 }
 
-static void quicksort_for_ints(int* a, int i, int j)
+static U32 greatest_common_divisor(U32 a, U32 b)
 {
-  int in_i = i;
-  int in_j = j;
-  int key = a[(i+j)/2];
-  int w;
-  do
+  while (b)
   {
-    while ( a[i] < key ) i++;
-    while ( a[j] > key ) j--;
-    if (i<j)
+    U32 r = a % b;
+    a = b;
+    b = r;
+  }
+  return a;
+}
+
+// streams the raw integers of one coordinate (or color channel) and collects how often each spacing
+// occurs between neighbouring values in sorted order without storing the points. the distinct values
+// in the current window of the value range are marked in a bitmap. the greatest common divisor of the
+// differences to the first value is the precision that is really in the data.
+
+class LASprecisionStream
+{
+public:
+  I64 count;
+  I64 distinct;
+  I64 min;
+  I64 max;
+  I32 first;
+  U32 divisor;
+  std::map<I64, I64> spacings;
+
+  void init(const I64 start, const I64 end)
+  {
+    count = 0;
+    distinct = 0;
+    min = I64_MAX;
+    max = I64_MIN;
+    first = 0;
+    divisor = 0;
+    spacings.clear();
+    have_last = FALSE;
+    window_start = start;
+    set_window(end);
+  };
+
+  inline void add(const I32 value)
+  {
+    I64 i = (I64)value - window_start;
+    if ((i >= 0) && (i < window_size)) bits[i >> 6] |= (((U64)1) << (i & 63));
+  };
+
+  // only during the first pass over the points
+  inline void add_first(const I32 value)
+  {
+    if (count == 0)
     {
-      w = a[i];
-      a[i] = a[j];
-      a[j] = w;
+      first = value;
     }
-  } while (++i<=--j);
-  if (i == j+3)
+    else if (divisor != 1)
+    {
+      U32 difference = (U32)(value > first ? (I64)value - first : (I64)first - value);
+      if (divisor == 0) divisor = difference;
+      else if (difference % divisor) divisor = greatest_common_divisor(divisor, difference % divisor);
+    }
+    if (value < min) min = value;
+    if (value > max) max = value;
+    count++;
+    add(value);
+  };
+
+  // collects the spacings in the current window and moves it along. returns TRUE once all are collected
+  BOOL next_window()
   {
-    i--;
-    j++;
-  }
-  if (j>in_i) quicksort_for_ints(a, in_i, j);
-  if (i<in_j) quicksort_for_ints(a, i, in_j);
-}
+    if (count == 0) return TRUE;
+    if (!have_last && (min < window_start))
+    {
+      // the bounding box of the header was wrong. start over at the true minimum
+      spacings.clear();
+      window_start = min;
+      set_window(max);
+      return FALSE;
+    }
+    U64 w, b;
+    I64 value;
+    for (w = 0; w < words; w++)
+    {
+      if (bits[w] == 0) continue;
+      for (value = window_start + (I64)(w << 6), b = bits[w]; b; value++, b >>= 1)
+      {
+        if (b & 1)
+        {
+          if (have_last) spacings[value - last]++;
+          last = value;
+          have_last = TRUE;
+          distinct++;
+        }
+      }
+    }
+    if (window_start + window_size > max)
+    {
+      if (count > distinct) spacings[0] = count - distinct;
+      return TRUE;
+    }
+    window_start += window_size;
+    set_window(max);
+    return FALSE;
+  };
 
-static void quicksort_for_doubles(double* a, int i, int j)
+  LASprecisionStream()
+  {
+    bits = 0;
+    capacity = 0;
+    init(0, -1);
+  };
+  ~LASprecisionStream()
+  {
+    if (bits) delete [] bits;
+  };
+
+private:
+  U64* bits;
+  U64 words;
+  U64 capacity;
+  I64 window_start;
+  I64 window_size;
+  I64 last;
+  BOOL have_last;
+
+  void set_window(const I64 end)
+  {
+    window_size = end - window_start + 1;
+    if (window_size < 1) window_size = 1;
+    else if (window_size > LAS_PRECISION_WINDOW) window_size = LAS_PRECISION_WINDOW;
+    words = (U64)((window_size + 63) >> 6);
+    if (words > capacity)
+    {
+      if (bits) delete [] bits;
+      bits = new U64[words];
+      capacity = words;
+    }
+    memset(bits, 0, words*sizeof(U64));
+  };
+};
+
+// outputs the histogram of spacings and (optionally) of the differences between the distinct spacings
+
+static void report_spacings(const char* name, const LASprecisionStream* stream, const F64 scale_factor, const U32 report_lines, const bool report_diff, const bool report_diff_diff)
 {
-  int in_i = i;
-  int in_j = j;
-  double key = a[(i+j)/2];
-  double w;
-  do
+  U32 count_lines = 0;
+  if (report_diff) fprintf(stdout, "%s differences \n", name);
+  std::map<I64, I64>::const_iterator spacing;
+  std::vector<I64> differences;
+  for (spacing = stream->spacings.begin(); spacing != stream->spacings.end(); spacing++)
   {
-    while ( a[i] < key ) i++;
-    while ( a[j] > key ) j--;
-    if (i<j)
+    if (report_diff)
     {
-      w = a[i];
-      a[i] = a[j];
-      a[j] = w;
+      if (scale_factor == 0.0) fprintf(stdout, "  %10lld : %10lld\n", spacing->first, spacing->second);
+      else if (count_lines < report_lines) { count_lines++; fprintf(stdout, " %10lld : %10lld   %g\n", spacing->first, spacing->second, scale_factor*spacing->first); }
     }
-  } while (++i<=--j);
-  if (i == j+3)
+    if (spacing != stream->spacings.begin()) differences.push_back(spacing->first - std::prev(spacing)->first);
+  }
+  if (report_diff_diff)
   {
-    i--;
-    j++;
+    fprintf(stdout, "%s differences of differences\n", name);
+    std::sort(differences.begin(), differences.end());
+    size_t count, last;
+    for (last = 0, count = 1; count <= differences.size(); count++)
+    {
+      if ((count == differences.size()) || (differences[last] != differences[count]))
+      {
+        fprintf(stdout, "  %10lld : %10d\n", differences[last], (int)(count - last));
+        last = count;
+      }
+    }
   }
-  if (j>in_i) quicksort_for_doubles(a, in_i, j);
-  if (i<in_j) quicksort_for_doubles(a, i, in_j);
 }
 
 class LasTool_lasprecision : public LasTool
@@ -174,6 +315,7 @@ int main(int argc, char *argv[])
 {
   LasTool_lasprecision lastool;
   lastool.init(argc, argv, "lasprecision");
+  lastool.multi_core = true;
   int i;
   bool report_diff = true;
   bool report_diff_diff = false;
@@ -184,6 +326,7 @@ int main(int argc, char *argv[])
   bool report_rgb = false;
   bool output = false;
   U32 report_lines = 20;
+  I64 point_max = I64_MAX;
   U32 array_max = 5000000;
   bool projection_was_set = false;
   double start_time = 0;
@@ -258,7 +401,8 @@ int main(int argc, char *argv[])
         laserror("'%s' needs 1 argument: max", argv[i]);
       }
       i++;
-      array_max = atoi(argv[i]);
+      point_max = atoi(argv[i]);
+      array_max = (U32)point_max;
     }
     else if (strcmp(argv[i],"-lines") == 0)
     {
@@ -271,12 +415,12 @@ int main(int argc, char *argv[])
     }
     else if (strcmp(argv[i],"-all") == 0)
     {
+      point_max = I64_MAX;
       array_max = U32_MAX;
     }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
-      lasreadopener.add_file_name(argv[i]);
-      argv[i][0] = '\0';
+      lastool.add_input_name(&lasreadopener, i);
     }
     else
     {
@@ -314,6 +458,11 @@ int main(int argc, char *argv[])
       lasprecision_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, lastool.cores, lastool.cpu64);
     }
   }
+#else
+  if (lastool.cores > 1)
+  {
+    if (lastool.run_multi_core(&lasreadopener, &laswriteopener)) byebye();
+  }
 #endif
 
   // check input
@@ -355,6 +504,9 @@ int main(int argc, char *argv[])
     projection_was_set = geoprojectionconverter.get_geo_keys_from_projection(number_of_keys, &geo_keys, num_geo_double_params, &geo_double_params);
   }
 
+  LASprecisionStream stream_x, stream_y, stream_z;
+  LASprecisionStream stream_r, stream_g, stream_b;
+
   // possibly loop over multiple input files
 
   while (lasreadopener.active())
@@ -369,301 +521,152 @@ int main(int argc, char *argv[])
       laserror("could not open lasreader");
     }
 
-    // run presicion statistics across the first array_max points
+    // stream the precision statistics across the first point_max points
 
     if (!output)
     {
       fprintf(stdout, "original scale factors: %g %g %g\n", lasreader->header.x_scale_factor, lasreader->header.y_scale_factor, lasreader->header.z_scale_factor);
 
-      // create the arrays
-      int* array_x = 0;
-      int* array_y = 0;
-      int* array_z = 0;
+      // the raw integers of each coordinate are streamed into a bitmap starting with the bounding box of the header
+
       if (report_x)
       {
-        array_x = new int[array_max];
+        stream_x.init(lasreader->header.get_X(lasreader->header.min_x), lasreader->header.get_X(lasreader->header.max_x));
       }
       if (report_y)
       {
-        array_y = new int[array_max];
+        stream_y.init(lasreader->header.get_Y(lasreader->header.min_y), lasreader->header.get_Y(lasreader->header.max_y));
       }
       if (report_z)
       {
-        array_z = new int[array_max];
+        stream_z.init(lasreader->header.get_Z(lasreader->header.min_z), lasreader->header.get_Z(lasreader->header.max_z));
       }
 
-      double* array_gps = 0;
-      if (report_gps && lasreader->point.have_gps_time)
+      bool rgb = (report_rgb && lasreader->point.have_rgb);
+      if (rgb)
       {
-        array_gps = new double[array_max];
+        stream_r.init(0, U16_MAX);
+        stream_g.init(0, U16_MAX);
+        stream_b.init(0, U16_MAX);
       }
 
-      short* array_r = 0;
-      short* array_g = 0;
-      short* array_b = 0;
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        array_r = new short[array_max];
-        array_g = new short[array_max];
-        array_b = new short[array_max];
-      }
+      // only the GPS time stamps are kept in an array (of at most array_max entries) and sorted
 
-      // do the first pass
+      bool gps = (report_gps && lasreader->point.have_gps_time);
+      std::vector<F64> array_gps;
 
-      LASMessage(LAS_INFO, "loading first %u of %u points", array_max, (U32)lasreader->npoints);
+      LASMessage(LAS_INFO, "streaming %lld of %lld points", (point_max < lasreader->npoints ? point_max : lasreader->npoints), lasreader->npoints);
 
-      // loop over points
+      // loop over points (once more for each further window of the coordinates with a wide range)
 
-      unsigned int array_count = 0;
+      bool done_x = !report_x;
+      bool done_y = !report_y;
+      bool done_z = !report_z;
+      I64 point_count;
+      U32 pass = 0;
 
-      while ((lasreader->read_point()) && (array_count < array_max))
+      while (true)
       {
-        if (report_x)
-        {
-          array_x[array_count] = lasreader->point.get_X();
-        }
+        point_count = 0;
 
-        if (report_y)
+        while ((point_count < point_max) && lasreader->read_point())
         {
-          array_y[array_count] = lasreader->point.get_Y();
+          if (pass == 0)
+          {
+            if (report_x) stream_x.add_first(lasreader->point.get_X());
+            if (report_y) stream_y.add_first(lasreader->point.get_Y());
+            if (report_z) stream_z.add_first(lasreader->point.get_Z());
+            if (gps && (array_gps.size() < array_max)) array_gps.push_back(lasreader->point.gps_time);
+            if (rgb)
+            {
+              stream_r.add_first(lasreader->point.rgb[0]);
+              stream_g.add_first(lasreader->point.rgb[1]);
+              stream_b.add_first(lasreader->point.rgb[2]);
+            }
+          }
+          else
+          {
+            if (!done_x) stream_x.add(lasreader->point.get_X());
+            if (!done_y) stream_y.add(lasreader->point.get_Y());
+            if (!done_z) stream_z.add(lasreader->point.get_Z());
+          }
+          point_count++;
         }
 
-        if (report_z)
+        if (!done_x) done_x = stream_x.next_window();
+        if (!done_y) done_y = stream_y.next_window();
+        if (!done_z) done_z = stream_z.next_window();
+        if (rgb && (pass == 0))
         {
-          array_z[array_count] = lasreader->point.get_Z();
+          stream_r.next_window();
+          stream_g.next_window();
+          stream_b.next_window();
         }
 
-        if (report_gps && lasreader->point.have_gps_time)
-        {
-          array_gps[array_count] = lasreader->point.gps_time;
-        }
+        if (done_x && done_y && done_z) break;
 
-        if (report_rgb && lasreader->point.have_rgb)
+        pass++;
+        LASMessage(LAS_VERBOSE, "pass %u over the points for the next window of raw integers", pass + 1);
+        if (!lasreader->seek(0))
         {
-          array_r[array_count] = lasreader->point.rgb[0];
-          array_g[array_count] = lasreader->point.rgb[1];
-          array_b[array_count] = lasreader->point.rgb[2];
+          LASMessage(LAS_WARNING, "cannot seek back to first point. differences of coordinates with a range wider than %d are incomplete", LAS_PRECISION_WINDOW);
+          break;
         }
-
-        array_count++;
       }
 
-      array_max = array_count;
+      // output histograms of the differences (and of the differences of differences)
 
-      // sort values
+      // first for X & Y & Z
 
       if (report_x)
       {
-        quicksort_for_ints(array_x, 0, array_max-1);
+        report_spacings("X", &stream_x, lasreader->header.x_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
       if (report_y)
       {
-        quicksort_for_ints(array_y, 0, array_max-1);
+        report_spacings("Y", &stream_y, lasreader->header.y_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
       if (report_z)
       {
-        quicksort_for_ints(array_z, 0, array_max-1);
+        report_spacings("Z", &stream_z, lasreader->header.z_scale_factor, report_lines, report_diff, report_diff_diff);
       }
 
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        quicksort_for_doubles(array_gps, 0, array_max-1);
-      }
+      // then for GPS
 
-      if (report_rgb && lasreader->point.have_rgb)
+      if (gps && array_gps.size())
       {
-        quicksort_for_shorts(array_r, 0, array_max-1);
-        quicksort_for_shorts(array_g, 0, array_max-1);
-        quicksort_for_shorts(array_b, 0, array_max-1);
-      }
+        unsigned int array_count, array_last, array_first;
+        unsigned int array_size = (unsigned int)array_gps.size();
 
-      // create differences
+        quicksort_for_doubles(array_gps.data(), 0, array_size-1);
 
-      if (report_x)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_x[array_count-1] = array_x[array_count] - array_x[array_count-1];
-        }
-      }
-
-      if (report_y)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_y[array_count-1] = array_y[array_count] - array_y[array_count-1];
-        }
-      }
-
-      if (report_z)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_z[array_count-1] = array_z[array_count] - array_z[array_count-1];
-        }
-      }
-
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
+        for (array_count = 1; array_count < array_size; array_count++)
         {
           array_gps[array_count-1] = array_gps[array_count] - array_gps[array_count-1];
         }
-      }
-
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        for (array_count = 1; array_count < array_max; array_count++)
-        {
-          array_r[array_count-1] = array_r[array_count] - array_r[array_count-1];
-          array_g[array_count-1] = array_g[array_count] - array_g[array_count-1];
-          array_b[array_count-1] = array_b[array_count] - array_b[array_count-1];
-        }
-      }
-
-      // sort differences
-
-      if (report_x)
-      {
-        quicksort_for_ints(array_x, 0, array_max-2);
-      }
-
-      if (report_y)
-      {
-        quicksort_for_ints(array_y, 0, array_max-2);
-      }
-
-      if (report_z)
-      {
-        quicksort_for_ints(array_z, 0, array_max-2);
-      }
-
-      if (report_gps && lasreader->point.have_gps_time)
-      {
-        quicksort_for_doubles(array_gps, 0, array_max-2);
-      }
-
-      if (report_rgb && lasreader->point.have_rgb)
-      {
-        quicksort_for_shorts(array_r, 0, array_max-2);
-        quicksort_for_shorts(array_g, 0, array_max-2);
-        quicksort_for_shorts(array_b, 0, array_max-2);
-      }
-
-      // compute difference of differences, sort them, output histogram
-
-      // first for X & Y & Z
-
-      unsigned int count_lines, array_last, array_first;
-
-      if (report_x)
-      {
-        if (report_diff) fprintf(stdout, "X differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_x[array_last] != array_x[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) {  count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_x[array_last], array_count - array_last, lasreader->header.x_scale_factor*array_x[array_last]); }
-            array_x[array_first] = array_x[array_count] - array_x[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "X differences of differences\n");
-          quicksort_for_ints(array_x, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_x[array_last] != array_x[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_x[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
-      }
-
-      if (report_y)
-      {
-        if (report_diff) fprintf(stdout, "Y differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_y[array_last] != array_y[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) { count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_y[array_last], array_count - array_last, lasreader->header.y_scale_factor*array_y[array_last]); }
-            array_y[array_first] = array_y[array_count] - array_y[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "Y differences of differences\n");
-          quicksort_for_ints(array_y, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_y[array_last] != array_y[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_y[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
-      }
-
-      if (report_z)
-      {
-        if (report_diff) fprintf(stdout, "Z differences \n");
-        for (count_lines = 0, array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_z[array_last] != array_z[array_count])
-          {
-            if (report_diff && (count_lines < report_lines)) { count_lines++; fprintf(stdout, " %10d : %10d   %g\n", array_z[array_last], array_count - array_last, lasreader->header.z_scale_factor*array_z[array_last]); }
-            array_z[array_first] = array_z[array_count] - array_z[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "Z differences of differences\n");
-          quicksort_for_ints(array_z, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_z[array_last] != array_z[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_z[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
-      }
+        array_size--;
 
-      // then for GPS
+        if (array_size > 1) quicksort_for_doubles(array_gps.data(), 0, array_size-1);
 
-      if (report_gps && lasreader->point.have_gps_time)
-      {
         if (report_diff) fprintf(stdout, "GPS time differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
+        for (array_first = 0, array_last = 0, array_count = 1; array_count <= array_size; array_count++)
         {
-          if (array_gps[array_last] != array_gps[array_count])
+          if ((array_count == array_size) || (array_gps[array_last] != array_gps[array_count]))
           {
             if (report_diff) fprintf(stdout, "  %.10g : %10d\n", array_gps[array_last], array_count - array_last);
-            array_gps[array_first] = array_gps[array_count] - array_gps[array_last];
+            if (array_count < array_size) array_gps[array_first++] = array_gps[array_count] - array_gps[array_last];
             array_last = array_count;
-            array_first++;
           }
         }
         if (report_diff_diff)
         {
           fprintf(stdout, "GPS time  differences of differences\n");
-          quicksort_for_doubles(array_gps, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
+          if (array_first > 1) quicksort_for_doubles(array_gps.data(), 0, array_first-1);
+          for (array_last = 0, array_count = 1; array_count <= array_first; array_count++)
           {
-            if (array_gps[array_last] != array_gps[array_count])
+            if ((array_count == array_first) || (array_gps[array_last] != array_gps[array_count]))
             {
               fprintf(stdout, "  %.10g : %10d\n", array_gps[array_last], array_count - array_last);
               array_last = array_count;
@@ -674,90 +677,39 @@ int main(int argc, char *argv[])
 
       // then for R & G & B
 
-      if (report_rgb && lasreader->point.have_rgb)
+      if (rgb)
       {
-        if (report_diff) fprintf(stdout, "R differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_r[array_last] != array_r[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_r[array_last], array_count - array_last);
-            array_r[array_first] = array_r[array_count] - array_r[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "R differences of differences\n");
-          quicksort_for_shorts(array_r, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_r[array_last] != array_r[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_r[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+        report_spacings("R", &stream_r, 0.0, report_lines, report_diff, report_diff_diff);
+        report_spacings("G", &stream_g, 0.0, report_lines, report_diff, report_diff_diff);
+        report_spacings("B", &stream_b, 0.0, report_lines, report_diff, report_diff_diff);
+      }
 
-        if (report_diff) fprintf(stdout, "G differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_g[array_last] != array_g[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_g[array_last], array_count - array_last);
-            array_g[array_first] = array_g[array_count] - array_g[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
-        {
-          fprintf(stdout, "G differences of differences\n");
-          quicksort_for_shorts(array_g, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
-          {
-            if (array_g[array_last] != array_g[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_g[array_last], array_count - array_last);
-              array_last = array_count;
-            }
-          }
-        }
+      // recommend the scale factors that match the precision in the data and offsets that keep it exact
 
-        if (report_diff) fprintf(stdout, "B differences \n");
-        for (array_first = 0, array_last = 0, array_count = 1; array_count < array_max; array_count++)
-        {
-          if (array_b[array_last] != array_b[array_count])
-          {
-            if (report_diff) fprintf(stdout, "  %10d : %10d\n", array_b[array_last], array_count - array_last);
-            array_b[array_first] = array_b[array_count] - array_b[array_last];
-            array_last = array_count;
-            array_first++;
-          }
-        }
-        if (report_diff_diff)
+      if (report_x || report_y || report_z)
+      {
+        F64 scale_factor[3] = { lasreader->header.x_scale_factor, lasreader->header.y_scale_factor, lasreader->header.z_scale_factor };
+        F64 offset[3] = { lasreader->header.x_offset, lasreader->header.y_offset, lasreader->header.z_offset };
+        const LASprecisionStream* streams[3] = { (report_x ? &stream_x : 0), (report_y ? &stream_y : 0), (report_z ? &stream_z : 0) };
+        U32 divisor[3] = { 1, 1, 1 };
+        for (i = 0; i < 3; i++)
         {
-          fprintf(stdout, "B differences of differences\n");
-          quicksort_for_shorts(array_b, 0, array_first-1);
-          for (array_last = 0, array_count = 1; array_count < array_first; array_count++)
+          if (streams[i] && (streams[i]->divisor > 1))
           {
-            if (array_b[array_last] != array_b[array_count])
-            {
-              fprintf(stdout, "  %10d : %10d\n", array_b[array_last], array_count - array_last);
-              array_last = array_count;
-            }
+            divisor[i] = streams[i]->divisor;
+            I64 remainder = ((I64)streams[i]->first % divisor[i] + divisor[i]) % divisor[i];
+            offset[i] += remainder * scale_factor[i];
+            scale_factor[i] *= divisor[i];
           }
         }
+        fprintf(stdout, "precision in data: %u %u %u raw integer units\n", divisor[0], divisor[1], divisor[2]);
+        // all digits so that the numbers shown are exactly those computed (like lasinfo reports them)
+        char printstring[3][512];
+        for (i = 0; i < 3; i++) lidardouble2string(printstring[i], scale_factor[i]);
+        fprintf(stdout, "recommended scale factors: %s %s %s\n", printstring[0], printstring[1], printstring[2]);
+        for (i = 0; i < 3; i++) lidardouble2string(printstring[i], offset[i]);
+        fprintf(stdout, "recommended offsets: %s %s %s\n", printstring[0], printstring[1], printstring[2]);
       }
-      if (array_x) delete [] array_x;
-      if (array_y) delete [] array_y;
-      if (array_z) delete [] array_z;
-      if (array_gps) delete [] array_gps;
-      if (array_r) delete [] array_r;
-      if (array_g) delete [] array_g;
-      if (array_b) delete [] array_b;
     }
     else
     {
@@ -20,6 +20,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 - '-pipeline' reads, processes and writes the points on separate threads
+    16 October 2026 - '-cores' runs the tool once per input file on several cores
     01 Mai 2024 - initial
 
 ===============================================================================
@@ -29,16 +31,43 @@
 
 #include "lasdefinitions.hpp"
 #include "lasmessage.hpp"
+#include "lasreader.hpp"
+#include "lasthreadpool.hpp"
+#include "laswriter.hpp"
 #include "mydefs.hpp"
 
+#include <atomic>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 class LasTool
 {
    private:
     bool header_printed_once = false;
+    std::vector<std::string> argv_original;  // command line before parsing blanks it
+    std::vector<int> input_positions;        // arguments taken as input files without '-i'
+
+    static std::string quote_arg(const std::string& arg)
+    {
+#ifdef _WIN32
+        return "\"" + arg + "\"";
+#else
+        std::string quoted = "'";
+        for (size_t i = 0; i < arg.size(); i++)
+        {
+            if (arg[i] == '\'')
+                quoted += "'\\''";
+            else
+                quoted += arg[i];
+        }
+        return quoted + "'";
+#endif
+    }
 
    public:
     virtual ~LasTool() = default;
@@ -49,8 +78,10 @@ class LasTool
 #ifdef COMPILE_WITH_GUI
     bool gui = false;
 #endif
-#ifdef COMPILE_WITH_MULTI_CORE
     I32 cores = 1;
+    bool multi_core = false;  // the tool processes '-cores' with run_multi_core()
+    bool pipeline = false;  // read, filter/transform and write on separate threads
+#ifdef COMPILE_WITH_MULTI_CORE
     BOOL cpu64 = FALSE;
 #endif
     std::string name;
@@ -59,6 +90,7 @@ class LasTool
         this->argc = argc;
         this->argv = argv;
         this->name = name;
+        argv_original.assign(argv, argv + argc);
     }
 
     virtual std::string sBlast()
@@ -187,7 +219,6 @@ class LasTool
         }
         else if (strcmp(argv[i], "-cores") == 0)
         {
-#ifdef COMPILE_WITH_MULTI_CORE
             if ((i + 1) >= argc)
             {
                 laserrorusage("'%s' needs 1 argument: number", argv[i]);
@@ -198,13 +229,19 @@ class LasTool
                 usage();
                 byebye();
             }
+            if (!multi_core)
+            {
+                LASMessage(LAS_WARNING, "%s has no multi-core batching. ignoring '-cores' ...", name.c_str());
+                cores = 1;
+            }
             argv[i][0] = '\0';
             i++;
             argv[i][0] = '\0';
-#else
-            LASMessage(LAS_WARNING, "not compiled with multi-core batching. ignoring '-cores' ...");
-            i++;
-#endif
+        }
+        else if (strcmp(argv[i], "-pipeline") == 0)
+        {
+            pipeline = true;
+            argv[i][0] = '\0';
         }
         else if (strcmp(argv[i], "-cpu64") == 0)
         {
@@ -280,6 +317,169 @@ class LasTool
             laserror("'%s' needs [%d] argument%s%s%s", argv[i], cnt, (cnt > 1 ? "s" : ""), (std::strcmp(desc, "") == 0 ? "" : ": "), desc);
         }
     }
+    /// <summary>
+    /// parses the number of a '-threads' option. 0 means one thread per hardware thread, negative numbers are rejected
+    /// </summary>
+    /// <param name="i">argument index of the option</param>
+    /// <returns>number of threads</returns>
+    U32 parse_arg_threads(int i) const
+    {
+        parse_arg_cnt_check(i, 1, "number");
+        I32 number;
+        if (sscanf_las(argv[i + 1], "%d", &number) != 1)
+        {
+            laserror("'%s' needs 1 argument: number but '%s' is not a valid number.", argv[i], argv[i + 1]);
+        }
+        if (number < 0)
+        {
+            laserror("'%s' needs 1 argument: number but %d is not valid.", argv[i], number);
+        }
+        return (number == 0 ? LASthreadPool::get_hardware_threads() : (U32)number);
+    }
+    /// <summary>
+    /// runs the tool once for each input file with up to 'cores' runs at the same time.
+    /// each run gets the original command line with the input replaced by one file, so
+    /// the output of every file is named exactly as without '-cores'
+    /// </summary>
+    /// <param name="lasreadopener">the parsed input of the tool</param>
+    /// <param name="laswriteopener">the parsed output of the tool (if it has one)</param>
+    /// <returns>true: all files were processed by separate runs; false: '-cores' is ignored</returns>
+    bool run_multi_core(LASreadOpener* lasreadopener, LASwriteOpener* laswriteopener = 0)
+    {
+        if (lasreadopener->get_use_stdin())
+        {
+            LASMessage(LAS_WARNING, "using stdin. ignoring '-cores %d' ...", cores);
+            return false;
+        }
+        if (lasreadopener->get_file_name_number() < 2)
+        {
+            LASMessage(LAS_WARNING, "only %u input files. ignoring '-cores %d' ...", lasreadopener->get_file_name_number(), cores);
+            return false;
+        }
+        if (lasreadopener->is_merged())
+        {
+            LASMessage(LAS_WARNING, "input files merged on-the-fly. ignoring '-cores %d' ...", cores);
+            return false;
+        }
+        if (lasreadopener->are_files_flightlines())
+        {
+            LASMessage(LAS_WARNING, "files are numbered as flightlines. ignoring '-cores %d' ...", cores);
+            return false;
+        }
+        // the runs would write to the same output at the same time
+        if (laswriteopener && laswriteopener->is_piped())
+        {
+            LASMessage(LAS_WARNING, "writing to stdout. ignoring '-cores %d' ...", cores);
+            return false;
+        }
+        if (laswriteopener && laswriteopener->get_file_name())
+        {
+            LASMessage(LAS_WARNING, "all files are written to '%s'. ignoring '-cores %d' ...", laswriteopener->get_file_name(), cores);
+            return false;
+        }
+        // the command line without the input files and without '-cores'. '-wait' and '-gui' are dropped
+        // as well so that the runs neither wait for a key press nor open a GUI each
+        std::string command = quote_arg(argv_original[0]);
+        size_t i = 1;
+        while (i < argv_original.size())
+        {
+            const std::string& arg = argv_original[i];
+            if (arg == "-i")
+            {
+                i++;
+                while ((i < argv_original.size()) && !argv_original[i].empty() && (argv_original[i][0] != '-')) i++;
+                continue;
+            }
+            else if ((arg == "-lof") || (arg == "-cores"))
+            {
+                i += 2;
+                continue;
+            }
+            else if ((arg == "-cpu64") || (arg == "-wait") || (arg == "-gui") || is_input_position((int)i))
+            {
+                i++;
+                continue;
+            }
+            command += " " + quote_arg(arg);
+            i++;
+        }
+        U32 file_number = lasreadopener->get_file_name_number();
+        // with '-odir' or '-odix' and a known format each run must create the file named after its input
+        std::vector<std::string> output_names;
+        if (laswriteopener && (laswriteopener->get_directory() || laswriteopener->get_appendix()) && laswriteopener->format_was_specified())
+        {
+            for (U32 f = 0; f < file_number; f++)
+            {
+                laswriteopener->make_file_name(lasreadopener->get_file_name(f), -2);
+                output_names.push_back(laswriteopener->get_file_name());
+            }
+            laswriteopener->set_file_name(0);
+        }
+        U32 num_workers = ((U32)cores < file_number ? (U32)cores : file_number);
+        LASMessage(LAS_VERBOSE, "processing %u files with %u cores", file_number, num_workers);
+        // each worker starts one run after the other for the next unprocessed file
+        std::atomic<U32> next_file(0);
+        std::mutex mutex;
+        U32 failed = 0;
+        std::vector<std::thread> workers;
+        for (U32 w = 0; w < num_workers; w++)
+        {
+            workers.push_back(std::thread([&]() {
+                U32 f;
+                while ((f = next_file++) < file_number)
+                {
+                    std::string run = command + " -i " + quote_arg(lasreadopener->get_file_name(f));
+                    int result = std::system(run.c_str());
+                    if (result != 0)
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        LASMessage(LAS_WARNING, "processing '%s' failed", lasreadopener->get_file_name(f));
+                        failed++;
+                    }
+                    else if (output_names.size())
+                    {
+                        FILE* file = LASfopen(output_names[f].c_str(), "rb");
+                        if (file)
+                        {
+                            fclose(file);
+                        }
+                        else
+                        {
+                            std::lock_guard<std::mutex> lock(mutex);
+                            LASMessage(LAS_WARNING, "processing '%s' did not produce '%s'", lasreadopener->get_file_name(f), output_names[f].c_str());
+                            failed++;
+                        }
+                    }
+                }
+            }));
+        }
+        for (U32 w = 0; w < num_workers; w++)
+        {
+            workers[w].join();
+        }
+        if (failed)
+        {
+            LASMessage(LAS_ERROR, "%u of %u files failed with '-cores %d'", failed, file_number, cores);
+        }
+        return true;
+    }
+    /// <summary>
+    /// adds argument[i] as an input file given without '-i' (as lasinfo allows it)
+    /// </summary>
+    void add_input_name(LASreadOpener* lasreadopener, int i)
+    {
+        lasreadopener->add_file_name(argv[i]);
+        input_positions.push_back(i);
+        argv[i][0] = '\0';
+    }
+    bool is_input_position(int i) const
+    {
+        for (size_t p = 0; p < input_positions.size(); p++)
+        {
+            if (input_positions[p] == i) return true;
+        }
+        return false;
+    }
     void force_check() const
     {
         if (force)
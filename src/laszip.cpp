@@ -25,6 +25,7 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- new option '-lax_align_chunks' writes points cell by cell with one chunk per cell
     21 Juni 2019 -- allows compressing Trimble waveforms where first WDP offset is 0
     7 September 2018 -- replaced calls to _strdup with calls to the LASCopyString macro
     29 March 2015 -- using LASwriterCompatible for LAS 1.4 compatibility mode
@@ -45,11 +46,16 @@
 #include <time.h>
 #include <stdlib.h>
 
+#include <algorithm>
 #include <map>
+#include <unordered_map>
+#include <vector>
 
 #include "lasreader.hpp"
 #include "laswriter.hpp"
 #include "laswritercompatible.hpp"
+#include "laspipeline.hpp"
+#include "laspointbatch.hpp"
 #include "laswaveform13reader.hpp"
 #include "laswaveform13writer.hpp"
 #include "bytestreamin.hpp"
@@ -57,6 +63,7 @@
 #include "bytestreamin_array.hpp"
 #include "geoprojectionconverter.hpp"
 #include "lasindex.hpp"
+#include "lasinterval.hpp"
 #include "lasquadtree.hpp"
 #include "lastool.hpp"
 
@@ -91,6 +98,7 @@ public:
     fprintf(stderr, "laszip -i *.laz -odir uncompressed -cores 4\n");
 #endif
     fprintf(stderr, "laszip -i lidar.las -o lidar_zipped.laz\n");
+    fprintf(stderr, "laszip -i lidar.las -lax_align_chunks -o lidar_indexed.laz\n");
     fprintf(stderr, "laszip -i lidar.laz -o lidar_unzipped.las\n");
     fprintf(stderr, "laszip -i lidar.las -stdout -olaz > lidar.laz\n");
     fprintf(stderr, "laszip -stdin -o lidar.laz < lidar.las\n");
@@ -107,6 +115,161 @@ static double taketime()
   return (double)(clock())/CLOCKS_PER_SEC;
 }
 
+// rewrites the points cell by cell in the order of the cells of the completed spatial index of the
+// input and adds them to the spatial index of the output in which each cell becomes one interval.
+// with 'align_chunks' every cell starts a new chunk (and cells with more than 'chunk_size' points
+// are split into several chunks) so that queries only decompress chunks of the cells they touch.
+// consecutive cells with up to LASZIP_CELL_BATCH_POINTS points are gathered in memory during one
+// forward pass over their intervals
+
+#define LASZIP_CELL_BATCH_POINTS 4000000
+
+static BOOL write_cell_by_cell(LASreader* lasreader, LASwriter* laswriter, LASindex* input_index, LASindex* output_index, const BOOL align_chunks, const U32 chunk_size, const BOOL update_inventory)
+{
+  LASquadtree* spatial = input_index->get_spatial();
+  LASinterval* interval = input_index->get_interval();
+
+  // order the cells along the finest level of the quadtree so that neighbouring cells stay close
+
+  std::vector<std::pair<U64, I32>> cells;
+  std::unordered_map<I32, U32> points_in_cell;
+  U64 indexed = 0;
+  interval->get_cells();
+  while (interval->has_cells())
+  {
+    U32 level = spatial->get_level((U32)interval->index);
+    U64 key = ((U64)spatial->get_level_index((U32)interval->index, level)) << (2 * (spatial->levels - level));
+    cells.push_back(std::make_pair(key, interval->index));
+    points_in_cell[interval->index] = interval->full;
+    indexed += interval->full;
+  }
+  std::sort(cells.begin(), cells.end());
+
+  std::unordered_map<I32, U32> rank_of_cell;
+  U32 rank;
+  for (rank = 0; rank < (U32)cells.size(); rank++)
+  {
+    rank_of_cell[cells[rank].second] = rank;
+  }
+
+  // the points are mapped from their cell on the finest level to the rank of the cell they are in
+
+  std::unordered_map<I32, U32> rank_of_finest;
+  LASpointBatch batch;
+  std::vector<U32> ranks;
+  std::vector<U32> order;
+  std::vector<U32> offsets;
+  std::vector<std::pair<U32, U32>> ranges;
+  U32 chunk_count = 0;
+  U32 first = 0;
+  while (first < (U32)cells.size())
+  {
+    // the next group of cells and the union of their intervals
+
+    U32 last = first;
+    U32 count = 0;
+    ranges.clear();
+    while ((last < (U32)cells.size()) && ((last == first) || (count + points_in_cell[cells[last].second] <= LASZIP_CELL_BATCH_POINTS)))
+    {
+      count += points_in_cell[cells[last].second];
+      interval->get_cell(cells[last].second);
+      while (interval->has_intervals())
+      {
+        ranges.push_back(std::make_pair(interval->start, interval->end));
+      }
+      last++;
+    }
+    std::sort(ranges.begin(), ranges.end());
+
+    if (batch.get_capacity() == 0)
+    {
+      if (!batch.init(&lasreader->point, count, TRUE)) return FALSE;
+    }
+    else if (!batch.reserve(count))
+    {
+      return FALSE;
+    }
+    batch.clear();
+    ranks.clear();
+
+    // read the points of the group in file order
+
+    I64 next = 0;
+    size_t r;
+    for (r = 0; r < ranges.size(); r++)
+    {
+      I64 start = (ranges[r].first > next ? ranges[r].first : next);
+      I64 end = ranges[r].second;
+      if (start > end) continue;
+      if ((lasreader->p_count != start) && !lasreader->seek(start))
+      {
+        laserror("cannot seek to point %lld of input", start);
+        return FALSE;
+      }
+      while ((lasreader->p_count <= end) && lasreader->read_point())
+      {
+        if ((lasreader->p_count - 1) > end) break;
+        const I32 finest = (I32)spatial->get_cell_index(lasreader->point.get_x(), lasreader->point.get_y());
+        std::unordered_map<I32, U32>::iterator owner = rank_of_finest.find(finest);
+        if (owner == rank_of_finest.end())
+        {
+          I32 coarser = finest;
+          while ((rank_of_cell.count(coarser) == 0) && spatial->coarsen(coarser, &coarser, 0, 0));
+          owner = rank_of_finest.insert(std::make_pair(finest, (rank_of_cell.count(coarser) ? rank_of_cell[coarser] : U32_MAX))).first;
+        }
+        if ((owner->second < first) || (owner->second >= last) || batch.is_full()) continue;
+        batch.add(&lasreader->point);
+        ranks.push_back(owner->second);
+      }
+      next = end + 1;
+    }
+
+    // sort them by the rank of their cells
+
+    offsets.assign(last - first + 1, 0);
+    for (U32 i = 0; i < batch.count; i++) offsets[ranks[i] - first + 1]++;
+    for (rank = first; rank < last; rank++) offsets[rank - first + 1] += offsets[rank - first];
+    order.resize(batch.count);
+    for (U32 i = 0; i < batch.count; i++) order[offsets[ranks[i] - first]++] = i;
+
+    // and write them cell by cell
+
+    U32 p = 0;
+    for (rank = first; rank < last; rank++)
+    {
+      BOOL new_cell = TRUE;
+      while ((p < batch.count) && (ranks[order[p]] == rank))
+      {
+        batch.get_point(order[p], &lasreader->point);
+        if (align_chunks && chunk_count && (new_cell || (chunk_count == chunk_size)))
+        {
+          if (!laswriter->chunk())
+          {
+            laserror("cannot end chunk after %lld points", laswriter->p_count);
+            return FALSE;
+          }
+          chunk_count = 0;
+        }
+        new_cell = FALSE;
+        output_index->add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(laswriter->p_count));
+        laswriter->write_point(&lasreader->point);
+        if (update_inventory) laswriter->update_inventory(&lasreader->point);
+        chunk_count++;
+        p++;
+      }
+    }
+    first = last;
+  }
+
+  if ((U64)laswriter->p_count != indexed)
+  {
+    laserror("wrote %lld points cell by cell but %llu points were indexed", laswriter->p_count, indexed);
+    return FALSE;
+  }
+  LASMessage(LAS_VERBOSE, "wrote %lld points in %u cells", laswriter->p_count, (U32)cells.size());
+  return TRUE;
+}
+
 #ifdef COMPILE_WITH_GUI
 extern int laszip_gui(int argc, char *argv[], LASreadOpener* lasreadopener);
 #endif
@@ -119,6 +282,7 @@ int main(int argc, char *argv[])
 {
   LasTool_laszip lastool;
   lastool.init(argc, argv, "laszip");
+  lastool.multi_core = true;
   int i;
   BOOL dry = FALSE;
   bool waveform = false;
@@ -130,6 +294,7 @@ int main(int argc, char *argv[])
   bool format_not_specified = false;
   BOOL lax = FALSE;
   BOOL append = FALSE;
+  BOOL lax_align_chunks = FALSE;
   BOOL remain_compatible = FALSE;
   BOOL move_CRS = FALSE;
   BOOL move_all = FALSE;
@@ -184,6 +349,12 @@ int main(int argc, char *argv[])
     {
       append = TRUE;
     }
+    else if (strcmp(argv[i],"-lax_align_chunks") == 0)
+    {
+      lax = TRUE;
+      append = TRUE;
+      lax_align_chunks = TRUE;
+    }
     else if (strcmp(argv[i],"-remain_compatible") == 0)
     {
       remain_compatible = TRUE;
@@ -264,8 +435,7 @@ int main(int argc, char *argv[])
     }
     else if ((argv[i][0] != '-') && (lasreadopener.get_file_name_number() == 0))
     {
-      lasreadopener.add_file_name(argv[i]);
-      argv[i][0] = '\0';
+      lastool.add_input_name(&lasreadopener, i);
     }
     else
     {
@@ -307,6 +477,11 @@ int main(int argc, char *argv[])
   {
     laszip_multi_core(argc, argv, &geoprojectionconverter, &lasreadopener, &laswriteopener, 1, TRUE);
   }
+#else
+  if (lastool.cores > 1)
+  {
+    if (lastool.run_multi_core(&lasreadopener, &laswriteopener)) byebye();
+  }
 #endif
 
   // check input
@@ -325,9 +500,16 @@ int main(int argc, char *argv[])
       LASMessage(LAS_WARNING, "disabling LAX generation for piped output");
       lax = FALSE;
       append = FALSE;
+      lax_align_chunks = FALSE;
     }
   }
 
+  if (lax_align_chunks && waveform)
+  {
+    LASMessage(LAS_WARNING, "cannot reorder points with waveforms. ignoring '-lax_align_chunks' ...");
+    lax_align_chunks = FALSE;
+  }
+
   // make sure we do not corrupt the input file
 
   if (lasreadopener.get_file_name() && laswriteopener.get_file_name() && (strcmp(lasreadopener.get_file_name(), laswriteopener.get_file_name()) == 0))
@@ -522,6 +704,30 @@ int main(int argc, char *argv[])
 
       I64 bytes_written = 0;
 
+      // maybe rewrite the points cell by cell (with variable chunks for the new LAS 1.4 point types)
+
+      // the second pass seeks back in the input, which piped and merged input cannot do
+
+      BOOL seekable = !lasreadopener.is_piped() && !lasreadopener.is_merged() && lasreader->seek(0);
+      BOOL write_cells = lax_align_chunks && seekable && !lasreader->get_inside() && (lasreader->header.min_x < lasreader->header.max_x) && (lasreader->header.min_y < lasreader->header.max_y);
+      BOOL align_chunks = write_cells && (lasreader->header.point_data_format > 5) && laswriteopener.get_native() && (laswriteopener.get_format() == LAS_TOOLS_FORMAT_LAZ);
+      U32 chunk_size = laswriteopener.get_chunk_size();
+
+      if (lax_align_chunks && !seekable)
+      {
+        LASMessage(LAS_WARNING, "cannot seek in piped or merged input. compressing without reordering and only creating LAX ...");
+      }
+      else if (lax_align_chunks && !write_cells)
+      {
+        LASMessage(LAS_WARNING, "cannot reorder points of '%s'. only creating LAX ...", lasreadopener.get_file_name());
+      }
+      else if (write_cells && !align_chunks)
+      {
+        LASMessage(LAS_WARNING, "variable chunks need LAZ output with point type 6 or higher. writing cells without aligning chunks ...");
+      }
+
+      if (align_chunks) laswriteopener.set_chunk_size(0);
+
       // open laswriter
 
       LASwriter* laswriter = 0;
@@ -562,6 +768,8 @@ int main(int argc, char *argv[])
         laserror("could not open laswriter");
       }
 
+      if (align_chunks) laswriteopener.set_chunk_size(chunk_size);
+
       // should we also deal with waveform data
 
       if (waveform)
@@ -693,6 +901,53 @@ int main(int argc, char *argv[])
           }
         }
       }
+      else if (write_cells)
+      {
+        // first index the input to find the cells of the quadtree
+
+        LASquadtree* lasquadtree = new LASquadtree;
+        lasquadtree->setup(lasreader->header.min_x, lasreader->header.max_x, lasreader->header.min_y, lasreader->header.max_y, tile_size);
+        LASindex input_index;
+        input_index.prepare(lasquadtree, threshold);
+        while (lasreader->read_point())
+        {
+          input_index.add(lasreader->point.get_x(), lasreader->point.get_y(), (U32)(lasreader->p_count - 1));
+        }
+        input_index.complete(minimum_points, 0);
+
+        // then write the points cell by cell and index them again
+
+        lasquadtree = new LASquadtree;
+        lasquadtree->setup(lasreader->header.min_x, lasreader->header.max_x, lasreader->header.min_y, lasreader->header.max_y, tile_size);
+        LASindex lasindex;
+        lasindex.prepare(lasquadtree, threshold);
+        if (!write_cell_by_cell(lasreader, laswriter, &input_index, &lasindex, align_chunks, chunk_size, !lasreadopener.is_header_populated()))
+        {
+          laserror("could not write points of '%s' cell by cell", lasreadopener.get_file_name());
+        }
+
+        if (!lasreadopener.is_header_populated())
+        {
+          laswriter->update_header(&lasreader->header, TRUE);
+        }
+
+        // flush the writer
+        bytes_written = laswriter->close();
+
+        // adaptive coarsening results in the same cells with one interval each
+        lasindex.complete(minimum_points, maximum_intervals);
+
+        if (append)
+        {
+          // append lax to file
+          lasindex.append(laswriteopener.get_file_name());
+        }
+        else
+        {
+          // write lax to file
+          lasindex.write(laswriteopener.get_file_name());
+        }
+      }
       else
       {
         // loop over points
@@ -753,6 +1008,11 @@ int main(int argc, char *argv[])
               }
               laswriter->update_header(&lasreader->header, TRUE);
             }
+            else if (lastool.pipeline)
+            {
+              LASpipeline laspipeline;
+              laspipeline.run(lasreader, laswriter, FALSE);
+            }
             else
             {
               while (lasreader->read_point())
@@ -820,6 +1080,11 @@ int main(int argc, char *argv[])
                 laswriter->update_inventory(&lasreader->point);
               }
             }
+            else if (lastool.pipeline)
+            {
+              LASpipeline laspipeline;
+              laspipeline.run(lasreader, laswriter);
+            }
             else
             {
               while (lasreader->read_point())
@@ -838,8 +1103,9 @@ int main(int argc, char *argv[])
         }
       }
 
+      I64 points_written = laswriter->p_count;
       delete laswriter;
-      LASMessage(LAS_VERBOSE, "%g secs to write %lld bytes for '%s' with %lld points of type %d", taketime()-start_time, bytes_written, laswriteopener.get_file_name(), lasreader->p_count, lasreader->header.point_data_format);
+      LASMessage(LAS_VERBOSE, "%g secs to write %lld bytes for '%s' with %lld points of type %d", taketime()-start_time, bytes_written, laswriteopener.get_file_name(), points_written, lasreader->header.point_data_format);
       if (start_of_waveform_data_packet_record && !waveform)
       {
         lasreader->close(FALSE);
@@ -78,6 +78,8 @@ proj_coord_t proj_coord_ptr = nullptr;
 proj_trans_t proj_trans_ptr = nullptr;
 proj_get_type_t proj_get_type_ptr = nullptr;
 proj_is_crs_t proj_is_crs_ptr = nullptr;
+proj_trans_generic_t proj_trans_generic_ptr = nullptr;
+proj_clone_t proj_clone_ptr = nullptr;
 
 /// Function to get the home directory of the current user
 const char* getHomeDirectory() {
@@ -453,6 +455,8 @@ bool load_proj_library(const char* path, bool isNecessary/*=true*/) {
   proj_trans_ptr = (proj_trans_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_trans");
   proj_get_type_ptr = (proj_get_type_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_get_type");
   proj_is_crs_ptr = (proj_is_crs_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_is_crs");
+  proj_trans_generic_ptr = (proj_trans_generic_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_trans_generic");
+  proj_clone_ptr = (proj_clone_t)GET_PROC_ADDRESS(proj_lib_handle, "proj_clone");
 
   if (!proj_as_wkt_ptr || !proj_as_proj_string_ptr || !proj_as_projjson_ptr || !proj_get_source_crs_ptr || !proj_get_target_crs_ptr ||
       !proj_destroy_ptr || !proj_context_create_ptr || !proj_context_destroy_ptr || !proj_get_id_code_ptr || !proj_get_ellipsoid_ptr ||
@@ -509,4 +513,6 @@ void unload_proj_library() {
   proj_trans_ptr = nullptr;
   proj_get_type_ptr = nullptr;
   proj_is_crs_ptr = nullptr;
+  proj_trans_generic_ptr = nullptr;
+  proj_clone_ptr = nullptr;
 }
\ No newline at end of file
@@ -28,6 +28,8 @@
 
   CHANGE HISTORY:
 
+    16 October 2026 -- optional proj_trans_generic() and proj_clone() for batched and threaded transformations
+
 ===============================================================================
 */
 #ifndef PROJ_LOADER_H
@@ -47,6 +49,8 @@
 #define PROJ_LIB_HANDLE void*
 #endif
 
+#include <stddef.h>
+
 // Placeholder for compiling without proj.h
 typedef void* PJ;
 typedef void* PJ_CONTEXT;
@@ -138,6 +142,8 @@ typedef PJ_COORD (*proj_coord_t)(double, double, double, double);
 typedef PJ_COORD (*proj_trans_t)(PJ*, PJ_DIRECTION, PJ_COORD);
 typedef PJ_TYPE (*proj_get_type_t)(const PJ*);
 typedef int (*proj_is_crs_t)(const PJ*);
+typedef size_t (*proj_trans_generic_t)(PJ*, PJ_DIRECTION, double*, size_t, size_t, double*, size_t, size_t, double*, size_t, size_t, double*, size_t, size_t);
+typedef PJ* (*proj_clone_t)(PJ_CONTEXT*, const PJ*);
 
 // External variables for function pointers
 extern proj_as_wkt_t proj_as_wkt_ptr;
@@ -172,6 +178,9 @@ extern proj_coord_t proj_coord_ptr;
 extern proj_trans_t proj_trans_ptr;
 extern proj_get_type_t proj_get_type_ptr;
 extern proj_is_crs_t proj_is_crs_ptr;
+// optional functions that older PROJ versions may not export
+extern proj_trans_generic_t proj_trans_generic_ptr;
+extern proj_clone_t proj_clone_ptr;
 
 // Function for dynamic loading of the PROJ library
 bool load_proj_library(const char* path, bool isNecessary = true);
@@ -260,4 +269,9 @@ void unload_proj_library();
 
 #define proj_is_crs(P) (proj_is_crs_ptr ? proj_is_crs_ptr(P) : 0)
 
+#define proj_trans_generic(P, direction, x, sx, nx, y, sy, ny, z, sz, nz, t, st, nt)                                                                 \
+  (proj_trans_generic_ptr ? proj_trans_generic_ptr(P, direction, x, sx, nx, y, sy, ny, z, sz, nz, t, st, nt) : 0)
+
+#define proj_clone(ctx, obj) (proj_clone_ptr ? proj_clone_ptr(ctx, obj) : nullptr)
+
 #endif  // PROJ_LOADER_H